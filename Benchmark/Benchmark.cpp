@@ -0,0 +1,129 @@
+#include "Benchmark.h"
+#include "base/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+namespace Benchmark {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// body を iterations 回呼んだ時間 [秒]
+double Measure(const std::function<void()>& body, size_t iterations) {
+	const Clock::time_point start = Clock::now();
+	for (size_t i = 0; i < iterations; ++i) {
+		body();
+	}
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// JSON 文字列用のエスケープ
+std::string EscapeJson(const std::string& s) {
+	std::string escaped;
+	for (char c : s) {
+		if (c == '"' || c == '\\') {
+			escaped += '\\';
+		}
+		escaped += c;
+	}
+	return escaped;
+}
+
+} // namespace
+
+void Registry::Add(std::string name, size_t batchSize, std::function<void()> body, size_t maxSamples) {
+	entries_.push_back({std::move(name), batchSize, std::move(body), maxSamples});
+}
+
+std::vector<Result> Registry::Run(const Options& options) const {
+	std::vector<Result> results;
+	for (const Entry& entry : entries_) {
+		if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) {
+			continue;
+		}
+
+		// 1標本が minSampleSeconds 以上になるまで呼び出し回数を倍にする
+		size_t iterations = 1;
+		while (Measure(entry.body, iterations) < options.minSampleSeconds) {
+			iterations *= 2;
+		}
+		const size_t samples = entry.maxSamples ? std::min(options.samples, entry.maxSamples) : options.samples;
+		// 標本数を抑える重い計測は、呼び出し回数を決めたときの実行を空回しとみなす
+		const size_t warmupSamples = entry.maxSamples ? 0 : options.warmupSamples;
+		for (size_t i = 0; i < warmupSamples; ++i) {
+			Measure(entry.body, iterations);
+		}
+
+		std::vector<double> nsPerItem(samples);
+		const double items = static_cast<double>(iterations) * static_cast<double>(entry.batchSize);
+		for (double& ns : nsPerItem) {
+			ns = Measure(entry.body, iterations) * 1e9 / items;
+		}
+
+		Result result;
+		result.name = entry.name;
+		result.batchSize = entry.batchSize;
+		result.iterations = iterations;
+		result.samples = samples;
+		result.meanNs = std::accumulate(nsPerItem.begin(), nsPerItem.end(), 0.0) / static_cast<double>(nsPerItem.size());
+		double variance = 0.0;
+		for (double ns : nsPerItem) {
+			variance += (ns - result.meanNs) * (ns - result.meanNs);
+		}
+		result.stddevNs = nsPerItem.size() > 1 ? std::sqrt(variance / static_cast<double>(nsPerItem.size() - 1)) : 0.0;
+		std::sort(nsPerItem.begin(), nsPerItem.end());
+		result.minNs = nsPerItem.front();
+		const size_t middle = nsPerItem.size() / 2;
+		result.medianNs = nsPerItem.size() % 2 ? nsPerItem[middle] : (nsPerItem[middle - 1] + nsPerItem[middle]) * 0.5;
+		result.itemsPerSecond = 1e9 / result.medianNs;
+		results.push_back(result);
+	}
+	return results;
+}
+
+std::vector<size_t> GetThreadCounts() {
+	const size_t maxThreads = KamataEngine::ThreadPool::GetDefaultWorkerCount() + 1;
+	std::vector<size_t> counts;
+	for (size_t n = 1; n < maxThreads; n *= 2) {
+		counts.push_back(n);
+	}
+	counts.push_back(maxThreads);
+	return counts;
+}
+
+void WriteTable(std::ostream& os, const std::vector<Result>& results) {
+	char line[256];
+	std::snprintf(line, sizeof(line), "%-48s %8s %10s %10s %10s %8s %14s\n", "name", "batch", "mean ns", "median ns", "min ns", "cv %", "items/s");
+	os << line;
+	for (const Result& r : results) {
+		const double cv = r.meanNs > 0.0 ? r.stddevNs / r.meanNs * 100.0 : 0.0;
+		std::snprintf(line, sizeof(line), "%-48s %8zu %10.3f %10.3f %10.3f %8.2f %14.4g\n", r.name.c_str(), r.batchSize, r.meanNs, r.medianNs, r.minNs, cv, r.itemsPerSecond);
+		os << line;
+	}
+}
+
+void WriteJson(std::ostream& os, const std::vector<Result>& results) {
+	char number[64];
+	auto value = [&number](double v) {
+		std::snprintf(number, sizeof(number), "%.6g", v);
+		return number;
+	};
+	os << "{\n  \"unit\": \"ns/item\",\n  \"benchmarks\": [";
+	for (size_t i = 0; i < results.size(); ++i) {
+		const Result& r = results[i];
+		os << (i ? ",\n" : "\n") << "    {\"name\": \"" << EscapeJson(r.name) << "\", \"batch_size\": " << r.batchSize << ", \"iterations\": " << r.iterations
+		   << ", \"samples\": " << r.samples;
+		os << ", \"mean\": " << value(r.meanNs);
+		os << ", \"median\": " << value(r.medianNs);
+		os << ", \"min\": " << value(r.minNs);
+		os << ", \"stddev\": " << value(r.stddevNs);
+		os << ", \"items_per_second\": " << value(r.itemsPerSecond) << "}";
+	}
+	os << "\n  ]\n}\n";
+}
+
+} // namespace Benchmark
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "math/SimdSupport.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Benchmark {
+
+/// <summary>
+/// 計測対象の処理が最適化で消されないようにする
+/// </summary>
+template<typename T> inline void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+	(void)*sink;
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/// <summary>
+/// 計測条件
+/// </summary>
+struct Options {
+	std::string filter;              // 名前にこの文字列を含むものだけ計測（空ならすべて）
+	size_t samples = 20;             // 標本数
+	double minSampleSeconds = 0.005; // 1標本あたりの最短計測時間 [秒]
+	size_t warmupSamples = 2;        // 計測前に捨てる標本数
+};
+
+/// <summary>
+/// 計測結果
+/// </summary>
+struct Result {
+	std::string name;      // 名前
+	size_t batchSize;      // 1回の呼び出しで処理する要素数
+	size_t iterations;     // 1標本あたりの呼び出し回数
+	size_t samples;        // 標本数
+	double meanNs;         // 1要素あたりの平均時間 [ns]
+	double medianNs;       // 1要素あたりの中央値 [ns]
+	double minNs;          // 1要素あたりの最短時間 [ns]
+	double stddevNs;       // 1要素あたりの時間の標準偏差 [ns]
+	double itemsPerSecond; // スループット（中央値から求める）
+};
+
+/// <summary>
+/// マイクロベンチマークの登録と実行
+/// </summary>
+class Registry final {
+public:
+	/// <summary>
+	/// 計測対象を登録
+	/// </summary>
+	/// <param name="name">名前</param>
+	/// <param name="batchSize">1回の呼び出しで処理する要素数（ns/op はこの数で割る）</param>
+	/// <param name="body">計測する処理</param>
+	/// <param name="maxSamples">標本数の上限（1回に数秒かかる計測用。0 なら Options の標本数）</param>
+	void Add(std::string name, size_t batchSize, std::function<void()> body, size_t maxSamples = 0);
+
+	/// <summary>
+	/// 登録されたものを計測
+	/// </summary>
+	/// <param name="options">計測条件</param>
+	/// <returns>計測結果</returns>
+	std::vector<Result> Run(const Options& options) const;
+
+private:
+	struct Entry {
+		std::string name;
+		size_t batchSize;
+		std::function<void()> body;
+		size_t maxSamples;
+	};
+	std::vector<Entry> entries_;
+};
+
+// CPU が対応している SIMD レベルごとに、名前の後ろにレベルを付けて登録する
+template<typename Body> void AddPerSimdLevel(Registry& registry, const std::string& name, size_t batchSize, Body body) {
+	using KamataEngine::MathUtility::SimdLevel;
+	for (SimdLevel level : {SimdLevel::kScalar, SimdLevel::kSSE, SimdLevel::kAVX2}) {
+		if (level > KamataEngine::MathUtility::GetSupportedSimdLevel()) {
+			break;
+		}
+		const char* levelName = level == SimdLevel::kAVX2 ? "avx2" : level == SimdLevel::kSSE ? "sse" : "scalar";
+		registry.Add(name + "[" + levelName + "]", batchSize, [level, body] {
+			KamataEngine::MathUtility::SetSimdLevel(level);
+			body();
+		});
+	}
+}
+
+/// <summary>
+/// 計測データを、最初に計測するときに作る（--filter で外れたものは作らない）
+/// </summary>
+template<typename T> class Lazy final {
+public:
+	explicit Lazy(std::function<std::unique_ptr<T>()> create) : create_(std::move(create)) {}
+
+	T& Get() {
+		std::call_once(created_, [this] { value_ = create_(); });
+		return *value_;
+	}
+
+private:
+	std::function<std::unique_ptr<T>()> create_;
+	std::once_flag created_;
+	std::unique_ptr<T> value_;
+};
+
+// 並列版を計測するスレッド数（1, 2, 4, ... と論理コア数まで）
+std::vector<size_t> GetThreadCounts();
+
+// 結果を表形式で出力
+void WriteTable(std::ostream& os, const std::vector<Result>& results);
+// 結果を JSON で出力
+void WriteJson(std::ostream& os, const std::vector<Result>& results);
+
+} // namespace Benchmark
@@ -0,0 +1,511 @@
+#include "Checks.h"
+#include "3d/ObjParser.h"
+#include "3d/OcclusionBuffer.h"
+#include "3d/TransformHierarchy.h"
+#include "3d/WorldTransform.h"
+#include "base/ConstantBufferRing.h"
+#include "base/EntityWorld.h"
+#include "base/JobSystem.h"
+#include "math/AffineMatrix.h"
+#include "math/MathUtility.h"
+#include "math/MathUtilityConstexpr.h"
+#include "math/Projection.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace KamataEngine;
+using namespace KamataEngine::MathUtility;
+
+namespace Benchmark {
+
+namespace {
+
+// CpuUploadBuffer を使ったフレームごとの割り当て
+void CheckConstantBufferRing(Checker& checker) {
+	constexpr uint64_t kGpuBase = 0x10000;
+	CpuUploadBuffer buffer;
+	buffer.Create(4096, kGpuBase);
+	ConstantBufferRing ring;
+	ring.Initialize(buffer.GetMemory(), 2);
+	checker.Expect(ring.GetBytesPerFrame() == 2048, "ConstantBufferRing: 4096 bytes / 2 frames = 2048 bytes per frame");
+
+	// 256 バイト単位への切り上げ
+	const ConstantBufferAllocation a = ring.Allocate(1);
+	const ConstantBufferAllocation b = ring.Allocate(257);
+	checker.Expect(a && a.size == 256 && a.gpuAddress == kGpuBase, "ConstantBufferRing: 1 byte rounds up to 256 at the frame start");
+	checker.Expect(b && b.size == 512 && b.gpuAddress == kGpuBase + 256, "ConstantBufferRing: 257 bytes rounds up to 512 after the first allocation");
+	checker.Expect(reinterpret_cast<uintptr_t>(a.cpuAddress) % ConstantBufferRing::kAlignment == 0, "ConstantBufferRing: CPU address is 256-byte aligned");
+	const uint32_t value = 0x12345678;
+	const ConstantBufferAllocation pushed = ring.Push(value);
+	checker.Expect(pushed && *static_cast<const uint32_t*>(pushed.cpuAddress) == value, "ConstantBufferRing: Push copies the data");
+	ConstantBufferRingStats stats = ring.GetStats();
+	checker.Expect(stats.allocationCount == 3 && stats.usedBytes == 1024 && stats.failedAllocations == 0, "ConstantBufferRing: stats after 3 allocations");
+
+	// 容量不足（使用量はフレームの容量で頭打ちになる）
+	checker.Expect(!ring.Allocate(2048), "ConstantBufferRing: allocation larger than the rest of the frame fails");
+	stats = ring.GetStats();
+	checker.Expect(stats.failedAllocations == 1 && stats.allocationCount == 3, "ConstantBufferRing: failed allocation is counted");
+	checker.Expect(stats.usedBytes == ring.GetBytesPerFrame(), "ConstantBufferRing: usedBytes is clamped to the frame size after overflow");
+
+	// 次のフレームは後半の領域から割り当て、最大使用量は前のフレームの分を保つ
+	ring.BeginFrame();
+	const ConstantBufferAllocation c = ring.Allocate(256);
+	stats = ring.GetStats();
+	checker.Expect(ring.GetFrameIndex() == 1 && c.gpuAddress == kGpuBase + 2048, "ConstantBufferRing: BeginFrame switches to the second frame region");
+	checker.Expect(stats.usedBytes == 256 && stats.failedAllocations == 0 && stats.allocationCount == 1, "ConstantBufferRing: BeginFrame resets the frame stats");
+	checker.Expect(stats.highWaterBytes == 2048, "ConstantBufferRing: highWaterBytes keeps the previous frame's peak");
+	ring.BeginFrame();
+	const ConstantBufferAllocation d = ring.Allocate(256);
+	checker.Expect(ring.GetFrameIndex() == 0 && d.gpuAddress == kGpuBase, "ConstantBufferRing: frame index wraps to the first region");
+	checker.Expect(ring.GetStats().highWaterBytes == 2048, "ConstantBufferRing: highWaterBytes is kept across frames");
+}
+
+// 定数式版と実行時版（エンジンのライブラリか HostMathUtility）を同じ入力で比べる。
+// 成分ごとの演算は完全に一致し、積和はエンジン側の最適化（FMA など）による丸めの差だけを許す
+void CheckConstexprParity(Checker& checker) {
+	namespace Constexpr = MathUtility::Constexpr;
+	constexpr float kTolerance = 1e-4f; // 入力は ±10 なので、4項の積和の丸め誤差はこれに収まる
+	auto near = [](float a, float b) { return std::abs(a - b) <= kTolerance; };
+	auto nearVector = [&near](const Vector3& a, const Vector3& b) { return near(a.x, b.x) && near(a.y, b.y) && near(a.z, b.z); };
+	auto nearMatrix = [&near](const Matrix4x4& a, const Matrix4x4& b) {
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				if (!near(a.m[i][j], b.m[i][j])) {
+					return false;
+				}
+			}
+		}
+		return true;
+	};
+
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+	auto randomVector = [&] { return Vector3{value(rng), value(rng), value(rng)}; };
+	auto randomMatrix = [&] {
+		Matrix4x4 m;
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				m.m[i][j] = value(rng);
+			}
+		}
+		return m;
+	};
+
+	bool vectorOperators = true;
+	bool dotCross = true;
+	bool matrixBuilders = true;
+	bool matrixProduct = true;
+	bool transforms = true;
+	bool lerp = true;
+	for (int i = 0; i < 1000; ++i) {
+		const Vector3 a = randomVector();
+		const Vector3 b = randomVector();
+		const float s = value(rng);
+		// 成分ごとの演算は丸めが1回だけなので、実装によらず一致する
+		vectorOperators &= Constexpr::Equal(Constexpr::operator+(a, b), MathUtility::operator+(a, b));
+		vectorOperators &= Constexpr::Equal(Constexpr::operator-(a, b), MathUtility::operator-(a, b));
+		vectorOperators &= Constexpr::Equal(Constexpr::operator-(a), MathUtility::operator-(a));
+		vectorOperators &= Constexpr::Equal(Constexpr::operator*(a, s), MathUtility::operator*(a, s));
+		vectorOperators &= Constexpr::Equal(Constexpr::operator*(s, a), MathUtility::operator*(s, a));
+		vectorOperators &= Constexpr::Equal(Constexpr::operator/(a, s), MathUtility::operator/(a, s));
+		Vector3 constexprAssigned = a;
+		Vector3 runtimeAssigned = a;
+		Constexpr::operator*=(Constexpr::operator+=(constexprAssigned, b), s);
+		MathUtility::operator*=(MathUtility::operator+=(runtimeAssigned, b), s);
+		vectorOperators &= Constexpr::Equal(constexprAssigned, runtimeAssigned);
+
+		dotCross &= near(Constexpr::Dot(a, b), MathUtility::Dot(a, b));
+		dotCross &= nearVector(Constexpr::Cross(a, b), MathUtility::Cross(a, b));
+
+		matrixBuilders &= Constexpr::Equal(Constexpr::MakeScaleMatrix(a), MathUtility::MakeScaleMatrix(a));
+		matrixBuilders &= Constexpr::Equal(Constexpr::MakeTranslateMatrix(a), MathUtility::MakeTranslateMatrix(a));
+		matrixBuilders &= Constexpr::Equal(Constexpr::MakeTranslateMatrix(Vector2{a.x, a.y}), MathUtility::MakeTranslateMatrix(Vector2{a.x, a.y}));
+
+		const Matrix4x4 m1 = randomMatrix();
+		const Matrix4x4 m2 = randomMatrix();
+		matrixBuilders &= Constexpr::Equal(Constexpr::Transpose(m1), MathUtility::Transpose(m1));
+		matrixProduct &= nearMatrix(Constexpr::operator*(m1, m2), MathUtility::operator*(m1, m2));
+		Matrix4x4 constexprProduct = m1;
+		Matrix4x4 runtimeProduct = m1;
+		Constexpr::operator*=(constexprProduct, m2);
+		MathUtility::operator*=(runtimeProduct, m2);
+		matrixProduct &= nearMatrix(constexprProduct, runtimeProduct);
+
+		transforms &= nearVector(Constexpr::Transform(a, m1), MathUtility::Transform(a, m1));
+		transforms &= nearVector(Constexpr::TransformNormal(a, m1), MathUtility::TransformNormal(a, m1));
+
+		lerp &= near(Constexpr::Lerp(a.x, b.x, s * 0.1f), MathUtility::Lerp(a.x, b.x, s * 0.1f));
+	}
+	checker.Expect(Constexpr::Equal(Constexpr::MakeIdentityMatrix(), MathUtility::MakeIdentityMatrix()), "Constexpr::MakeIdentityMatrix matches MathUtility");
+	checker.Expect(Constexpr::Equal(Constexpr::Vector3Zero(), MathUtility::Vector3Zero()), "Constexpr::Vector3Zero matches MathUtility");
+	checker.Expect(vectorOperators, "Constexpr Vector3 operators match MathUtility exactly");
+	checker.Expect(dotCross, "Constexpr::Dot / Cross match MathUtility");
+	checker.Expect(matrixBuilders, "Constexpr::MakeScaleMatrix / MakeTranslateMatrix / Transpose match MathUtility exactly");
+	checker.Expect(matrixProduct, "Constexpr Matrix4x4 operator* / operator*= match MathUtility");
+	checker.Expect(transforms, "Constexpr::Transform / TransformNormal match MathUtility");
+	checker.Expect(lerp, "Constexpr::Lerp matches MathUtility");
+}
+
+bool IsSameMatrix(const Matrix4x4& a, const Matrix4x4& b) { return std::memcmp(&a, &b, sizeof(Matrix4x4)) == 0; }
+
+// ジョブの依存関係、メインスレッド用のジョブ、入れ子の ParallelFor
+void CheckJobSystem(Checker& checker) {
+	// コア数によらずワークスティーリングを通すため、ワーカー数を固定する
+	JobSystem jobSystem(3);
+	checker.Expect(jobSystem.GetThreadCount() == 4 && jobSystem.IsMainThread(), "JobSystem: 3 workers + the main thread");
+
+	// 後続のジョブは依存先のジョブがすべて終わってから実行される
+	constexpr uint32_t kJobCount = 64;
+	std::atomic<uint32_t> finished = 0;
+	std::atomic<uint32_t> finishedBeforeDependent = 0;
+	JobCounter first;
+	JobCounter second;
+	for (uint32_t i = 0; i < kJobCount; ++i) {
+		std::atomic<uint32_t>* counter = &finished;
+		jobSystem.Schedule("Check.First", [counter] { counter->fetch_add(1); }, &first);
+	}
+	std::atomic<uint32_t>* observed = &finishedBeforeDependent;
+	std::atomic<uint32_t>* counter = &finished;
+	jobSystem.Schedule("Check.Dependent", [observed, counter] { observed->store(counter->load()); }, &second, &first);
+	jobSystem.Wait(second);
+	checker.Expect(first.IsDone() && finishedBeforeDependent.load() == kJobCount, "JobSystem: dependent job runs after all of its dependency's jobs");
+
+	// メインスレッド用のジョブはワーカーに盗まれない
+	const std::thread::id mainThreadId = std::this_thread::get_id();
+	bool ranOnMainThread = false;
+	JobCounter mainThreadCounter;
+	bool* ran = &ranOnMainThread;
+	jobSystem.ScheduleOnMainThread("Check.MainThread", [ran, mainThreadId] { *ran = std::this_thread::get_id() == mainThreadId; }, &mainThreadCounter);
+	jobSystem.RunMainThreadJobs();
+	checker.Expect(mainThreadCounter.IsDone() && ranOnMainThread, "JobSystem: ScheduleOnMainThread runs on the main thread in RunMainThreadJobs");
+
+	// 入れ子の ParallelFor でも各要素をちょうど1回ずつ処理する
+	constexpr size_t kOuter = 16;
+	constexpr size_t kInner = 1000;
+	std::vector<std::atomic<uint32_t>> visits(kOuter * kInner);
+	jobSystem.ResetStats();
+	jobSystem.ParallelFor("Check.Outer", kOuter, 1, [&](size_t outerBegin, size_t outerEnd) {
+		for (size_t outer = outerBegin; outer < outerEnd; ++outer) {
+			jobSystem.ParallelFor("Check.Inner", kInner, 64, [&, outer](size_t begin, size_t end) {
+				for (size_t inner = begin; inner < end; ++inner) {
+					visits[outer * kInner + inner].fetch_add(1, std::memory_order_relaxed);
+				}
+			});
+		}
+	});
+	bool visitedOnce = true;
+	for (const std::atomic<uint32_t>& visit : visits) {
+		visitedOnce &= visit.load() == 1;
+	}
+	checker.Expect(visitedOnce, "JobSystem: nested ParallelFor visits every element once");
+
+	uint64_t executed = 0;
+	const std::vector<JobThreadStats> stats = jobSystem.GetStats();
+	for (size_t i = 0; i < stats.size(); ++i) {
+		executed += stats[i].executed;
+		checker.GetStream() << "JobSystem thread " << i << ": executed " << stats[i].executed << ", stolen " << stats[i].stolen << "\n";
+	}
+	checker.Expect(executed > 0, "JobSystem: nested ParallelFor schedules jobs");
+}
+
+// JobSystem を受け取る並列版が、逐次版と同じ結果になる
+void CheckJobSystemOverloads(Checker& checker) {
+	JobSystem jobSystem(3);
+
+	// TransformHierarchy（閾値を下げて、各深さを分割させる）
+	TransformHierarchy serial;
+	TransformHierarchy parallel;
+	parallel.SetParallelThreshold(16);
+	for (uint32_t i = 0; i < 2000; ++i) {
+		const uint32_t parent = i == 0 ? TransformHierarchy::kInvalidNode : (i - 1) / 4;
+		const Vector3 rotation = {0.001f * static_cast<float>(i), 0.3f, -0.2f};
+		const Vector3 translation = {1.0f, static_cast<float>(i % 7), -0.5f};
+		for (TransformHierarchy* hierarchy : {&serial, &parallel}) {
+			const uint32_t node = hierarchy->Create(parent);
+			hierarchy->SetRotation(node, rotation);
+			hierarchy->SetTranslation(node, translation);
+		}
+	}
+	serial.Update();
+	parallel.Update(jobSystem);
+	bool sameWorld = parallel.GetStats().recomputed == serial.GetStats().recomputed;
+	for (uint32_t node = 0; node < serial.GetNodeCount(); ++node) {
+		sameWorld &= IsSameMatrix(serial.GetWorldMatrix(node), parallel.GetWorldMatrix(node));
+	}
+	checker.Expect(sameWorld, "TransformHierarchy::Update(JobSystem&) matches Update()");
+
+	// EntityWorld
+	struct Counter {
+		uint32_t value;
+	};
+	EntityWorld world;
+	for (uint32_t i = 0; i < 20000; ++i) {
+		world.Get<Counter>(world.Create<Counter>())->value = i;
+	}
+	std::atomic<uint64_t> sum = 0;
+	world.ParallelForEach<Counter>(jobSystem, [&sum](Counter& counter) {
+		sum.fetch_add(counter.value, std::memory_order_relaxed);
+		++counter.value;
+	});
+	uint64_t sumAfter = 0;
+	world.ForEach<Counter>([&sumAfter](const Counter& counter) { sumAfter += counter.value; });
+	checker.Expect(sum.load() == 19999ull * 20000 / 2 && sumAfter == sum.load() + 20000, "EntityWorld::ParallelForEach(JobSystem&) visits every entity once");
+
+	// 同じワールドへの読み取りだけの走査を2つのジョブから同時に行う（アーキタイプを分けて、走査するチャンクの並びを変える）
+	struct Mass {
+		uint32_t value;
+	};
+	struct Charge {
+		uint32_t value;
+	};
+	EntityWorld sharedWorld;
+	for (uint32_t i = 0; i < 4000; ++i) {
+		const Entity entity = i % 2 == 0 ? sharedWorld.Create<Mass>() : sharedWorld.Create<Mass, Charge>();
+		sharedWorld.Get<Mass>(entity)->value = 1000;
+		if (Charge* charge = sharedWorld.Get<Charge>(entity)) {
+			charge->value = 2000;
+		}
+	}
+	bool concurrentQueries = true;
+	for (int round = 0; round < 20; ++round) {
+		struct Query {
+			EntityWorld* world;
+			JobSystem* jobSystem;
+			std::atomic<uint64_t> massSum;
+			std::atomic<uint64_t> chargeSum;
+		} query{&sharedWorld, &jobSystem, {0}, {0}};
+		Query* q = &query;
+		JobCounter queries;
+		jobSystem.Schedule("Check.MassQuery", [q] { q->world->ParallelForEach<Mass>(*q->jobSystem, [q](const Mass& mass) { q->massSum += mass.value; }); }, &queries);
+		jobSystem.Schedule("Check.ChargeQuery", [q] { q->world->ParallelForEach<Charge>(*q->jobSystem, [q](const Charge& charge) { q->chargeSum += charge.value; }); },
+		                   &queries);
+		jobSystem.Wait(queries);
+		concurrentQueries &= query.massSum.load() == 4000ull * 1000 && query.chargeSum.load() == 2000ull * 2000;
+	}
+	// コア数によらず重なるよう、走査の途中でもう1つの走査を始める
+	std::atomic<uint64_t> outerMassSum = 0;
+	std::atomic<uint64_t> innerChargeSum = 0;
+	std::atomic<bool> innerStarted = false;
+	sharedWorld.ParallelForEach<Mass>(jobSystem, [&](const Mass& mass) {
+		if (!innerStarted.exchange(true)) {
+			sharedWorld.ParallelForEach<Charge>(jobSystem, [&innerChargeSum](const Charge& charge) { innerChargeSum += charge.value; });
+		}
+		outerMassSum += mass.value;
+	});
+	concurrentQueries &= outerMassSum.load() == 4000ull * 1000 && innerChargeSum.load() == 2000ull * 2000;
+	checker.Expect(concurrentQueries, "EntityWorld::ParallelForEach(JobSystem&): two concurrent queries on one world");
+
+	// OcclusionBuffer（手前の壁の後ろに箱を並べる）
+	const std::vector<Vector3> wall = {{-4.0f, -4.0f, 10.0f}, {4.0f, -4.0f, 10.0f}, {4.0f, 4.0f, 10.0f}, {-4.0f, 4.0f, 10.0f}};
+	const std::vector<uint32_t> wallIndices = {0, 2, 1, 0, 3, 2, 0, 1, 2, 0, 2, 3};
+	std::vector<float> centerX, centerY, centerZ, extent;
+	for (int x = -8; x <= 8; ++x) {
+		for (int y = -4; y <= 4; ++y) {
+			centerX.push_back(static_cast<float>(x));
+			centerY.push_back(static_cast<float>(y));
+			centerZ.push_back(20.0f);
+			extent.push_back(0.25f);
+		}
+	}
+	const AABBSoA boxes = {centerX.data(), centerY.data(), centerZ.data(), extent.data(), extent.data(), extent.data(), centerX.size()};
+	const Matrix4x4 viewProjection = MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.1f, 100.0f);
+	OcclusionBuffer serialBuffer;
+	OcclusionBuffer parallelBuffer;
+	std::vector<uint32_t> serialVisible(boxes.size);
+	std::vector<uint32_t> parallelVisible(boxes.size);
+	for (OcclusionBuffer* buffer : {&serialBuffer, &parallelBuffer}) {
+		buffer->Initialize();
+		buffer->BeginFrame(viewProjection);
+		buffer->AddOccluder(wall.data(), sizeof(Vector3), wallIndices, MakeIdentityMatrix());
+	}
+	serialBuffer.Rasterize();
+	parallelBuffer.Rasterize(jobSystem);
+	const size_t serialCount = serialBuffer.CullAABBs(boxes, serialVisible);
+	const size_t parallelCount = parallelBuffer.CullAABBs(jobSystem, boxes, parallelVisible);
+	const size_t pixelCount = static_cast<size_t>(serialBuffer.GetWidth()) * serialBuffer.GetHeight();
+	checker.Expect(std::memcmp(serialBuffer.GetDepths(), parallelBuffer.GetDepths(), pixelCount * sizeof(float)) == 0,
+	               "OcclusionBuffer::Rasterize(JobSystem&) matches Rasterize()");
+	checker.Expect(serialCount == parallelCount && serialCount < boxes.size &&
+	                   std::memcmp(serialVisible.data(), parallelVisible.data(), serialCount * sizeof(uint32_t)) == 0,
+	               "OcclusionBuffer::CullAABBs(JobSystem&) matches CullAABBs()");
+
+	// ObjParser（チャンクに分かれる大きさにする）
+	std::string text = "o grid\nvn 0 1 0\n";
+	for (uint32_t i = 0; i < 40000; ++i) {
+		text += "v " + std::to_string(i) + " 0 " + std::to_string(i % 13) + "\n";
+		if (i >= 2) {
+			text += "f " + std::to_string(i - 1) + "//1 " + std::to_string(i) + "//1 " + std::to_string(i + 1) + "//1\n";
+		}
+	}
+	ObjModelData serialModel;
+	ObjModelData parallelModel;
+	const bool serialValid = ObjParser::Parse(text, serialModel);
+	const bool parallelValid = ObjParser::Parse(jobSystem, text, parallelModel);
+	bool sameModel = serialValid && parallelValid && serialModel.meshes.size() == 1 && parallelModel.meshes.size() == 1;
+	if (sameModel) {
+		const ObjMesh& a = serialModel.meshes[0];
+		const ObjMesh& b = parallelModel.meshes[0];
+		sameModel = a.vertices.size() == b.vertices.size() && a.indices == b.indices &&
+		            std::memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(ObjVertex)) == 0;
+	}
+	checker.Expect(sameModel, "ObjParser::Parse(JobSystem&) matches Parse()");
+}
+
+// 遮蔽物の壁1枚に対する判定が保守的であること（見えている箱を隠れていると判定しない）
+void CheckOcclusionBuffer(Checker& checker) {
+	// カメラは原点から +z を向く。z = 10 の壁（±4）は、奥行き z では ±0.4z の範囲を隠す
+	const std::vector<Vector3> wall = {{-4.0f, -4.0f, 10.0f}, {4.0f, -4.0f, 10.0f}, {4.0f, 4.0f, 10.0f}, {-4.0f, 4.0f, 10.0f}};
+	const std::vector<uint32_t> wallIndices = {0, 2, 1, 0, 3, 2};
+	std::vector<float> centerX, centerY, centerZ, extent;
+	auto addBox = [&](float x, float y, float z, float e) {
+		centerX.push_back(x);
+		centerY.push_back(y);
+		centerZ.push_back(z);
+		extent.push_back(e);
+		return static_cast<uint32_t>(centerX.size() - 1);
+	};
+	// 壁の真後ろで、画面上の壁の内側に収まる箱
+	std::vector<uint32_t> hidden;
+	for (float x : {-4.0f, 0.0f, 4.0f}) {
+		for (float y : {-4.0f, 0.0f, 4.0f}) {
+			hidden.push_back(addBox(x, y, 20.0f, 0.5f));
+		}
+	}
+	// 壁の後ろでも画面上で壁の外にある箱、壁の縁をまたぐ箱、壁より手前の箱
+	const uint32_t outsideLeft = addBox(-12.0f, 0.0f, 20.0f, 0.5f);
+	const uint32_t outsideRight = addBox(12.0f, 0.0f, 20.0f, 0.5f);
+	const uint32_t outsideFar = addBox(-30.0f, 0.0f, 60.0f, 1.0f);
+	const uint32_t straddling = addBox(8.0f, 0.0f, 20.0f, 1.0f);
+	const uint32_t inFront = addBox(0.0f, 0.0f, 5.0f, 0.5f);
+	const uint32_t touchingWall = addBox(0.0f, 0.0f, 10.0f, 0.5f);
+	const AABBSoA boxes = {centerX.data(), centerY.data(), centerZ.data(), extent.data(), extent.data(), extent.data(), centerX.size()};
+
+	auto cull = [&](DepthMode depthMode) {
+		OcclusionBuffer buffer;
+		buffer.Initialize();
+		buffer.BeginFrame(MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.1f, 100.0f, depthMode), depthMode);
+		buffer.AddOccluder(wall.data(), sizeof(Vector3), wallIndices, MakeIdentityMatrix());
+		buffer.Rasterize();
+		std::vector<uint32_t> visible(boxes.size);
+		visible.resize(buffer.CullAABBs(boxes, visible));
+		return visible;
+	};
+	const std::vector<uint32_t> visible = cull(DepthMode::kStandard);
+	auto isVisible = [&visible](uint32_t index) { return std::find(visible.begin(), visible.end(), index) != visible.end(); };
+
+	bool allHidden = true;
+	for (uint32_t index : hidden) {
+		allHidden &= !isVisible(index);
+	}
+	checker.Expect(allHidden, "OcclusionBuffer: boxes inside the wall's screen footprint behind it are culled");
+	checker.Expect(isVisible(outsideLeft) && isVisible(outsideRight) && isVisible(outsideFar), "OcclusionBuffer: boxes outside the wall's screen footprint stay visible");
+	checker.Expect(isVisible(straddling), "OcclusionBuffer: a box straddling the wall's edge stays visible");
+	checker.Expect(isVisible(inFront) && isVisible(touchingWall), "OcclusionBuffer: boxes in front of or touching the wall stay visible");
+	checker.Expect(cull(DepthMode::kReverseZ) == visible, "OcclusionBuffer: reverse-Z gives the same visible set");
+	checker.Expect(cull(DepthMode::kInfiniteReverseZ) == visible, "OcclusionBuffer: infinite reverse-Z gives the same visible set");
+
+	// 同じバッファへの判定をジョブから重ねて実行する
+	OcclusionBuffer buffer;
+	buffer.Initialize();
+	buffer.BeginFrame(MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.1f, 100.0f));
+	buffer.AddOccluder(wall.data(), sizeof(Vector3), wallIndices, MakeIdentityMatrix());
+	buffer.Rasterize();
+	JobSystem jobSystem(3);
+	struct Cull {
+		const OcclusionBuffer* buffer;
+		JobSystem* jobSystem;
+		const AABBSoA* boxes;
+		std::vector<uint32_t> visible[2];
+		size_t counts[2];
+	} jobs{&buffer, &jobSystem, &boxes, {std::vector<uint32_t>(boxes.size), std::vector<uint32_t>(boxes.size)}, {}};
+	Cull* c = &jobs;
+	JobCounter counter;
+	for (int i = 0; i < 2; ++i) {
+		jobSystem.Schedule("Check.Cull", [c, i] { c->counts[i] = c->buffer->CullAABBs(*c->jobSystem, *c->boxes, c->visible[i]); }, &counter);
+	}
+	jobSystem.Wait(counter);
+	bool sameResults = true;
+	for (int i = 0; i < 2; ++i) {
+		jobs.visible[i].resize(jobs.counts[i]);
+		sameResults &= jobs.visible[i] == visible;
+	}
+	checker.Expect(sameResults, "OcclusionBuffer::CullAABBs(JobSystem&): overlapping culls on one buffer");
+}
+
+// TransformHierarchy の再計算と転送の数（変わったノードとその子孫だけを数える）
+void CheckTransformHierarchyStats(Checker& checker) {
+	// root ─ a ─ a0, a1
+	//      └ b ─ b0
+	TransformHierarchy hierarchy;
+	const uint32_t root = hierarchy.Create();
+	const uint32_t a = hierarchy.Create(root);
+	hierarchy.Create(a);
+	hierarchy.Create(a);
+	const uint32_t b = hierarchy.Create(root);
+	const uint32_t b0 = hierarchy.Create(b);
+
+	hierarchy.Update();
+	checker.Expect(hierarchy.GetStats().nodeCount == 6 && hierarchy.GetStats().recomputed == 6, "TransformHierarchy: first Update recomputes every node");
+	hierarchy.Update();
+	checker.Expect(hierarchy.GetStats().recomputed == 0 && hierarchy.GetStats().transferred == 0, "TransformHierarchy: static tree recomputes nothing");
+
+	hierarchy.SetTranslation(a, {1, 2, 3});
+	hierarchy.Update();
+	checker.Expect(hierarchy.GetStats().recomputed == 3, "TransformHierarchy: changing one node recomputes exactly its subtree");
+	hierarchy.Update();
+	checker.Expect(hierarchy.GetStats().recomputed == 0, "TransformHierarchy: dirty flags are cleared after Update");
+
+#ifdef NOVICE_BENCHMARK_HOST_WORLD_TRANSFORM
+	// 結び付けた WorldTransform は、結び付けた直後とフィールドが変わったときだけ転送する
+	WorldTransform worldTransform;
+	hierarchy.Bind(b0, &worldTransform);
+	hierarchy.Update();
+	checker.Expect(hierarchy.GetStats().recomputed == 1 && hierarchy.GetStats().transferred == 1 && worldTransform.GetTransferCount() == 1,
+	    "TransformHierarchy: Bind transfers once");
+	hierarchy.Update();
+	checker.Expect(hierarchy.GetStats().transferred == 0 && worldTransform.GetTransferCount() == 1, "TransformHierarchy: unchanged WorldTransform is not transferred");
+	worldTransform.translation_ = {0, 5, 0};
+	hierarchy.Update();
+	checker.Expect(hierarchy.GetStats().recomputed == 1 && hierarchy.GetStats().transferred == 1 && worldTransform.GetTransferCount() == 2,
+	    "TransformHierarchy: WorldTransform field change is transferred");
+	checker.Expect(worldTransform.matWorld_.m[3][1] == 5.0f, "TransformHierarchy: transferred matWorld_ has the new translation");
+	hierarchy.SetTranslation(b, {0, 1, 0});
+	hierarchy.Update();
+	checker.Expect(hierarchy.GetStats().recomputed == 2 && hierarchy.GetStats().transferred == 1 && worldTransform.GetTransferCount() == 3,
+	    "TransformHierarchy: parent change transfers the bound child");
+	hierarchy.Update();
+	checker.Expect(hierarchy.GetStats().transferred == 0 && worldTransform.GetTransferCount() == 3, "TransformHierarchy: no transfer after the change settles");
+#endif
+}
+
+} // namespace
+
+void Checker::Expect(bool condition, const std::string& description) {
+	if (condition) {
+		++passed_;
+	} else {
+		++failed_;
+		os_ << "check failed: " << description << "\n";
+	}
+}
+
+bool RunChecks(std::ostream& os) {
+	Checker checker(os);
+	CheckConstexprParity(checker);
+	CheckConstantBufferRing(checker);
+	CheckJobSystem(checker);
+	CheckJobSystemOverloads(checker);
+	CheckOcclusionBuffer(checker);
+	CheckTransformHierarchyStats(checker);
+	os << "checks: " << checker.GetPassedCount() << " passed, " << checker.GetFailedCount() << " failed\n";
+	return checker.GetFailedCount() == 0;
+}
+
+} // namespace Benchmark
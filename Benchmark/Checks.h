@@ -0,0 +1,39 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+
+namespace Benchmark {
+
+/// <summary>
+/// 計測の前に行う動作確認（GPU やエンジンのライブラリなしで確かめられるもの）
+/// </summary>
+class Checker final {
+public:
+	explicit Checker(std::ostream& os) : os_(os) {}
+
+	/// <summary>
+	/// 条件を確かめる（満たさなければ内容を出力する）
+	/// </summary>
+	/// <param name="condition">条件</param>
+	/// <param name="description">確かめる内容</param>
+	void Expect(bool condition, const std::string& description);
+
+	/// <summary>
+	/// 確認の途中経過（統計など）の出力先
+	/// </summary>
+	std::ostream& GetStream() { return os_; }
+
+	size_t GetPassedCount() const { return passed_; }
+	size_t GetFailedCount() const { return failed_; }
+
+private:
+	std::ostream& os_;
+	size_t passed_ = 0;
+	size_t failed_ = 0;
+};
+
+// すべての動作確認を行い、失敗がなければ true を返す
+bool RunChecks(std::ostream& os);
+
+} // namespace Benchmark
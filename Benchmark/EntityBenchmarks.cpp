@@ -0,0 +1,98 @@
+#include "EntityBenchmarks.h"
+#include "base/EntityWorld.h"
+#include "base/JobSystem.h"
+#include "base/ThreadPool.h"
+#include "math/Vector3.h"
+#include "math/Vector4.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace KamataEngine;
+
+namespace Benchmark {
+
+namespace {
+
+constexpr size_t kEntityCount = 50000;
+constexpr float kDeltaTime = 1.0f / 60.0f;
+
+// ゲームオブジェクトの代わり（WorldTransform と ObjectColor はエンジンのライブラリが必要なので、同じ大きさの値で代用する）
+struct Transform {
+	Vector3 scale = {1.0f, 1.0f, 1.0f};
+	Vector3 rotation = {};
+	Vector3 translation = {};
+	float matWorld[16] = {};
+};
+struct Velocity {
+	Vector3 value = {};
+};
+struct Color {
+	Vector4 value = {1.0f, 1.0f, 1.0f, 1.0f};
+};
+
+// 従来の、オブジェクトごとに確保したクラス
+struct GameObject {
+	Transform transform;
+	Color color;
+	Velocity velocity;
+};
+
+inline void Integrate(Transform& transform, const Velocity& velocity) {
+	transform.translation.x += velocity.value.x * kDeltaTime;
+	transform.translation.y += velocity.value.y * kDeltaTime;
+	transform.translation.z += velocity.value.z * kDeltaTime;
+}
+
+using GameObjects = std::vector<std::unique_ptr<GameObject>>;
+
+// 確保の順番をばらして、ヒープ上で散らばった状態にする
+std::unique_ptr<GameObjects> MakeGameObjects() {
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+	auto objects = std::make_unique<GameObjects>();
+	for (size_t i = 0; i < kEntityCount; ++i) {
+		objects->push_back(std::make_unique<GameObject>());
+		objects->back()->velocity.value = {value(rng), value(rng), value(rng)};
+	}
+	std::shuffle(objects->begin(), objects->end(), rng);
+	return objects;
+}
+
+// 色を持たないエンティティも混ぜてアーキタイプを2つにする
+std::unique_ptr<EntityWorld> MakeWorld() {
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+	auto world = std::make_unique<EntityWorld>();
+	for (size_t i = 0; i < kEntityCount; ++i) {
+		const Entity entity = i % 4 == 0 ? world->Create<Transform, Velocity>() : world->Create<Transform, Velocity, Color>();
+		world->Get<Velocity>(entity)->value = {value(rng), value(rng), value(rng)};
+	}
+	return world;
+}
+
+} // namespace
+
+void RegisterEntityBenchmarks(Registry& registry) {
+	auto objects = std::make_shared<Lazy<GameObjects>>(MakeGameObjects);
+	registry.Add("GameObject pointers update(50000)", kEntityCount, [objects] {
+		for (const std::unique_ptr<GameObject>& object : objects->Get()) {
+			Integrate(object->transform, object->velocity);
+		}
+	});
+
+	auto world = std::make_shared<Lazy<EntityWorld>>(MakeWorld);
+	registry.Add("EntityWorld::ForEach(50000)", kEntityCount, [world] { world->Get().ForEach<Transform, Velocity>(Integrate); });
+	for (size_t threadCount : GetThreadCounts()) {
+		auto threadPool = std::make_shared<Lazy<ThreadPool>>([threadCount] { return std::make_unique<ThreadPool>(threadCount - 1); });
+		registry.Add("EntityWorld::ParallelForEach(50000,threads=" + std::to_string(threadCount) + ")", kEntityCount,
+		             [world, threadPool] { world->Get().ParallelForEach<Transform, Velocity>(threadPool->Get(), Integrate); });
+		auto jobSystem = std::make_shared<Lazy<JobSystem>>([threadCount] { return std::make_unique<JobSystem>(threadCount - 1); });
+		registry.Add("EntityWorld::ParallelForEach(50000,jobs=" + std::to_string(threadCount) + ")", kEntityCount,
+		             [world, jobSystem] { world->Get().ParallelForEach<Transform, Velocity>(jobSystem->Get(), Integrate); });
+	}
+}
+
+} // namespace Benchmark
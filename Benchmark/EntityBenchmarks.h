@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Benchmark {
+
+// EntityWorld のクエリの走査を、オブジェクトごとにヒープ確保した場合と比べて登録
+void RegisterEntityBenchmarks(Registry& registry);
+
+} // namespace Benchmark
@@ -0,0 +1,54 @@
+#pragma once
+
+// KamataEngine の WorldTransform は定数バッファ（d3d12.h）を持つため、
+// エンジンのライブラリなしでベンチマークを動かすときにこの宣言で置き換える。
+// TransformHierarchy が使うメンバの並びと名前はエンジンと同じ。
+#include "math/Matrix4x4.h"
+#include "math/Vector3.h"
+#include <cstdint>
+#include <type_traits>
+
+namespace KamataEngine {
+
+/// <summary>
+/// ワールド変換データ（GPU なし）
+/// </summary>
+class WorldTransform {
+public:
+	// ローカルスケール
+	Vector3 scale_ = {1, 1, 1};
+	// X,Y,Z軸回りのローカル回転角
+	Vector3 rotation_ = {0, 0, 0};
+	// ローカル座標
+	Vector3 translation_ = {0, 0, 0};
+	// ローカル → ワールド変換行列
+	Matrix4x4 matWorld_;
+	// 親となるワールド変換へのポインタ
+	const WorldTransform* parent_ = nullptr;
+
+	WorldTransform() = default;
+	~WorldTransform() = default;
+
+	void Initialize();
+	void CreateConstBuffer();
+	void Map();
+	/// <summary>
+	/// 行列を転送する（転送した回数を数えるだけ）
+	/// </summary>
+	void TransferMatrix();
+
+	/// <summary>
+	/// TransferMatrix を呼んだ回数
+	/// </summary>
+	uint32_t GetTransferCount() const { return transferCount_; }
+
+private:
+	uint32_t transferCount_ = 0;
+	// コピー禁止
+	WorldTransform(const WorldTransform&) = delete;
+	WorldTransform& operator=(const WorldTransform&) = delete;
+};
+
+static_assert(!std::is_copy_assignable_v<WorldTransform>);
+
+} // namespace KamataEngine
@@ -0,0 +1,256 @@
+// KamataEngine の MathUtility はビルド済みライブラリ（Windows 専用）に含まれるため、
+// それ以外の環境でベンチマークを動かすときに同じ宣言の実装を提供する。
+// 行ベクトル (v * M)・左手座標系の規約はエンジンと同じ。
+#include "math/MathUtility.h"
+#include <cmath>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+Vector2 operator+(const Vector2& v) { return v; }
+Vector2 operator-(const Vector2& v) { return {-v.x, -v.y}; }
+
+Vector2& operator+=(Vector2& lhv, const Vector2& rhv) {
+	lhv.x += rhv.x;
+	lhv.y += rhv.y;
+	return lhv;
+}
+Vector2& operator-=(Vector2& lhv, const Vector2& rhv) {
+	lhv.x -= rhv.x;
+	lhv.y -= rhv.y;
+	return lhv;
+}
+Vector2& operator*=(Vector2& v, float s) {
+	v.x *= s;
+	v.y *= s;
+	return v;
+}
+Vector2& operator/=(Vector2& v, float s) {
+	v.x /= s;
+	v.y /= s;
+	return v;
+}
+
+const Vector2 Vector2Zero() { return {0.0f, 0.0f}; }
+
+float Length(const Vector2& v) { return std::sqrt(v.x * v.x + v.y * v.y); }
+
+Vector3 operator+(const Vector3& v) { return v; }
+Vector3 operator-(const Vector3& v) { return {-v.x, -v.y, -v.z}; }
+
+Vector3& operator+=(Vector3& lhv, const Vector3& rhv) {
+	lhv.x += rhv.x;
+	lhv.y += rhv.y;
+	lhv.z += rhv.z;
+	return lhv;
+}
+Vector3& operator-=(Vector3& lhv, const Vector3& rhv) {
+	lhv.x -= rhv.x;
+	lhv.y -= rhv.y;
+	lhv.z -= rhv.z;
+	return lhv;
+}
+Vector3& operator*=(Vector3& v, float s) {
+	v.x *= s;
+	v.y *= s;
+	v.z *= s;
+	return v;
+}
+Vector3& operator/=(Vector3& v, float s) {
+	v.x /= s;
+	v.y /= s;
+	v.z /= s;
+	return v;
+}
+
+const Vector3 operator+(const Vector3& v1, const Vector3& v2) { return {v1.x + v2.x, v1.y + v2.y, v1.z + v2.z}; }
+const Vector3 operator-(const Vector3& v1, const Vector3& v2) { return {v1.x - v2.x, v1.y - v2.y, v1.z - v2.z}; }
+const Vector3 operator*(const Vector3& v, float s) { return {v.x * s, v.y * s, v.z * s}; }
+const Vector3 operator*(float s, const Vector3& v) { return {s * v.x, s * v.y, s * v.z}; }
+const Vector3 operator/(const Vector3& v, float s) { return {v.x / s, v.y / s, v.z / s}; }
+
+const Vector3 Vector3Zero() { return {0.0f, 0.0f, 0.0f}; }
+
+bool Equal(const Vector3& v1, const Vector3& v2) { return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z; }
+
+float Length(const Vector3& v) { return std::sqrt(Dot(v, v)); }
+
+Vector3& Normalize(Vector3& v) {
+	const float length = Length(v);
+	if (length != 0.0f) {
+		v /= length;
+	}
+	return v;
+}
+
+float Dot(const Vector3& v1, const Vector3& v2) { return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
+
+Vector3 Cross(const Vector3& v1, const Vector3& v2) { return {v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x}; }
+
+const Vector4 Vector4Zero() { return {0.0f, 0.0f, 0.0f, 0.0f}; }
+
+Matrix4x4& operator*=(Matrix4x4& lhm, const Matrix4x4& rhm) {
+	lhm = lhm * rhm;
+	return lhm;
+}
+
+Matrix4x4 MakeIdentityMatrix() {
+	return {
+	    {{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}}
+    };
+}
+
+Matrix4x4 Transpose(const Matrix4x4& m) {
+	Matrix4x4 result;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m.m[j][i];
+		}
+	}
+	return result;
+}
+
+Matrix4x4 Inverse(const Matrix4x4& m, float* det) {
+	// 余因子展開
+	const float(&a)[4][4] = m.m;
+	float inv[16];
+	inv[0] = a[1][1] * a[2][2] * a[3][3] - a[1][1] * a[2][3] * a[3][2] - a[2][1] * a[1][2] * a[3][3] + a[2][1] * a[1][3] * a[3][2] + a[3][1] * a[1][2] * a[2][3] - a[3][1] * a[1][3] * a[2][2];
+	inv[4] = -a[1][0] * a[2][2] * a[3][3] + a[1][0] * a[2][3] * a[3][2] + a[2][0] * a[1][2] * a[3][3] - a[2][0] * a[1][3] * a[3][2] - a[3][0] * a[1][2] * a[2][3] + a[3][0] * a[1][3] * a[2][2];
+	inv[8] = a[1][0] * a[2][1] * a[3][3] - a[1][0] * a[2][3] * a[3][1] - a[2][0] * a[1][1] * a[3][3] + a[2][0] * a[1][3] * a[3][1] + a[3][0] * a[1][1] * a[2][3] - a[3][0] * a[1][3] * a[2][1];
+	inv[12] = -a[1][0] * a[2][1] * a[3][2] + a[1][0] * a[2][2] * a[3][1] + a[2][0] * a[1][1] * a[3][2] - a[2][0] * a[1][2] * a[3][1] - a[3][0] * a[1][1] * a[2][2] + a[3][0] * a[1][2] * a[2][1];
+	inv[1] = -a[0][1] * a[2][2] * a[3][3] + a[0][1] * a[2][3] * a[3][2] + a[2][1] * a[0][2] * a[3][3] - a[2][1] * a[0][3] * a[3][2] - a[3][1] * a[0][2] * a[2][3] + a[3][1] * a[0][3] * a[2][2];
+	inv[5] = a[0][0] * a[2][2] * a[3][3] - a[0][0] * a[2][3] * a[3][2] - a[2][0] * a[0][2] * a[3][3] + a[2][0] * a[0][3] * a[3][2] + a[3][0] * a[0][2] * a[2][3] - a[3][0] * a[0][3] * a[2][2];
+	inv[9] = -a[0][0] * a[2][1] * a[3][3] + a[0][0] * a[2][3] * a[3][1] + a[2][0] * a[0][1] * a[3][3] - a[2][0] * a[0][3] * a[3][1] - a[3][0] * a[0][1] * a[2][3] + a[3][0] * a[0][3] * a[2][1];
+	inv[13] = a[0][0] * a[2][1] * a[3][2] - a[0][0] * a[2][2] * a[3][1] - a[2][0] * a[0][1] * a[3][2] + a[2][0] * a[0][2] * a[3][1] + a[3][0] * a[0][1] * a[2][2] - a[3][0] * a[0][2] * a[2][1];
+	inv[2] = a[0][1] * a[1][2] * a[3][3] - a[0][1] * a[1][3] * a[3][2] - a[1][1] * a[0][2] * a[3][3] + a[1][1] * a[0][3] * a[3][2] + a[3][1] * a[0][2] * a[1][3] - a[3][1] * a[0][3] * a[1][2];
+	inv[6] = -a[0][0] * a[1][2] * a[3][3] + a[0][0] * a[1][3] * a[3][2] + a[1][0] * a[0][2] * a[3][3] - a[1][0] * a[0][3] * a[3][2] - a[3][0] * a[0][2] * a[1][3] + a[3][0] * a[0][3] * a[1][2];
+	inv[10] = a[0][0] * a[1][1] * a[3][3] - a[0][0] * a[1][3] * a[3][1] - a[1][0] * a[0][1] * a[3][3] + a[1][0] * a[0][3] * a[3][1] + a[3][0] * a[0][1] * a[1][3] - a[3][0] * a[0][3] * a[1][1];
+	inv[14] = -a[0][0] * a[1][1] * a[3][2] + a[0][0] * a[1][2] * a[3][1] + a[1][0] * a[0][1] * a[3][2] - a[1][0] * a[0][2] * a[3][1] - a[3][0] * a[0][1] * a[1][2] + a[3][0] * a[0][2] * a[1][1];
+	inv[3] = -a[0][1] * a[1][2] * a[2][3] + a[0][1] * a[1][3] * a[2][2] + a[1][1] * a[0][2] * a[2][3] - a[1][1] * a[0][3] * a[2][2] - a[2][1] * a[0][2] * a[1][3] + a[2][1] * a[0][3] * a[1][2];
+	inv[7] = a[0][0] * a[1][2] * a[2][3] - a[0][0] * a[1][3] * a[2][2] - a[1][0] * a[0][2] * a[2][3] + a[1][0] * a[0][3] * a[2][2] + a[2][0] * a[0][2] * a[1][3] - a[2][0] * a[0][3] * a[1][2];
+	inv[11] = -a[0][0] * a[1][1] * a[2][3] + a[0][0] * a[1][3] * a[2][1] + a[1][0] * a[0][1] * a[2][3] - a[1][0] * a[0][3] * a[2][1] - a[2][0] * a[0][1] * a[1][3] + a[2][0] * a[0][3] * a[1][1];
+	inv[15] = a[0][0] * a[1][1] * a[2][2] - a[0][0] * a[1][2] * a[2][1] - a[1][0] * a[0][1] * a[2][2] + a[1][0] * a[0][2] * a[2][1] + a[2][0] * a[0][1] * a[1][2] - a[2][0] * a[0][2] * a[1][1];
+
+	const float determinant = a[0][0] * inv[0] + a[0][1] * inv[4] + a[0][2] * inv[8] + a[0][3] * inv[12];
+	if (det) {
+		*det = determinant;
+	}
+	Matrix4x4 result;
+	const float invDet = 1.0f / determinant;
+	for (int i = 0; i < 16; ++i) {
+		result.m[i / 4][i % 4] = inv[i] * invDet;
+	}
+	return result;
+}
+
+Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
+	return {
+	    {{scale.x, 0.0f, 0.0f, 0.0f}, {0.0f, scale.y, 0.0f, 0.0f}, {0.0f, 0.0f, scale.z, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}}
+    };
+}
+
+Matrix4x4 MakeRotateXMatrix(float angle) {
+	const float s = std::sin(angle);
+	const float c = std::cos(angle);
+	return {
+	    {{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, c, s, 0.0f}, {0.0f, -s, c, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}}
+    };
+}
+
+Matrix4x4 MakeRotateYMatrix(float angle) {
+	const float s = std::sin(angle);
+	const float c = std::cos(angle);
+	return {
+	    {{c, 0.0f, -s, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {s, 0.0f, c, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}}
+    };
+}
+
+Matrix4x4 MakeRotateZMatrix(float angle) {
+	const float s = std::sin(angle);
+	const float c = std::cos(angle);
+	return {
+	    {{c, s, 0.0f, 0.0f}, {-s, c, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}}
+    };
+}
+
+Matrix4x4 MakeTranslateMatrix(const Vector2& translate) { return MakeTranslateMatrix(Vector3{translate.x, translate.y, 0.0f}); }
+
+Matrix4x4 MakeTranslateMatrix(const Vector3& translate) {
+	return {
+	    {{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f}, {translate.x, translate.y, translate.z, 1.0f}}
+    };
+}
+
+Matrix4x4 Matrix4LookAtLH(const Vector3& eye, const Vector3& target, const Vector3& up) {
+	Vector3 zAxis = target - eye;
+	Normalize(zAxis);
+	Vector3 xAxis = Cross(up, zAxis);
+	Normalize(xAxis);
+	const Vector3 yAxis = Cross(zAxis, xAxis);
+	return {
+	    {{xAxis.x, yAxis.x, zAxis.x, 0.0f},
+	     {xAxis.y, yAxis.y, zAxis.y, 0.0f},
+	     {xAxis.z, yAxis.z, zAxis.z, 0.0f},
+	     {-Dot(xAxis, eye), -Dot(yAxis, eye), -Dot(zAxis, eye), 1.0f}}
+    };
+}
+
+Matrix4x4 MakeOrthographicMatrix(float left, float top, float right, float bottom, float nearClip, float farClip) {
+	return {
+	    {{2.0f / (right - left), 0.0f, 0.0f, 0.0f},
+	     {0.0f, 2.0f / (top - bottom), 0.0f, 0.0f},
+	     {0.0f, 0.0f, 1.0f / (farClip - nearClip), 0.0f},
+	     {(left + right) / (left - right), (top + bottom) / (bottom - top), nearClip / (nearClip - farClip), 1.0f}}
+    };
+}
+
+Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip) {
+	const float scaleY = 1.0f / std::tan(fovY * 0.5f);
+	return {
+	    {{scaleY / aspectRatio, 0.0f, 0.0f, 0.0f},
+	     {0.0f, scaleY, 0.0f, 0.0f},
+	     {0.0f, 0.0f, farClip / (farClip - nearClip), 1.0f},
+	     {0.0f, 0.0f, -nearClip * farClip / (farClip - nearClip), 0.0f}}
+    };
+}
+
+Vector3 Transform(const Vector3& v, const Matrix4x4& m) {
+	return {
+	    v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + m.m[3][0],
+	    v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + m.m[3][1],
+	    v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + m.m[3][2],
+	};
+}
+
+Vector3 TransformCoord(const Vector3& v, const Matrix4x4& m) {
+	const float w = v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + m.m[3][3];
+	const Vector3 result = Transform(v, m);
+	return {result.x / w, result.y / w, result.z / w};
+}
+
+Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m) {
+	return {
+	    v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0],
+	    v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1],
+	    v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2],
+	};
+}
+
+Matrix4x4 operator*(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] + m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
+		}
+	}
+	return result;
+}
+
+Vector3 operator*(const Vector3& v, const Matrix4x4& m) { return Transform(v, m); }
+
+float Lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
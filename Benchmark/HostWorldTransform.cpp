@@ -0,0 +1,14 @@
+// Host/3d/WorldTransform.h の実装（定数バッファを持たないので転送は回数を数えるだけ）
+#include "3d/WorldTransform.h"
+
+namespace KamataEngine {
+
+void WorldTransform::Initialize() {}
+
+void WorldTransform::CreateConstBuffer() {}
+
+void WorldTransform::Map() {}
+
+void WorldTransform::TransferMatrix() { ++transferCount_; }
+
+} // namespace KamataEngine
@@ -0,0 +1,322 @@
+#include "MathBenchmarks.h"
+#include "math/AffineMatrix.h"
+#include "math/FastMath.h"
+#include "math/MathUtility.h"
+#include "math/MathUtilityBatch.h"
+#include "math/Matrix4x4A.h"
+#include "math/SimdSupport.h"
+#include "math/Spline.h"
+#include "math/TweenSystem.h"
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace KamataEngine;
+using namespace KamataEngine::MathUtility;
+
+namespace Benchmark {
+
+namespace {
+
+// 1フレームで更新するオブジェクト数程度
+constexpr size_t kMatrixBatch = 1024;
+// 1メッシュの頂点数程度
+constexpr size_t kVectorBatch = 16384;
+
+/// <summary>
+/// 計測用の入出力データ（すべての計測で共有する）
+/// </summary>
+struct Data {
+	std::vector<Matrix4x4> matrices;
+	std::vector<Matrix4x4> otherMatrices;
+	std::vector<Matrix4x4> resultMatrices;
+	std::vector<Matrix4x4A> alignedMatrices;
+	std::vector<Matrix4x4A> otherAlignedMatrices;
+	std::vector<Matrix4x4A> resultAlignedMatrices;
+	std::vector<Vector3> vectors;
+	std::vector<Vector3> otherVectors;
+	std::vector<Vector3> resultVectors;
+	std::vector<float> angles;
+	std::vector<float> positives;
+	std::vector<float> sines;
+	std::vector<float> cosines;
+	std::vector<float> parameters;
+	std::vector<float> distances;
+	Matrix4x4 matrix;
+	Spline spline;
+};
+
+std::shared_ptr<Data> MakeData() {
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+	std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+	auto randomVector = [&] { return Vector3{position(rng), position(rng), position(rng)}; };
+	auto randomAffine = [&] { return MakeAffineMatrix({scale(rng), scale(rng), scale(rng)}, {angle(rng), angle(rng), angle(rng)}, randomVector()); };
+
+	auto data = std::make_shared<Data>();
+	for (size_t i = 0; i < kMatrixBatch; ++i) {
+		data->matrices.push_back(randomAffine());
+		data->otherMatrices.push_back(randomAffine());
+		data->alignedMatrices.emplace_back(data->matrices.back());
+		data->otherAlignedMatrices.emplace_back(data->otherMatrices.back());
+	}
+	data->resultMatrices.resize(kMatrixBatch);
+	data->resultAlignedMatrices.resize(kMatrixBatch);
+	for (size_t i = 0; i < kVectorBatch; ++i) {
+		data->vectors.push_back(randomVector());
+		data->otherVectors.push_back(randomVector());
+		data->angles.push_back(angle(rng));
+		data->positives.push_back(scale(rng));
+	}
+	data->resultVectors.resize(kVectorBatch);
+	data->sines.resize(kVectorBatch);
+	data->cosines.resize(kVectorBatch);
+	data->matrix = MakePerspectiveFovMatrix(0.785f, 16.0f / 9.0f, 0.1f, 1000.0f) * randomAffine();
+
+	// カメラレール程度の制御点数
+	std::vector<Vector3> controlPoints;
+	for (size_t i = 0; i < 64; ++i) {
+		controlPoints.push_back(randomVector());
+	}
+	data->spline.SetCatmullRom(controlPoints);
+	data->spline.BuildArcLengthTable();
+	std::uniform_real_distribution<float> parameter(0.0f, 1.0f);
+	std::uniform_real_distribution<float> distance(0.0f, data->spline.GetLength());
+	for (size_t i = 0; i < kVectorBatch; ++i) {
+		data->parameters.push_back(parameter(rng));
+		data->distances.push_back(distance(rng));
+	}
+	return data;
+}
+
+} // namespace
+
+void RegisterMathBenchmarks(Registry& registry) {
+	// 各計測は共有データを保持し、参照で使う
+	const std::shared_ptr<Data> data = MakeData();
+
+#pragma region 行列
+
+	registry.Add("MathUtility::operator*(Matrix4x4)", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			d.resultMatrices[i] = d.matrices[i] * d.otherMatrices[i];
+		}
+		DoNotOptimize(d.resultMatrices.front());
+	});
+	AddPerSimdLevel(registry, "MathUtility::operator*(Matrix4x4A)", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			d.resultAlignedMatrices[i] = d.alignedMatrices[i] * d.otherAlignedMatrices[i];
+		}
+		DoNotOptimize(d.resultAlignedMatrices.front());
+	});
+	AddPerSimdLevel(registry, "MathUtility::Multiply(span<Matrix4x4A>)", kMatrixBatch, [data, &d = *data] {
+		Multiply(d.alignedMatrices, d.otherAlignedMatrices.front(), d.resultAlignedMatrices);
+		DoNotOptimize(d.resultAlignedMatrices.front());
+	});
+
+	registry.Add("MathUtility::Inverse(Matrix4x4)", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			d.resultMatrices[i] = Inverse(d.matrices[i]);
+		}
+		DoNotOptimize(d.resultMatrices.front());
+	});
+	AddPerSimdLevel(registry, "MathUtility::Inverse(Matrix4x4A)", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			d.resultAlignedMatrices[i] = Inverse(d.alignedMatrices[i]);
+		}
+		DoNotOptimize(d.resultAlignedMatrices.front());
+	});
+	registry.Add("MathUtility::InverseAffine", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			d.resultMatrices[i] = InverseAffine(d.matrices[i]);
+		}
+		DoNotOptimize(d.resultMatrices.front());
+	});
+
+#pragma endregion
+
+#pragma region 行列の作成
+
+	registry.Add("MathUtility::MakeRotateXMatrix", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			d.resultMatrices[i] = MakeRotateXMatrix(d.angles[i]);
+		}
+		DoNotOptimize(d.resultMatrices.front());
+	});
+	registry.Add("MathUtility::MakeRotateYMatrix", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			d.resultMatrices[i] = MakeRotateYMatrix(d.angles[i]);
+		}
+		DoNotOptimize(d.resultMatrices.front());
+	});
+	registry.Add("MathUtility::MakeRotateZMatrix", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			d.resultMatrices[i] = MakeRotateZMatrix(d.angles[i]);
+		}
+		DoNotOptimize(d.resultMatrices.front());
+	});
+	registry.Add("MathUtility::FastMakeRotateXMatrix", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			d.resultMatrices[i] = FastMakeRotateXMatrix(d.angles[i]);
+		}
+		DoNotOptimize(d.resultMatrices.front());
+	});
+	registry.Add("MathUtility::MakeRotateXYZ(Rx*Ry*Rz)", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			const Vector3& r = d.vectors[i];
+			d.resultMatrices[i] = MakeRotateXMatrix(r.x) * MakeRotateYMatrix(r.y) * MakeRotateZMatrix(r.z);
+		}
+		DoNotOptimize(d.resultMatrices.front());
+	});
+	registry.Add("MathUtility::MakeAffine(S*Rx*Ry*Rz*T)", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			const Vector3& r = d.vectors[i];
+			d.resultMatrices[i] = MakeScaleMatrix(d.otherVectors[i]) * MakeRotateXMatrix(r.x) * MakeRotateYMatrix(r.y) * MakeRotateZMatrix(r.z) * MakeTranslateMatrix(r);
+		}
+		DoNotOptimize(d.resultMatrices.front());
+	});
+	registry.Add("MathUtility::MakeAffineMatrix", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			d.resultMatrices[i] = MakeAffineMatrix(d.otherVectors[i], d.vectors[i], d.vectors[i]);
+		}
+		DoNotOptimize(d.resultMatrices.front());
+	});
+	registry.Add("MathUtility::Matrix4LookAtLH", kMatrixBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kMatrixBatch; ++i) {
+			d.resultMatrices[i] = Matrix4LookAtLH(d.vectors[i], d.otherVectors[i], {0.0f, 1.0f, 0.0f});
+		}
+		DoNotOptimize(d.resultMatrices.front());
+	});
+
+#pragma endregion
+
+#pragma region ベクトル
+
+	registry.Add("MathUtility::Transform", kVectorBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kVectorBatch; ++i) {
+			d.resultVectors[i] = Transform(d.vectors[i], d.matrix);
+		}
+		DoNotOptimize(d.resultVectors.front());
+	});
+	registry.Add("MathUtility::TransformCoord", kVectorBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kVectorBatch; ++i) {
+			d.resultVectors[i] = TransformCoord(d.vectors[i], d.matrix);
+		}
+		DoNotOptimize(d.resultVectors.front());
+	});
+	registry.Add("MathUtility::TransformNormal", kVectorBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kVectorBatch; ++i) {
+			d.resultVectors[i] = TransformNormal(d.vectors[i], d.matrix);
+		}
+		DoNotOptimize(d.resultVectors.front());
+	});
+	AddPerSimdLevel(registry, "MathUtility::Transform(span)", kVectorBatch, [data, &d = *data] {
+		Transform(d.vectors, d.matrix, d.resultVectors);
+		DoNotOptimize(d.resultVectors.front());
+	});
+	AddPerSimdLevel(registry, "MathUtility::TransformCoord(span)", kVectorBatch, [data, &d = *data] {
+		TransformCoord(d.vectors, d.matrix, d.resultVectors);
+		DoNotOptimize(d.resultVectors.front());
+	});
+	AddPerSimdLevel(registry, "MathUtility::TransformNormal(span)", kVectorBatch, [data, &d = *data] {
+		TransformNormal(d.vectors, d.matrix, d.resultVectors);
+		DoNotOptimize(d.resultVectors.front());
+	});
+	registry.Add("MathUtility::Normalize", kVectorBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kVectorBatch; ++i) {
+			d.resultVectors[i] = d.vectors[i];
+			Normalize(d.resultVectors[i]);
+		}
+		DoNotOptimize(d.resultVectors.front());
+	});
+	registry.Add("MathUtility::FastNormalize", kVectorBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kVectorBatch; ++i) {
+			d.resultVectors[i] = d.vectors[i];
+			FastNormalize(d.resultVectors[i]);
+		}
+		DoNotOptimize(d.resultVectors.front());
+	});
+	AddPerSimdLevel(registry, "MathUtility::FastNormalize(span)", kVectorBatch, [data, &d = *data] {
+		FastNormalize(d.vectors, d.resultVectors);
+		DoNotOptimize(d.resultVectors.front());
+	});
+	registry.Add("MathUtility::Cross", kVectorBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kVectorBatch; ++i) {
+			d.resultVectors[i] = Cross(d.vectors[i], d.otherVectors[i]);
+		}
+		DoNotOptimize(d.resultVectors.front());
+	});
+
+#pragma endregion
+
+#pragma region 三角関数
+
+	registry.Add("std::sin+std::cos", kVectorBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kVectorBatch; ++i) {
+			d.sines[i] = std::sin(d.angles[i]);
+			d.cosines[i] = std::cos(d.angles[i]);
+		}
+		DoNotOptimize(d.sines.front());
+		DoNotOptimize(d.cosines.front());
+	});
+	registry.Add("MathUtility::FastSinCos", kVectorBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kVectorBatch; ++i) {
+			FastSinCos(d.angles[i], d.sines[i], d.cosines[i]);
+		}
+		DoNotOptimize(d.sines.front());
+		DoNotOptimize(d.cosines.front());
+	});
+	for (FastMathPrecision precision : {FastMathPrecision::kHigh, FastMathPrecision::kLow}) {
+		const std::string suffix = precision == FastMathPrecision::kHigh ? "(span,high)" : "(span,low)";
+		AddPerSimdLevel(registry, "MathUtility::FastSinCos" + suffix, kVectorBatch, [data, &d = *data, precision] {
+			FastSinCos(d.angles, d.sines, d.cosines, precision);
+			DoNotOptimize(d.sines.front());
+			DoNotOptimize(d.cosines.front());
+		});
+		AddPerSimdLevel(registry, "MathUtility::FastRsqrt" + suffix, kVectorBatch, [data, &d = *data, precision] {
+			FastRsqrt(d.positives, d.sines, precision);
+			DoNotOptimize(d.sines.front());
+		});
+	}
+
+#pragma endregion
+
+#pragma region スプライン
+
+	registry.Add("Spline::Evaluate(span)", kVectorBatch, [data, &d = *data] {
+		d.spline.Evaluate(d.parameters, d.resultVectors);
+		DoNotOptimize(d.resultVectors.front());
+	});
+	registry.Add("Spline::EvaluateAtDistance(span)", kVectorBatch, [data, &d = *data] {
+		d.spline.EvaluateAtDistance(d.distances, d.resultVectors);
+		DoNotOptimize(d.resultVectors.front());
+	});
+	registry.Add("Spline::EvaluateFrameAtDistance", kVectorBatch, [data, &d = *data] {
+		for (size_t i = 0; i < kVectorBatch; ++i) {
+			d.resultVectors[i] = d.spline.EvaluateFrameAtDistance(d.distances[i]).tangent;
+		}
+		DoNotOptimize(d.resultVectors.front());
+	});
+
+#pragma endregion
+
+#pragma region トゥイーン
+
+	// UI / エフェクトで同時に動く数程度（終わらないよう長い時間にしておく）
+	constexpr size_t kTweenCount = 10000;
+	auto tweens = std::make_shared<TweenSystem>();
+	tweens->Reserve(kTweenCount);
+	for (size_t i = 0; i < kTweenCount; ++i) {
+		tweens->Play(&data->resultVectors[i], data->vectors[i], data->otherVectors[i], 1.0e6f, static_cast<EaseType>(i % static_cast<size_t>(EaseType::kCount)));
+	}
+	AddPerSimdLevel(registry, "TweenSystem::Update", kTweenCount, [data, tweens] {
+		tweens->Update(1.0f / 60.0f);
+		DoNotOptimize(data->resultVectors.front());
+	});
+
+#pragma endregion
+}
+
+} // namespace Benchmark
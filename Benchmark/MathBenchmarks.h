@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Benchmark {
+
+// math モジュールの計測対象を登録
+void RegisterMathBenchmarks(Registry& registry);
+
+} // namespace Benchmark
@@ -0,0 +1,166 @@
+#include "ObjBenchmarks.h"
+#include "3d/ObjParser.h"
+#include "base/JobSystem.h"
+#include "base/ThreadPool.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace KamataEngine;
+
+namespace Benchmark {
+
+namespace {
+
+// 格子の分割数（三角形の面が 2 * kGridSize * kGridSize 個）
+constexpr size_t kGridSize = 1024;
+constexpr size_t kFaceCount = 2 * kGridSize * kGridSize;
+
+// 実行中のプロセス ID
+long long CurrentProcessId() {
+#ifdef _WIN32
+	return _getpid();
+#else
+	return getpid();
+#endif
+}
+
+/// <summary>
+/// 計測用の OBJ ファイル（最初の計測時に一時ディレクトリへ書き出し、破棄時に消す）
+/// </summary>
+struct GridFile {
+	std::filesystem::path path;
+	std::once_flag written;
+
+	~GridFile() {
+		if (!path.empty()) {
+			std::error_code error;
+			std::filesystem::remove(path, error);
+		}
+	}
+
+	const std::filesystem::path& Get() {
+		std::call_once(written, [this] { Write(); });
+		return path;
+	}
+
+	// 起伏のある格子を v / vt / vn / f で書き出す
+	void Write() {
+		// 同時に動く別のプロセス（ctest と手動の実行など）と同じファイルを使わないよう、プロセス ID を付ける
+		path = std::filesystem::temp_directory_path() / ("novice_benchmark_grid_" + std::to_string(CurrentProcessId()) + ".obj");
+		std::ofstream file(path, std::ios::binary);
+		file << "mtllib grid.mtl\no grid\n";
+		char line[128];
+		for (size_t z = 0; z <= kGridSize; ++z) {
+			for (size_t x = 0; x <= kGridSize; ++x) {
+				const float height = static_cast<float>((x * 7 + z * 13) % 31) * 0.03125f;
+				file.write(line, std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", static_cast<float>(x) * 0.1f, height, static_cast<float>(z) * 0.1f));
+			}
+		}
+		for (size_t z = 0; z <= kGridSize; ++z) {
+			for (size_t x = 0; x <= kGridSize; ++x) {
+				file.write(line, std::snprintf(line, sizeof(line), "vt %.6f %.6f\n", static_cast<float>(x) / kGridSize, static_cast<float>(z) / kGridSize));
+			}
+		}
+		file << "vn 0.000000 1.000000 0.000000\nusemtl ground\n";
+		for (size_t z = 0; z < kGridSize; ++z) {
+			for (size_t x = 0; x < kGridSize; ++x) {
+				const size_t a = z * (kGridSize + 1) + x + 1;
+				const size_t b = a + 1;
+				const size_t c = a + kGridSize + 1;
+				const size_t d = c + 1;
+				file.write(line, std::snprintf(line, sizeof(line), "f %zu/%zu/1 %zu/%zu/1 %zu/%zu/1\n", a, a, c, c, b, b));
+				file.write(line, std::snprintf(line, sizeof(line), "f %zu/%zu/1 %zu/%zu/1 %zu/%zu/1\n", b, b, c, c, d, d));
+			}
+		}
+	}
+};
+
+// Model::LoadModel と同じく、1行ずつ std::string に読み込んで istringstream で分解する従来の解析
+void LoadWithStream(const std::filesystem::path& path, ObjModelData& model) {
+	model = {};
+	std::vector<Vector3> positions;
+	std::vector<Vector3> normals;
+	std::vector<Vector2> texcoords;
+	std::ifstream file(path);
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream lineStream(line);
+		std::string key;
+		std::getline(lineStream, key, ' ');
+		if (key == "mtllib") {
+			std::string filename;
+			lineStream >> filename;
+			model.materialLibraries.push_back(filename);
+		} else if (key == "o") {
+			model.meshes.emplace_back();
+			lineStream >> model.meshes.back().name;
+		} else if (key == "v") {
+			Vector3 position{};
+			lineStream >> position.x >> position.y >> position.z;
+			positions.push_back(position);
+		} else if (key == "vt") {
+			Vector2 texcoord{};
+			lineStream >> texcoord.x >> texcoord.y;
+			texcoord.y = 1.0f - texcoord.y;
+			texcoords.push_back(texcoord);
+		} else if (key == "vn") {
+			Vector3 normal{};
+			lineStream >> normal.x >> normal.y >> normal.z;
+			normals.push_back(normal);
+		} else if (key == "usemtl") {
+			lineStream >> model.meshes.back().material;
+		} else if (key == "f") {
+			ObjMesh& mesh = model.meshes.back();
+			const uint32_t first = static_cast<uint32_t>(mesh.vertices.size());
+			uint32_t cornerCount = 0;
+			std::string indexString;
+			while (std::getline(lineStream, indexString, ' ')) {
+				std::istringstream indexStream(indexString);
+				uint32_t indexPosition = 0, indexTexcoord = 0, indexNormal = 0;
+				indexStream >> indexPosition;
+				indexStream.seekg(1, std::ios_base::cur);
+				indexStream >> indexTexcoord;
+				indexStream.seekg(1, std::ios_base::cur);
+				indexStream >> indexNormal;
+				mesh.vertices.push_back({positions[indexPosition - 1], normals[indexNormal - 1], texcoords[indexTexcoord - 1]});
+				if (++cornerCount >= 3) {
+					mesh.indices.push_back(first);
+					mesh.indices.push_back(first + cornerCount - 2);
+					mesh.indices.push_back(first + cornerCount - 1);
+				}
+			}
+		}
+	}
+}
+
+} // namespace
+
+void RegisterObjBenchmarks(Registry& registry) {
+	// 1回に数秒かかるので標本数を抑える
+	constexpr size_t kMaxSamples = 3;
+	const std::string suffix = "(faces=" + std::to_string(kFaceCount) + ")";
+	auto file = std::make_shared<GridFile>();
+	auto model = std::make_shared<ObjModelData>();
+
+	registry.Add("OBJ istringstream" + suffix, kFaceCount, [file, model] { LoadWithStream(file->Get(), *model); }, kMaxSamples);
+	registry.Add("ObjParser::Load" + suffix, kFaceCount, [file, model] { DoNotOptimize(ObjParser::Load(file->Get(), *model)); }, kMaxSamples);
+	auto threadPool = std::make_shared<ThreadPool>();
+	registry.Add("ObjParser::Load(ThreadPool)" + suffix, kFaceCount, [file, model, threadPool] { DoNotOptimize(ObjParser::Load(*threadPool, file->Get(), *model)); },
+	             kMaxSamples);
+	auto jobSystem = std::make_shared<JobSystem>();
+	registry.Add("ObjParser::Load(JobSystem)" + suffix, kFaceCount, [file, model, jobSystem] { DoNotOptimize(ObjParser::Load(*jobSystem, file->Get(), *model)); },
+	             kMaxSamples);
+}
+
+} // namespace Benchmark
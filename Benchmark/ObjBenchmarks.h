@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Benchmark {
+
+// OBJ の解析を、ストリームで1行ずつ読む従来の方法と比べて登録
+void RegisterObjBenchmarks(Registry& registry);
+
+} // namespace Benchmark
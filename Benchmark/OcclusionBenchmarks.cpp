@@ -0,0 +1,113 @@
+#include "OcclusionBenchmarks.h"
+#include "3d/OcclusionBuffer.h"
+#include "base/JobSystem.h"
+#include "base/ThreadPool.h"
+#include "math/AffineMatrix.h"
+#include "math/MathUtility.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace KamataEngine;
+using namespace KamataEngine::MathUtility;
+
+namespace Benchmark {
+
+namespace {
+
+// 街並みの建物（遮蔽物）の数と、判定するオブジェクトの数
+constexpr size_t kBuildingCount = 1024;
+constexpr size_t kObjectCount = 10000;
+
+/// <summary>
+/// 計測用の街並み（建物は直方体の12三角形、オブジェクトは建物の間に置いた小さな箱）
+/// </summary>
+struct City {
+	std::vector<Vector3> points;
+	std::vector<uint32_t> indices;
+	std::vector<float> centerX, centerY, centerZ, extentX, extentY, extentZ;
+	std::vector<uint32_t> visibleIndices;
+	Matrix4x4 viewProjection;
+	OcclusionBuffer buffer;
+
+	AABBSoA GetBoxes() const {
+		return {centerX.data(), centerY.data(), centerZ.data(), extentX.data(), extentY.data(), extentZ.data(), centerX.size()};
+	}
+	void Rasterize() {
+		buffer.BeginFrame(viewProjection);
+		buffer.AddOccluder(points.data(), sizeof(Vector3), indices, MakeIdentityMatrix());
+		buffer.Rasterize();
+	}
+};
+
+std::shared_ptr<City> MakeCity() {
+	auto city = std::make_shared<City>();
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> height(5.0f, 40.0f);
+	std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+	// 32x32 の区画に建物を並べる（x, z とも -160 ～ 160）
+	constexpr uint32_t kBoxIndices[] = {0, 1, 2, 0, 2, 3, 4, 6, 5, 4, 7, 6, 0, 4, 5, 0, 5, 1, 1, 5, 6, 1, 6, 2, 2, 6, 7, 2, 7, 3, 3, 7, 4, 3, 4, 0};
+	for (size_t i = 0; i < kBuildingCount; ++i) {
+		const float x = (static_cast<float>(i % 32) - 15.5f) * 10.0f;
+		const float z = (static_cast<float>(i / 32) - 15.5f) * 10.0f;
+		const float h = height(rng);
+		const uint32_t base = static_cast<uint32_t>(city->points.size());
+		for (float y : {0.0f, h}) {
+			city->points.push_back({x - 3.0f, y, z - 3.0f});
+			city->points.push_back({x + 3.0f, y, z - 3.0f});
+			city->points.push_back({x + 3.0f, y, z + 3.0f});
+			city->points.push_back({x - 3.0f, y, z + 3.0f});
+		}
+		for (uint32_t index : kBoxIndices) {
+			city->indices.push_back(base + index);
+		}
+	}
+	std::uniform_int_distribution<int> street(0, 31);
+	for (size_t i = 0; i < kObjectCount; ++i) {
+		city->centerX.push_back((static_cast<float>(street(rng)) - 15.0f) * 10.0f + offset(rng));
+		city->centerY.push_back(1.0f);
+		city->centerZ.push_back((static_cast<float>(street(rng)) - 15.5f) * 10.0f + offset(rng) * 3.0f);
+		city->extentX.push_back(0.5f);
+		city->extentY.push_back(1.0f);
+		city->extentZ.push_back(0.5f);
+	}
+	city->visibleIndices.resize(kObjectCount);
+
+	// 街の端から通りを見下ろす視点
+	const Matrix4x4 view = InverseAffine(MakeAffineMatrix({1.0f, 1.0f, 1.0f}, {0.2f, 0.3f, 0.0f}, {-150.0f, 8.0f, -170.0f}));
+	city->viewProjection = view * MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.1f, 1000.0f);
+	city->buffer.Initialize();
+	city->Rasterize();
+	return city;
+}
+
+} // namespace
+
+void RegisterOcclusionBenchmarks(Registry& registry) {
+	const std::shared_ptr<City> city = MakeCity();
+	const size_t triangleCount = city->indices.size() / 3;
+
+	AddPerSimdLevel(registry, "OcclusionBuffer::Rasterize(triangles=12288)", triangleCount, [city] { city->Rasterize(); });
+	auto threadPool = std::make_shared<ThreadPool>();
+	registry.Add("OcclusionBuffer::Rasterize(ThreadPool,triangles=12288)", triangleCount, [city, threadPool] {
+		city->buffer.BeginFrame(city->viewProjection);
+		city->buffer.AddOccluder(city->points.data(), sizeof(Vector3), city->indices, MakeIdentityMatrix());
+		city->buffer.Rasterize(*threadPool);
+	});
+	auto jobSystem = std::make_shared<JobSystem>();
+	registry.Add("OcclusionBuffer::Rasterize(JobSystem,triangles=12288)", triangleCount, [city, jobSystem] {
+		city->buffer.BeginFrame(city->viewProjection);
+		city->buffer.AddOccluder(city->points.data(), sizeof(Vector3), city->indices, MakeIdentityMatrix());
+		city->buffer.Rasterize(*jobSystem);
+	});
+
+	registry.Add("OcclusionBuffer::CullAABBs(10000)", kObjectCount, [city] { DoNotOptimize(city->buffer.CullAABBs(city->GetBoxes(), city->visibleIndices)); });
+	registry.Add("OcclusionBuffer::CullAABBs(ThreadPool,10000)", kObjectCount,
+	             [city, threadPool] { DoNotOptimize(city->buffer.CullAABBs(*threadPool, city->GetBoxes(), city->visibleIndices)); });
+	registry.Add("OcclusionBuffer::CullAABBs(JobSystem,10000)", kObjectCount,
+	             [city, jobSystem] { DoNotOptimize(city->buffer.CullAABBs(*jobSystem, city->GetBoxes(), city->visibleIndices)); });
+}
+
+} // namespace Benchmark
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Benchmark {
+
+// OcclusionBuffer の遮蔽物の描画と境界ボックスの判定を登録
+void RegisterOcclusionBenchmarks(Registry& registry);
+
+} // namespace Benchmark
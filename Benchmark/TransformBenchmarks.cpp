@@ -0,0 +1,65 @@
+#include "TransformBenchmarks.h"
+#include "3d/TransformHierarchy.h"
+#include "base/JobSystem.h"
+#include "base/ThreadPool.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace KamataEngine;
+
+namespace Benchmark {
+
+namespace {
+
+// 子の数
+constexpr uint32_t kBranching = 8;
+
+// ルート 1 つから幅優先で子を kBranching 個ずつ持つ木を作る
+std::unique_ptr<TransformHierarchy> MakeHierarchy(size_t nodeCount) {
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+	auto hierarchy = std::make_unique<TransformHierarchy>();
+	std::vector<uint32_t> nodes;
+	nodes.reserve(nodeCount);
+	for (size_t i = 0; i < nodeCount; ++i) {
+		const uint32_t parent = i == 0 ? TransformHierarchy::kInvalidNode : nodes[(i - 1) / kBranching];
+		const uint32_t node = hierarchy->Create(parent);
+		hierarchy->SetRotation(node, {value(rng), value(rng), value(rng)});
+		hierarchy->SetTranslation(node, {value(rng), value(rng), value(rng)});
+		nodes.push_back(node);
+	}
+	hierarchy->Update();
+	return hierarchy;
+}
+
+} // namespace
+
+void RegisterTransformBenchmarks(Registry& registry) {
+	for (size_t nodeCount : {size_t{10000}, size_t{100000}, size_t{1000000}}) {
+		auto hierarchy = std::make_shared<Lazy<TransformHierarchy>>([nodeCount] { return MakeHierarchy(nodeCount); });
+		const uint32_t root = 0;
+		registry.Add("TransformHierarchy::Update(" + std::to_string(nodeCount) + ")", nodeCount, [hierarchy, root] {
+			// ルートを変更して全ノードを計算し直させる
+			hierarchy->Get().MarkDirty(root);
+			hierarchy->Get().Update();
+		});
+		for (size_t threadCount : GetThreadCounts()) {
+			auto threadPool = std::make_shared<Lazy<ThreadPool>>([threadCount] { return std::make_unique<ThreadPool>(threadCount - 1); });
+			registry.Add("TransformHierarchy::Update(" + std::to_string(nodeCount) + ",threads=" + std::to_string(threadCount) + ")", nodeCount,
+			             [hierarchy, threadPool, root] {
+				             hierarchy->Get().MarkDirty(root);
+				             hierarchy->Get().Update(threadPool->Get());
+			             });
+			auto jobSystem = std::make_shared<Lazy<JobSystem>>([threadCount] { return std::make_unique<JobSystem>(threadCount - 1); });
+			registry.Add("TransformHierarchy::Update(" + std::to_string(nodeCount) + ",jobs=" + std::to_string(threadCount) + ")", nodeCount,
+			             [hierarchy, jobSystem, root] {
+				             hierarchy->Get().MarkDirty(root);
+				             hierarchy->Get().Update(jobSystem->Get());
+			             });
+		}
+	}
+}
+
+} // namespace Benchmark
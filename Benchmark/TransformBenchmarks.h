@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Benchmark {
+
+// TransformHierarchy の並列更新のスケーリングを登録
+void RegisterTransformBenchmarks(Registry& registry);
+
+} // namespace Benchmark
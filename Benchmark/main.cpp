@@ -0,0 +1,82 @@
+#include "Benchmark.h"
+#include "Checks.h"
+#include "EntityBenchmarks.h"
+#include "MathBenchmarks.h"
+#include "ObjBenchmarks.h"
+#include "OcclusionBenchmarks.h"
+#include "TransformBenchmarks.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+void PrintUsage(const char* program) {
+	std::cout << "usage: " << program << " [--check] [--filter <text>] [--samples <n>] [--min-time <seconds>] [--json <path|->]\n"
+	          << "  --check     run only the self-checks (they also run before every benchmark run)\n"
+	          << "  --filter    run only benchmarks whose name contains <text>\n"
+	          << "  --samples   number of timed samples per benchmark (default 20)\n"
+	          << "  --min-time  minimum duration of one sample in seconds (default 0.005)\n"
+	          << "  --json      write results as JSON to <path> ('-' for stdout)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	Benchmark::Options options;
+	const char* jsonPath = nullptr;
+	bool checkOnly = false;
+	for (int i = 1; i < argc; ++i) {
+		const bool hasValue = i + 1 < argc;
+		if (std::strcmp(argv[i], "--check") == 0) {
+			checkOnly = true;
+		} else if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+			options.filter = argv[++i];
+		} else if (std::strcmp(argv[i], "--samples") == 0 && hasValue) {
+			options.samples = std::strtoul(argv[++i], nullptr, 10);
+		} else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue) {
+			options.minSampleSeconds = std::strtod(argv[++i], nullptr);
+		} else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+			jsonPath = argv[++i];
+		} else {
+			PrintUsage(argv[0]);
+			return std::strcmp(argv[i], "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+	if (options.samples == 0) {
+		options.samples = 1;
+	}
+
+	// 結果を JSON で標準出力に書くときは、確認の結果を標準エラーに出す
+	const bool jsonToStdout = jsonPath && std::strcmp(jsonPath, "-") == 0;
+	if (!Benchmark::RunChecks(jsonToStdout ? std::cerr : std::cout)) {
+		return EXIT_FAILURE;
+	}
+	if (checkOnly) {
+		return EXIT_SUCCESS;
+	}
+
+	Benchmark::Registry registry;
+	Benchmark::RegisterMathBenchmarks(registry);
+	Benchmark::RegisterEntityBenchmarks(registry);
+	Benchmark::RegisterOcclusionBenchmarks(registry);
+	Benchmark::RegisterObjBenchmarks(registry);
+	Benchmark::RegisterTransformBenchmarks(registry);
+	const std::vector<Benchmark::Result> results = registry.Run(options);
+
+	if (jsonToStdout) {
+		Benchmark::WriteJson(std::cout, results);
+		return EXIT_SUCCESS;
+	}
+	Benchmark::WriteTable(std::cout, results);
+	if (jsonPath) {
+		std::ofstream file(jsonPath);
+		if (!file) {
+			std::cerr << "failed to open " << jsonPath << "\n";
+			return EXIT_FAILURE;
+		}
+		Benchmark::WriteJson(file, results);
+	}
+	return EXIT_SUCCESS;
+}
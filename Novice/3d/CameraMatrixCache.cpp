@@ -0,0 +1,75 @@
+#include "3d/CameraMatrixCache.h"
+#include "3d/Camera.h"
+#include "math/AffineMatrix.h"
+#include "math/MathUtility.h"
+#include "math/MathUtilityConstexpr.h"
+#include "math/Projection.h"
+
+namespace KamataEngine {
+
+namespace {
+
+using MathUtility::Constexpr::operator*;
+
+inline bool IsEqual(const Vector3& v1, const Vector3& v2) { return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z; }
+
+// 透視投影行列の逆行列（x, y のスケールと z, w の2行だけを持つ形なので、一般の逆行列を使わずに求める。どの深度の割り当てでも m[3][2] は 0 でない）
+Matrix4x4 InversePerspective(const Matrix4x4& m) {
+	const float a = m.m[2][2];
+	const float b = m.m[3][2];
+	return {{
+	    {1.0f / m.m[0][0], 0.0f, 0.0f, 0.0f},
+	    {0.0f, 1.0f / m.m[1][1], 0.0f, 0.0f},
+	    {0.0f, 0.0f, 0.0f, 1.0f / b},
+	    {0.0f, 0.0f, 1.0f, -a / b},
+	}};
+}
+
+} // namespace
+
+CameraMatrixCache::CameraMatrixCache(Camera& camera) : camera_(&camera) {}
+
+bool CameraMatrixCache::Update() {
+	DetectChanges();
+	if (!viewDirty_ && !projectionDirty_) {
+		return false;
+	}
+
+	if (viewDirty_) {
+		// カメラのワールド行列の逆行列がビュー行列
+		inverseView_ = MathUtility::MakeAffineMatrix({1.0f, 1.0f, 1.0f}, rotation_, translation_);
+		view_ = MathUtility::InverseAffine(inverseView_);
+	}
+	if (projectionDirty_) {
+		projection_ = MathUtility::MakePerspectiveFovMatrix(fovAngleY_, aspectRatio_, nearZ_, farZ_, depthMode_);
+		inverseProjection_ = InversePerspective(projection_);
+	}
+	viewProjection_ = view_ * projection_;
+	inverseViewProjection_ = inverseProjection_ * inverseView_;
+	viewDirty_ = false;
+	projectionDirty_ = false;
+	++version_;
+
+	camera_->matView = view_;
+	camera_->matProjection = projection_;
+	camera_->TransferMatrix();
+	return true;
+}
+
+void CameraMatrixCache::DetectChanges() {
+	const Camera& camera = *camera_;
+	if (!IsEqual(rotation_, camera.rotation_) || !IsEqual(translation_, camera.translation_)) {
+		rotation_ = camera.rotation_;
+		translation_ = camera.translation_;
+		viewDirty_ = true;
+	}
+	if (fovAngleY_ != camera.fovAngleY || aspectRatio_ != camera.aspectRatio || nearZ_ != camera.nearZ || farZ_ != camera.farZ) {
+		fovAngleY_ = camera.fovAngleY;
+		aspectRatio_ = camera.aspectRatio;
+		nearZ_ = camera.nearZ;
+		farZ_ = camera.farZ;
+		projectionDirty_ = true;
+	}
+}
+
+} // namespace KamataEngine
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "math/Matrix4x4.h"
+#include "math/Projection.h"
+#include "math/Vector3.h"
+#include <cstdint>
+
+namespace KamataEngine {
+
+class Camera;
+
+/// <summary>
+/// カメラの行列のキャッシュ
+/// Update のたびにカメラの rotation_, translation_ と射影の設定を前回の値と比べ、
+/// 変わったものに関係する行列（ビュー・射影・ビュー射影とそれぞれの逆行列）だけを計算し直す。
+/// 計算し直したときはカメラの matView, matProjection に書き込んで TransferMatrix を呼ぶので、Camera::UpdateMatrix の代わりに使う。
+/// 視錐台の作成やスクリーン座標の逆変換は、毎回行列積や逆行列を求めずにここで求めた結果を使う。
+/// </summary>
+class CameraMatrixCache final {
+public:
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="camera">カメラ（このキャッシュより長く有効であること）</param>
+	explicit CameraMatrixCache(Camera& camera);
+
+	/// <summary>
+	/// 変わった行列を計算し直す
+	/// </summary>
+	/// <returns>行列が変わったか</returns>
+	bool Update();
+
+	/// <summary>
+	/// 射影の深度の割り当てを設定（無限遠の割り当てではカメラの farZ を使わない）
+	/// 逆Z にするときは深度バッファのクリア値と深度比較も合わせること（DepthMode を参照）。
+	/// </summary>
+	void SetDepthMode(DepthMode depthMode) {
+		projectionDirty_ |= depthMode_ != depthMode;
+		depthMode_ = depthMode;
+	}
+	DepthMode GetDepthMode() const { return depthMode_; }
+
+	/// <summary>
+	/// 次の Update ですべての行列を計算し直す
+	/// </summary>
+	void MarkDirty() { viewDirty_ = projectionDirty_ = true; }
+
+	/// <summary>
+	/// 行列の取得（最後の Update の結果）
+	/// </summary>
+	const Matrix4x4& GetView() const { return view_; }
+	const Matrix4x4& GetProjection() const { return projection_; }
+	const Matrix4x4& GetViewProjection() const { return viewProjection_; }
+	const Matrix4x4& GetInverseView() const { return inverseView_; }
+	const Matrix4x4& GetInverseProjection() const { return inverseProjection_; }
+	const Matrix4x4& GetInverseViewProjection() const { return inverseViewProjection_; }
+
+	/// <summary>
+	/// カメラのワールド座標を取得（ビュー行列の逆行列の平行移動成分）
+	/// </summary>
+	Vector3 GetPosition() const { return {inverseView_.m[3][0], inverseView_.m[3][1], inverseView_.m[3][2]}; }
+
+	/// <summary>
+	/// ビュー射影行列が変わるたびに増える番号（キャッシュした視錐台などが古いかの判定用）
+	/// </summary>
+	uint32_t GetVersion() const { return version_; }
+
+	/// <summary>
+	/// カメラを取得
+	/// </summary>
+	Camera& GetCamera() const { return *camera_; }
+
+private:
+	// 前回と比べてどの行列を計算し直すか決める
+	void DetectChanges();
+
+	Camera* camera_;
+
+	// 前回計算したときのカメラの値
+	Vector3 rotation_ = {};
+	Vector3 translation_ = {};
+	float fovAngleY_ = 0.0f;
+	float aspectRatio_ = 0.0f;
+	float nearZ_ = 0.0f;
+	float farZ_ = 0.0f;
+	DepthMode depthMode_ = DepthMode::kStandard;
+	bool viewDirty_ = true;
+	bool projectionDirty_ = true;
+
+	Matrix4x4 view_;
+	Matrix4x4 projection_;
+	Matrix4x4 viewProjection_;
+	Matrix4x4 inverseView_;
+	Matrix4x4 inverseProjection_;
+	Matrix4x4 inverseViewProjection_;
+	uint32_t version_ = 0;
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,52 @@
+#include "3d/CameraUtility.h"
+#include "math/MathUtility.h"
+#include "math/MathUtilityConstexpr.h"
+#include "math/Projection.h"
+#include "3d/Camera.h"
+#include "3d/CameraMatrixCache.h"
+#include "base/WinApp.h"
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+namespace {
+
+// ビュー射影行列の逆行列でスクリーン座標を通る半直線を求める
+Ray MakeScreenRay(const Matrix4x4& matInverseViewProjection, DepthMode depthMode, const Vector2& screenPosition, const Vector2& screenSize) {
+	// スクリーン座標 → 正規化デバイス座標（y は上向き）
+	const float x = screenPosition.x / screenSize.x * 2.0f - 1.0f;
+	const float y = 1.0f - screenPosition.y / screenSize.y * 2.0f;
+	return UnprojectRay(x, y, matInverseViewProjection, depthMode);
+}
+
+Vector2 GetWindowSize() { return {static_cast<float>(WinApp::kWindowWidth), static_cast<float>(WinApp::kWindowHeight)}; }
+
+} // namespace
+
+// エンジンの MathUtility::operator* と同じシグネチャなので、名前空間ではなく関数の中で Constexpr 版を選ぶ
+Frustum MakeFrustum(const Camera& camera) {
+	using Constexpr::operator*;
+	return MakeFrustum(camera.matView * camera.matProjection);
+}
+
+Ray MakeScreenRay(const Camera& camera, const Vector2& screenPosition, const Vector2& screenSize) {
+	using Constexpr::operator*;
+	return MakeScreenRay(Inverse(camera.matView * camera.matProjection), DepthMode::kStandard, screenPosition, screenSize);
+}
+
+Ray MakeScreenRay(const Camera& camera, const Vector2& screenPosition) { return MakeScreenRay(camera, screenPosition, GetWindowSize()); }
+
+Frustum MakeFrustum(const CameraMatrixCache& cameraMatrices) { return MakeFrustum(cameraMatrices.GetViewProjection(), cameraMatrices.GetDepthMode()); }
+
+Ray MakeScreenRay(const CameraMatrixCache& cameraMatrices, const Vector2& screenPosition, const Vector2& screenSize) {
+	return MakeScreenRay(cameraMatrices.GetInverseViewProjection(), cameraMatrices.GetDepthMode(), screenPosition, screenSize);
+}
+
+Ray MakeScreenRay(const CameraMatrixCache& cameraMatrices, const Vector2& screenPosition) {
+	return MakeScreenRay(cameraMatrices.GetInverseViewProjection(), cameraMatrices.GetDepthMode(), screenPosition, GetWindowSize());
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "math/Frustum.h"
+#include "math/Ray.h"
+#include "math/Vector2.h"
+
+namespace KamataEngine {
+
+class Camera;
+class CameraMatrixCache;
+
+namespace MathUtility {
+
+// カメラのビュー行列と射影行列から視錐台を作成（UpdateMatrix 済みであること。Camera の射影は標準の深度の割り当て）
+Frustum MakeFrustum(const Camera& camera);
+
+// スクリーン座標を通るワールド座標系の半直線を作成（UpdateMatrix 済みであること）
+// 始点はニアクリップ面上の点、方向は正規化済み。screenSize はビューポートの大きさ。
+Ray MakeScreenRay(const Camera& camera, const Vector2& screenPosition, const Vector2& screenSize);
+// ウィンドウ全体をビューポートとする（Input::GetMousePosition の座標をそのまま渡せる）
+Ray MakeScreenRay(const Camera& camera, const Vector2& screenPosition);
+
+// CameraMatrixCache の行列を使う版（Update 済みであること。行列積や逆行列を求め直さず、深度の割り当ても合わせる）
+Frustum MakeFrustum(const CameraMatrixCache& cameraMatrices);
+Ray MakeScreenRay(const CameraMatrixCache& cameraMatrices, const Vector2& screenPosition, const Vector2& screenSize);
+Ray MakeScreenRay(const CameraMatrixCache& cameraMatrices, const Vector2& screenPosition);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,54 @@
+#include "3d/ConstantBufferUpload.h"
+#include "3d/Camera.h"
+#include "3d/CameraMatrixCache.h"
+#include "3d/Material.h"
+#include "3d/ObjectColor.h"
+#include "3d/WorldTransform.h"
+#include "math/AffineMatrix.h"
+
+namespace KamataEngine {
+
+ConstantBufferAllocation PushConstants(ConstantBufferRing& ring, const WorldTransform& worldTransform) {
+	ConstBufferDataWorldTransform data;
+	data.matWorld = worldTransform.matWorld_;
+	return ring.Push(data);
+}
+
+ConstantBufferAllocation PushConstants(ConstantBufferRing& ring, const Camera& camera) {
+	ConstBufferDataCamera data;
+	data.view = camera.matView;
+	data.projection = camera.matProjection;
+	// ビュー行列の逆行列の平行移動成分がカメラのワールド座標
+	const Matrix4x4 cameraMatrix = MathUtility::InverseAffine(camera.matView);
+	data.cameraPos = {cameraMatrix.m[3][0], cameraMatrix.m[3][1], cameraMatrix.m[3][2]};
+	return ring.Push(data);
+}
+
+ConstantBufferAllocation PushConstants(ConstantBufferRing& ring, const CameraMatrixCache& cameraMatrices) {
+	ConstBufferDataCamera data;
+	data.view = cameraMatrices.GetView();
+	data.projection = cameraMatrices.GetProjection();
+	data.cameraPos = cameraMatrices.GetPosition();
+	return ring.Push(data);
+}
+
+ConstantBufferAllocation PushConstants(ConstantBufferRing& ring, const ObjectColor& objectColor) {
+	ConstBufferDataObjectColor data;
+	data.color_ = objectColor.GetColor();
+	return ring.Push(data);
+}
+
+ConstantBufferAllocation PushConstants(ConstantBufferRing& ring, const Material& material) {
+	Material::ConstBufferData data;
+	data.ambient = material.ambient_;
+	data.pad1 = 0.0f;
+	data.diffuse = material.diffuse_;
+	data.pad2 = 0.0f;
+	data.specular = material.specular_;
+	data.alpha = material.alpha_;
+	data.uvScale = material.uvScale_;
+	data.uvOffset = material.uvOffset_;
+	return ring.Push(data);
+}
+
+} // namespace KamataEngine
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "base/ConstantBufferRing.h"
+
+namespace KamataEngine {
+
+class Camera;
+class CameraMatrixCache;
+class Material;
+class ObjectColor;
+class WorldTransform;
+
+// エンジンのオブジェクトの定数バッファと同じ内容を ConstantBufferRing に書き込む
+// 戻り値の gpuAddress を、個別の定数バッファの代わりに SetGraphicsRootConstantBufferView に渡す。
+// 容量不足なら空の割り当てを返す。
+
+// ConstBufferDataWorldTransform（UpdateMatrix 済みの matWorld_）
+ConstantBufferAllocation PushConstants(ConstantBufferRing& ring, const WorldTransform& worldTransform);
+// ConstBufferDataCamera（UpdateMatrix 済みの matView, matProjection と、そこから求めたカメラ座標）
+ConstantBufferAllocation PushConstants(ConstantBufferRing& ring, const Camera& camera);
+// ConstBufferDataCamera（CameraMatrixCache の行列とカメラ座標をそのまま使う）
+ConstantBufferAllocation PushConstants(ConstantBufferRing& ring, const CameraMatrixCache& cameraMatrices);
+// ConstBufferDataObjectColor
+ConstantBufferAllocation PushConstants(ConstantBufferRing& ring, const ObjectColor& objectColor);
+// Material::ConstBufferData
+ConstantBufferAllocation PushConstants(ConstantBufferRing& ring, const Material& material);
+
+} // namespace KamataEngine
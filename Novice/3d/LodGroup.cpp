@@ -0,0 +1,95 @@
+#include "3d/LodGroup.h"
+#include "3d/Camera.h"
+#include "3d/CameraMatrixCache.h"
+#include "3d/Mesh.h"
+#include "3d/MeshBounds.h"
+#include "3d/Model.h"
+#include "3d/WorldTransform.h"
+#include "base/WinApp.h"
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace KamataEngine {
+
+void LodGroup::AddLevel(Model* model, float minScreenSize) {
+	assert(model);
+	assert(minScreenSize >= 0.0f);
+	assert(levels_.empty() || minScreenSize < levels_.back().minScreenSize);
+
+	uint64_t vertexCount = 0;
+	for (const std::unique_ptr<Mesh>& mesh : model->GetMeshes()) {
+		vertexCount += mesh->GetVertices().size();
+	}
+	if (levels_.empty()) {
+		localSphere_ = MathUtility::ComputeBounds(*model).sphere;
+	}
+	levels_.push_back({model, minScreenSize, vertexCount});
+}
+
+void LodGroup::SetHysteresis(float hysteresis) {
+	assert(hysteresis >= 0.0f && hysteresis < 1.0f);
+	hysteresis_ = hysteresis;
+}
+
+void LodGroup::BeginFrame(const Camera& camera, float viewportHeight) {
+	BeginFrame(camera, camera.translation_, 1.0f / std::tan(camera.fovAngleY * 0.5f), viewportHeight);
+}
+
+void LodGroup::BeginFrame(const CameraMatrixCache& cameraMatrices, float viewportHeight) {
+	// 射影行列の m[1][1] は 1 / tan(fovY / 2)（深度の割り当てによらない）
+	BeginFrame(cameraMatrices.GetCamera(), cameraMatrices.GetPosition(), cameraMatrices.GetProjection().m[1][1], viewportHeight);
+}
+
+void LodGroup::BeginFrame(const Camera& camera, const Vector3& cameraPosition, float focalLength, float viewportHeight) {
+	if (viewportHeight <= 0.0f) {
+		viewportHeight = static_cast<float>(WinApp::kWindowHeight);
+	}
+	camera_ = &camera;
+	cameraPosition_ = cameraPosition;
+	projectionScale_ = viewportHeight * focalLength;
+	stats_.instanceCounts.assign(levels_.size(), 0);
+	stats_.vertexCounts.assign(levels_.size(), 0);
+	stats_.culledCount = 0;
+}
+
+float LodGroup::GetScreenSize(const Sphere& worldSphere) const {
+	const float dx = worldSphere.center.x - cameraPosition_.x;
+	const float dy = worldSphere.center.y - cameraPosition_.y;
+	const float dz = worldSphere.center.z - cameraPosition_.z;
+	const float distanceSquared = dx * dx + dy * dy + dz * dz;
+	if (distanceSquared <= worldSphere.radius * worldSphere.radius) {
+		return std::numeric_limits<float>::infinity();
+	}
+	return worldSphere.radius * projectionScale_ / std::sqrt(distanceSquared);
+}
+
+uint32_t LodGroup::SelectLevel(float screenSize, uint32_t previousLevel) const {
+	const uint32_t levelCount = GetLevelCount();
+	uint32_t level = 0;
+	while (level < levelCount && screenSize < levels_[level].minScreenSize) {
+		++level;
+	}
+	// 粗いレベルへは、前回のレベルの閾値をヒステリシスの分だけ下回るまで切り替えない
+	if (previousLevel < level && screenSize >= levels_[previousLevel].minScreenSize * (1.0f - hysteresis_)) {
+		return previousLevel;
+	}
+	return level;
+}
+
+bool LodGroup::Draw(const WorldTransform& worldTransform, uint32_t& level, const ObjectColor* objectColor) {
+	assert(camera_);
+	const Sphere worldSphere = MathUtility::Transform(localSphere_, worldTransform.matWorld_);
+	level = SelectLevel(GetScreenSize(worldSphere), level);
+	if (level >= GetLevelCount()) {
+		++stats_.culledCount;
+		return false;
+	}
+	levels_[level].model->Draw(worldTransform, *camera_, objectColor);
+	++stats_.instanceCounts[level];
+	stats_.vertexCounts[level] += levels_[level].vertexCount;
+	return true;
+}
+
+} // namespace KamataEngine
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "math/BoundingVolume.h"
+#include "math/Vector3.h"
+#include <cstdint>
+#include <vector>
+
+namespace KamataEngine {
+
+class Camera;
+class CameraMatrixCache;
+class Model;
+class ObjectColor;
+class WorldTransform;
+
+/// <summary>
+/// LOD ごとの1フレーム分の描画数
+/// </summary>
+struct LodStats {
+	std::vector<uint32_t> instanceCounts; // LOD ごとに描いたインスタンス数
+	std::vector<uint64_t> vertexCounts;   // LOD ごとに描いた頂点数の合計
+	uint32_t culledCount = 0;             // 小さすぎて描かなかったインスタンス数
+};
+
+/// <summary>
+/// 詳細度の異なるモデルをまとめた LOD グループ
+/// 境界球を投影した直径（ピクセル）とレベルごとの最小の大きさを比べて描くモデルを選ぶ。
+/// 粗いレベルへ切り替えるときだけ閾値をヒステリシスの割合だけ下げて、境目でのちらつきを防ぐ。
+/// BeginFrame → インスタンスごとに Draw の順に使う（Model::PreDraw と PostDraw の間で呼ぶ）。
+/// </summary>
+class LodGroup final {
+public:
+	// 前回のレベルがないことを表す（最初のフレームはヒステリシスなしで選ぶ）
+	static constexpr uint32_t kNoLevel = UINT32_MAX;
+
+	/// <summary>
+	/// レベルを詳細な順に追加（モデルはこのグループより長く有効であること）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="minScreenSize">このレベルを使う最小の投影した直径（ピクセル）。前のレベルより小さいこと。0 なら常に描く</param>
+	void AddLevel(Model* model, float minScreenSize);
+
+	/// <summary>
+	/// ヒステリシスの割合を設定（粗いレベルへは閾値の (1 - hysteresis) 倍まで小さくなってから切り替える）
+	/// </summary>
+	void SetHysteresis(float hysteresis);
+
+	/// <summary>
+	/// 境界球を設定（既定では最も詳細なレベルのモデルの頂点から求める）
+	/// </summary>
+	/// <param name="localSphere">ローカル座標系での境界球</param>
+	void SetBoundingSphere(const Sphere& localSphere) { localSphere_ = localSphere; }
+	const Sphere& GetBoundingSphere() const { return localSphere_; }
+
+	/// <summary>
+	/// フレームの開始（カメラの位置と投影の倍率を求め、描画数をクリアする）
+	/// </summary>
+	/// <param name="camera">カメラ（UpdateMatrix 済みであること）</param>
+	/// <param name="viewportHeight">ビューポートの高さ（ピクセル。0 ならウィンドウの高さ）</param>
+	void BeginFrame(const Camera& camera, float viewportHeight = 0.0f);
+	// CameraMatrixCache の行列を使う版（Update 済みであること）
+	void BeginFrame(const CameraMatrixCache& cameraMatrices, float viewportHeight = 0.0f);
+
+	/// <summary>
+	/// ワールド座標系の境界球を投影した直径（ピクセル）を求める（カメラが球の内側なら無限大）
+	/// </summary>
+	float GetScreenSize(const Sphere& worldSphere) const;
+
+	/// <summary>
+	/// 投影した直径からレベルを選ぶ
+	/// </summary>
+	/// <param name="screenSize">投影した直径（ピクセル）</param>
+	/// <param name="previousLevel">前回のレベル（なければ kNoLevel）</param>
+	/// <returns>レベル（どのレベルの最小の大きさにも届かなければ GetLevelCount()）</returns>
+	uint32_t SelectLevel(float screenSize, uint32_t previousLevel = kNoLevel) const;
+
+	/// <summary>
+	/// 描画（レベルを選んで、そのレベルのモデルを描く）
+	/// </summary>
+	/// <param name="worldTransform">ワールドトランスフォーム（TransferMatrix 済みであること）</param>
+	/// <param name="level">インスタンスごとの前回のレベル（kNoLevel で初期化しておく）。選んだレベルを書き込む</param>
+	/// <param name="objectColor">オブジェクトカラー</param>
+	/// <returns>描いたか</returns>
+	bool Draw(const WorldTransform& worldTransform, uint32_t& level, const ObjectColor* objectColor = nullptr);
+
+	/// <summary>
+	/// 今のフレームの描画数を取得
+	/// </summary>
+	const LodStats& GetStats() const { return stats_; }
+
+	uint32_t GetLevelCount() const { return static_cast<uint32_t>(levels_.size()); }
+	Model* GetModel(uint32_t level) const { return levels_[level].model; }
+
+private:
+	struct Level {
+		Model* model;
+		float minScreenSize;
+		uint64_t vertexCount; // 全メッシュの頂点数
+	};
+
+	// カメラの位置と、1 / tan(fovY / 2) から投影の倍率を求めて描画数をクリアする
+	void BeginFrame(const Camera& camera, const Vector3& cameraPosition, float focalLength, float viewportHeight);
+
+	std::vector<Level> levels_;
+	Sphere localSphere_ = {};
+	float hysteresis_ = 0.1f;
+
+	// フレームごとの値
+	const Camera* camera_ = nullptr;
+	Vector3 cameraPosition_ = {};
+	float projectionScale_ = 0.0f; // 距離 1 での半径 1 の投影した直径（ピクセル）
+	LodStats stats_;
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,54 @@
+#include "3d/MeshBounds.h"
+#include "3d/Mesh.h"
+#include "3d/Model.h"
+#include "3d/WorldTransform.h"
+#include <memory>
+#include <vector>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+MeshBounds ComputeBounds(Mesh& mesh) {
+	const std::vector<Mesh::VertexPosNormalUv>& vertices = mesh.GetVertices();
+	const Vector3* points = vertices.empty() ? nullptr : &vertices.front().pos;
+	constexpr size_t kStride = sizeof(Mesh::VertexPosNormalUv);
+	return {MakeAABB(points, vertices.size(), kStride), MakeSphere(points, vertices.size(), kStride), MakeOBB(points, vertices.size(), kStride)};
+}
+
+MeshBounds ComputeBounds(Model& model) {
+	const std::vector<std::unique_ptr<Mesh>>& meshes = model.GetMeshes();
+	if (meshes.size() == 1) {
+		return ComputeBounds(*meshes.front());
+	}
+
+	// 全メッシュの頂点をまとめて求める（メッシュごとの境界を結合するより小さくなる）
+	std::vector<Vector3> points;
+	for (const std::unique_ptr<Mesh>& mesh : meshes) {
+		for (const Mesh::VertexPosNormalUv& vertex : mesh->GetVertices()) {
+			points.push_back(vertex.pos);
+		}
+	}
+	return {MakeAABB(points.data(), points.size()), MakeSphere(points.data(), points.size()), MakeOBB(points.data(), points.size())};
+}
+
+MeshBounds Transform(const MeshBounds& bounds, const WorldTransform& worldTransform) {
+	const Matrix4x4& m = worldTransform.matWorld_;
+	return {Transform(bounds.aabb, m), Transform(bounds.sphere, m), Transform(bounds.obb, m)};
+}
+
+} // namespace MathUtility
+
+const MeshBounds& BoundsCache::Get(Model& model) {
+	auto it = bounds_.find(&model);
+	if (it == bounds_.end()) {
+		it = bounds_.emplace(&model, MathUtility::ComputeBounds(model)).first;
+	}
+	return it->second;
+}
+
+void BoundsCache::Remove(const Model& model) { bounds_.erase(&model); }
+
+void BoundsCache::Clear() { bounds_.clear(); }
+
+} // namespace KamataEngine
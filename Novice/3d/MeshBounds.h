@@ -0,0 +1,60 @@
+#pragma once
+
+#include "math/BoundingVolume.h"
+#include <unordered_map>
+
+namespace KamataEngine {
+
+class Mesh;
+class Model;
+class WorldTransform;
+
+/// <summary>
+/// メッシュ・モデルのローカル座標系での境界
+/// </summary>
+struct MeshBounds final {
+	AABB aabb;     // 軸平行境界ボックス
+	Sphere sphere; // 境界球
+	OBB obb;       // 有向境界ボックス
+};
+
+namespace MathUtility {
+
+// メッシュの頂点座標から境界を求める
+MeshBounds ComputeBounds(Mesh& mesh);
+// モデルの全メッシュの頂点座標から境界を求める
+MeshBounds ComputeBounds(Model& model);
+
+// ワールド行列で変換した境界を求める（TransferMatrix 済みの matWorld_ を使う）
+MeshBounds Transform(const MeshBounds& bounds, const WorldTransform& worldTransform);
+
+} // namespace MathUtility
+
+/// <summary>
+/// モデルごとの境界のキャッシュ（読み込み後の最初の取得時に一度だけ計算する）
+/// </summary>
+class BoundsCache final {
+public:
+	/// <summary>
+	/// 境界を取得（未計算なら計算して保持する）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <returns>ローカル座標系での境界</returns>
+	const MeshBounds& Get(Model& model);
+
+	/// <summary>
+	/// モデルの境界を破棄（モデルを解放する前に呼ぶ）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	void Remove(const Model& model);
+
+	/// <summary>
+	/// すべての境界を破棄
+	/// </summary>
+	void Clear();
+
+private:
+	std::unordered_map<const Model*, MeshBounds> bounds_;
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,73 @@
+#include "3d/MeshRaycast.h"
+#include "3d/Mesh.h"
+#include "3d/Model.h"
+#include "3d/WorldTransform.h"
+#include "math/AffineMatrix.h"
+#include <cassert>
+#include <memory>
+
+namespace KamataEngine {
+
+void TriangleBuffer::Build(Mesh& mesh) {
+	Clear();
+	const std::vector<Mesh::VertexPosNormalUv>& vertices = mesh.GetVertices();
+	if (!vertices.empty()) {
+		Append(&vertices.front().pos, sizeof(Mesh::VertexPosNormalUv), mesh.GetIndices());
+	}
+}
+
+void TriangleBuffer::Build(Model& model) {
+	Clear();
+	for (const std::unique_ptr<Mesh>& mesh : model.GetMeshes()) {
+		const std::vector<Mesh::VertexPosNormalUv>& vertices = mesh->GetVertices();
+		if (!vertices.empty()) {
+			Append(&vertices.front().pos, sizeof(Mesh::VertexPosNormalUv), mesh->GetIndices());
+		}
+	}
+}
+
+void TriangleBuffer::Append(const Vector3* points, size_t stride, std::span<const uint32_t> indices) {
+	assert(indices.size() % 3 == 0);
+	const size_t count = v0x_.size() + indices.size() / 3;
+	for (std::vector<float>* component : {&v0x_, &v0y_, &v0z_, &edge1x_, &edge1y_, &edge1z_, &edge2x_, &edge2y_, &edge2z_}) {
+		component->reserve(count);
+	}
+
+	const std::byte* base = reinterpret_cast<const std::byte*>(points);
+	auto point = [base, stride](uint32_t index) -> const Vector3& { return *reinterpret_cast<const Vector3*>(base + index * stride); };
+	for (size_t i = 0; i < indices.size(); i += 3) {
+		const Vector3& p0 = point(indices[i]);
+		const Vector3& p1 = point(indices[i + 1]);
+		const Vector3& p2 = point(indices[i + 2]);
+		v0x_.push_back(p0.x);
+		v0y_.push_back(p0.y);
+		v0z_.push_back(p0.z);
+		edge1x_.push_back(p1.x - p0.x);
+		edge1y_.push_back(p1.y - p0.y);
+		edge1z_.push_back(p1.z - p0.z);
+		edge2x_.push_back(p2.x - p0.x);
+		edge2y_.push_back(p2.y - p0.y);
+		edge2z_.push_back(p2.z - p0.z);
+	}
+}
+
+void TriangleBuffer::Clear() {
+	for (std::vector<float>* component : {&v0x_, &v0y_, &v0z_, &edge1x_, &edge1y_, &edge1z_, &edge2x_, &edge2y_, &edge2z_}) {
+		component->clear();
+	}
+}
+
+TriangleSoA TriangleBuffer::GetTriangles() const {
+	return {v0x_.data(), v0y_.data(), v0z_.data(), edge1x_.data(), edge1y_.data(), edge1z_.data(), edge2x_.data(), edge2y_.data(), edge2z_.data(), v0x_.size()};
+}
+
+namespace MathUtility {
+
+bool Raycast(const Ray& ray, const TriangleBuffer& triangles, const WorldTransform& worldTransform, float maxDistance, RayHit* hit) {
+	const Ray localRay = Transform(ray, InverseAffine(worldTransform.matWorld_));
+	return Intersect(localRay, triangles.GetTriangles(), maxDistance, hit);
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "math/RayIntersection.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace KamataEngine {
+
+class Mesh;
+class Model;
+class WorldTransform;
+
+/// <summary>
+/// 交差判定用の三角形バッファ（インデックスを展開し、SoA 形式で保持する）
+/// </summary>
+class TriangleBuffer final {
+public:
+	/// <summary>
+	/// メッシュの三角形から構築
+	/// </summary>
+	/// <param name="mesh">メッシュ</param>
+	void Build(Mesh& mesh);
+
+	/// <summary>
+	/// モデルの全メッシュの三角形から構築（三角形番号はメッシュの順に通し番号になる）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	void Build(Model& model);
+
+	/// <summary>
+	/// 三角形を追加
+	/// </summary>
+	/// <param name="points">頂点座標の先頭</param>
+	/// <param name="stride">頂点と頂点の間のバイト数</param>
+	/// <param name="indices">三角形リストのインデックス</param>
+	void Append(const Vector3* points, size_t stride, std::span<const uint32_t> indices);
+
+	/// <summary>
+	/// すべての三角形を破棄
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// SoA 形式の三角形配列を取得
+	/// </summary>
+	TriangleSoA GetTriangles() const;
+
+	/// <summary>
+	/// 三角形の数を取得
+	/// </summary>
+	size_t GetTriangleCount() const { return v0x_.size(); }
+
+private:
+	std::vector<float> v0x_, v0y_, v0z_;
+	std::vector<float> edge1x_, edge1y_, edge1z_;
+	std::vector<float> edge2x_, edge2y_, edge2z_;
+};
+
+namespace MathUtility {
+
+// ワールド座標系の半直線と、ワールド変換されたメッシュの最も近い交点を求める
+// 半直線をローカル座標系に変換して判定するため、hit の t はワールド座標系の半直線の t と一致する。
+bool Raycast(const Ray& ray, const TriangleBuffer& triangles, const WorldTransform& worldTransform, float maxDistance, RayHit* hit = nullptr);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
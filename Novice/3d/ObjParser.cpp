@@ -0,0 +1,471 @@
+#include "3d/ObjParser.h"
+#include "base/JobSystem.h"
+#include "base/MappedFile.h"
+#include "base/ThreadPool.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <utility>
+
+namespace KamataEngine {
+
+namespace ObjParser {
+
+namespace {
+
+// 属性がないことを表す番号
+constexpr uint32_t kMissing = UINT32_MAX;
+// 並列に解析するときの1チャンクのバイト数の目安（行の途中では切らない）
+constexpr size_t kChunkBytes = size_t{1} << 20;
+
+enum Attribute { kPosition, kTexcoord, kNormal, kAttributeCount };
+
+// 面の角が参照する属性の番号（0 始まり）
+struct Corner {
+	uint32_t indices[kAttributeCount];
+};
+
+/// <summary>
+/// チャンクの中で o / usemtl が続く範囲
+/// </summary>
+struct Segment {
+	std::string_view name;     // newObject のときの o の名前
+	std::string_view material; // newMaterial のときの usemtl の名前
+	bool newObject = false;
+	bool newMaterial = false;
+	size_t faceBegin = 0;   // チャンクの faceSizes の番号
+	size_t cornerBegin = 0; // チャンクの corners の番号
+	// 結合時に決める書き込み先
+	size_t meshIndex = 0;
+	uint32_t vertexOffset = 0;
+	size_t indexOffset = 0;
+};
+
+/// <summary>
+/// 行の範囲ごとの解析結果
+/// 負の番号（相対参照）はチャンクの先頭からの番号で持ち、結合時に前のチャンクまでの属性の数を足す。
+/// </summary>
+struct Chunk {
+	std::string_view text;
+	std::vector<Vector3> positions;
+	std::vector<Vector2> texcoords;
+	std::vector<Vector3> normals;
+	std::vector<Corner> corners;
+	std::vector<uint32_t> faceSizes; // 面ごとの角の数
+	std::vector<Segment> segments;
+	std::vector<std::string_view> materialLibraries;
+	std::vector<size_t> relativeCorners[kAttributeCount]; // 相対参照を含む角の番号
+	uint32_t bases[kAttributeCount] = {};                 // 前のチャンクまでの属性の数
+	bool valid = true;
+
+	uint32_t GetCount(Attribute attribute) const {
+		switch (attribute) {
+		case kPosition:
+			return static_cast<uint32_t>(positions.size());
+		case kTexcoord:
+			return static_cast<uint32_t>(texcoords.size());
+		default:
+			return static_cast<uint32_t>(normals.size());
+		}
+	}
+};
+
+inline const char* SkipSpaces(const char* p, const char* end) {
+	while (p < end && (*p == ' ' || *p == '\t')) {
+		++p;
+	}
+	return p;
+}
+
+inline const char* SkipToken(const char* p, const char* end) {
+	while (p < end && *p != ' ' && *p != '\t') {
+		++p;
+	}
+	return p;
+}
+
+// 空白に続く実数を読む（読めなければ 0 にしてその語を飛ばす）
+inline const char* ParseFloat(const char* p, const char* end, float& value) {
+	p = SkipSpaces(p, end);
+	if (p < end && *p == '+') {
+		++p;
+	}
+	const std::from_chars_result result = std::from_chars(p, end, value);
+	if (result.ptr == p) {
+		value = 0.0f;
+		return SkipToken(p, end);
+	}
+	if (result.ec != std::errc()) {
+		value = 0.0f;
+	}
+	return result.ptr;
+}
+
+// 面の角の番号を1つ読む（1 始まり、負なら末尾からの相対参照）
+inline const char* ParseIndex(const char* p, const char* end, Chunk& chunk, Attribute attribute, Corner& corner) {
+	int64_t value = 0;
+	const std::from_chars_result result = std::from_chars(p, end, value);
+	if (result.ptr == p) {
+		return p;
+	}
+	if (value > 0 && value <= UINT32_MAX) {
+		corner.indices[attribute] = static_cast<uint32_t>(value - 1);
+	} else if (value < 0 && -value <= UINT32_MAX) {
+		// チャンクの先頭からの番号（前のチャンクを指すときは負になるが、符号なしの加算で結合時に正しい値になる）
+		corner.indices[attribute] = chunk.GetCount(attribute) - static_cast<uint32_t>(-value);
+		chunk.relativeCorners[attribute].push_back(chunk.corners.size());
+	} else {
+		chunk.valid = false;
+	}
+	return result.ptr;
+}
+
+// f の行（p は f の直後）
+void ParseFace(const char* p, const char* end, Chunk& chunk) {
+	uint32_t cornerCount = 0;
+	for (;;) {
+		p = SkipSpaces(p, end);
+		if (p >= end) {
+			break;
+		}
+		Corner corner = {{kMissing, kMissing, kMissing}};
+		const char* const token = p;
+		p = ParseIndex(p, end, chunk, kPosition, corner);
+		// 相対参照は結合前に kMissing と同じ値になることがあるので、読めたかどうかで判定する
+		if (p == token) {
+			chunk.valid = false;
+		}
+		if (p < end && *p == '/') {
+			++p;
+			if (p < end && *p != '/') {
+				p = ParseIndex(p, end, chunk, kTexcoord, corner);
+			}
+			if (p < end && *p == '/') {
+				p = ParseIndex(p + 1, end, chunk, kNormal, corner);
+			}
+		}
+		p = SkipToken(p, end);
+		chunk.corners.push_back(corner);
+		++cornerCount;
+	}
+	if (cornerCount >= 3) {
+		chunk.faceSizes.push_back(cornerCount);
+	} else {
+		// 三角形にならない面は捨てる
+		chunk.corners.resize(chunk.corners.size() - cornerCount);
+		for (std::vector<size_t>& relativeCorners : chunk.relativeCorners) {
+			while (!relativeCorners.empty() && relativeCorners.back() >= chunk.corners.size()) {
+				relativeCorners.pop_back();
+			}
+		}
+	}
+}
+
+// 行の先頭のキーワードと一致したら、その後ろの位置を返す
+inline const char* MatchKeyword(const char* p, const char* end, std::string_view keyword) {
+	const size_t length = keyword.size();
+	if (static_cast<size_t>(end - p) < length || std::memcmp(p, keyword.data(), length) != 0) {
+		return nullptr;
+	}
+	if (p + length < end && p[length] != ' ' && p[length] != '\t') {
+		return nullptr;
+	}
+	return p + length;
+}
+
+// キーワードの後ろの、行末までの名前
+inline std::string_view GetName(const char* p, const char* end) {
+	p = SkipSpaces(p, end);
+	return {p, static_cast<size_t>(end - p)};
+}
+
+void StartSegment(Chunk& chunk, Segment segment) {
+	segment.faceBegin = chunk.faceSizes.size();
+	segment.cornerBegin = chunk.corners.size();
+	chunk.segments.push_back(segment);
+}
+
+// チャンクの全行を解析する
+void ParseChunk(Chunk& chunk) {
+	const char* p = chunk.text.data();
+	const char* const textEnd = p + chunk.text.size();
+	// チャンクの先頭は前のチャンクの o / usemtl の続き
+	StartSegment(chunk, {});
+
+	while (p < textEnd) {
+		const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(textEnd - p)));
+		const char* const next = lineEnd ? lineEnd + 1 : textEnd;
+		if (!lineEnd) {
+			lineEnd = textEnd;
+		}
+		while (lineEnd > p && (lineEnd[-1] == '\r' || lineEnd[-1] == ' ' || lineEnd[-1] == '\t')) {
+			--lineEnd;
+		}
+		p = SkipSpaces(p, lineEnd);
+
+		const char* rest;
+		if (p == lineEnd || *p == '#') {
+		} else if ((rest = MatchKeyword(p, lineEnd, "v"))) {
+			Vector3& position = chunk.positions.emplace_back();
+			ParseFloat(ParseFloat(ParseFloat(rest, lineEnd, position.x), lineEnd, position.y), lineEnd, position.z);
+		} else if ((rest = MatchKeyword(p, lineEnd, "vt"))) {
+			Vector2& texcoord = chunk.texcoords.emplace_back();
+			ParseFloat(ParseFloat(rest, lineEnd, texcoord.x), lineEnd, texcoord.y);
+			texcoord.y = 1.0f - texcoord.y;
+		} else if ((rest = MatchKeyword(p, lineEnd, "vn"))) {
+			Vector3& normal = chunk.normals.emplace_back();
+			ParseFloat(ParseFloat(ParseFloat(rest, lineEnd, normal.x), lineEnd, normal.y), lineEnd, normal.z);
+		} else if ((rest = MatchKeyword(p, lineEnd, "f"))) {
+			ParseFace(rest, lineEnd, chunk);
+		} else if ((rest = MatchKeyword(p, lineEnd, "o"))) {
+			Segment segment;
+			segment.name = GetName(rest, lineEnd);
+			segment.newObject = true;
+			StartSegment(chunk, segment);
+		} else if ((rest = MatchKeyword(p, lineEnd, "usemtl"))) {
+			Segment segment;
+			segment.material = GetName(rest, lineEnd);
+			segment.newMaterial = true;
+			StartSegment(chunk, segment);
+		} else if ((rest = MatchKeyword(p, lineEnd, "mtllib"))) {
+			chunk.materialLibraries.push_back(GetName(rest, lineEnd));
+		}
+		p = next;
+	}
+}
+
+// テキストを kChunkBytes 程度ずつ、行の境目で分ける
+std::vector<Chunk> SplitChunks(std::string_view text, size_t chunkBytes) {
+	std::vector<Chunk> chunks;
+	size_t begin = 0;
+	while (begin < text.size()) {
+		size_t end = begin + chunkBytes;
+		if (end >= text.size()) {
+			end = text.size();
+		} else {
+			const size_t newline = text.find('\n', end);
+			end = newline == std::string_view::npos ? text.size() : newline + 1;
+		}
+		chunks.emplace_back().text = text.substr(begin, end - begin);
+		begin = end;
+	}
+	return chunks;
+}
+
+// チャンクの相対参照を確定し、属性を結合した配列へ書き込む
+void ResolveChunk(Chunk& chunk, Vector3* positions, Vector2* texcoords, Vector3* normals) {
+	for (int attribute = 0; attribute < kAttributeCount; ++attribute) {
+		for (size_t corner : chunk.relativeCorners[attribute]) {
+			chunk.corners[corner].indices[attribute] += chunk.bases[attribute];
+		}
+	}
+	std::copy(chunk.positions.begin(), chunk.positions.end(), positions + chunk.bases[kPosition]);
+	std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), texcoords + chunk.bases[kTexcoord]);
+	std::copy(chunk.normals.begin(), chunk.normals.end(), normals + chunk.bases[kNormal]);
+}
+
+/// <summary>
+/// 結合した属性の配列
+/// </summary>
+struct Attributes {
+	std::vector<Vector3> positions;
+	std::vector<Vector2> texcoords;
+	std::vector<Vector3> normals;
+};
+
+// チャンクの面を、結合時に決めた書き込み先のメッシュの頂点とインデックスに展開する
+void ExpandChunk(Chunk& chunk, const Attributes& attributes, std::vector<ObjMesh>& meshes) {
+	const uint32_t positionCount = static_cast<uint32_t>(attributes.positions.size());
+	const uint32_t texcoordCount = static_cast<uint32_t>(attributes.texcoords.size());
+	const uint32_t normalCount = static_cast<uint32_t>(attributes.normals.size());
+
+	for (size_t s = 0; s < chunk.segments.size(); ++s) {
+		const Segment& segment = chunk.segments[s];
+		const size_t faceEnd = s + 1 < chunk.segments.size() ? chunk.segments[s + 1].faceBegin : chunk.faceSizes.size();
+		if (segment.faceBegin == faceEnd) {
+			continue;
+		}
+		ObjMesh& mesh = meshes[segment.meshIndex];
+		ObjVertex* vertex = mesh.vertices.data() + segment.vertexOffset;
+		uint32_t* index = mesh.indices.data() + segment.indexOffset;
+		uint32_t vertexIndex = segment.vertexOffset;
+		const Corner* corner = chunk.corners.data() + segment.cornerBegin;
+
+		for (size_t face = segment.faceBegin; face < faceEnd; ++face) {
+			const uint32_t cornerCount = chunk.faceSizes[face];
+			for (uint32_t i = 0; i < cornerCount; ++i, ++corner, ++vertex) {
+				const uint32_t position = corner->indices[kPosition];
+				const uint32_t texcoord = corner->indices[kTexcoord];
+				const uint32_t normal = corner->indices[kNormal];
+				if (position < positionCount) {
+					vertex->pos = attributes.positions[position];
+				} else {
+					chunk.valid = false;
+				}
+				if (texcoord < texcoordCount) {
+					vertex->uv = attributes.texcoords[texcoord];
+				} else if (texcoord != kMissing) {
+					chunk.valid = false;
+				}
+				if (normal < normalCount) {
+					vertex->normal = attributes.normals[normal];
+				} else if (normal != kMissing) {
+					chunk.valid = false;
+				}
+			}
+			// 扇形に分ける
+			for (uint32_t i = 1; i + 1 < cornerCount; ++i) {
+				*index++ = vertexIndex;
+				*index++ = vertexIndex + i;
+				*index++ = vertexIndex + i + 1;
+			}
+			vertexIndex += cornerCount;
+		}
+	}
+}
+
+// 各チャンクの範囲を、チャンクの順にメッシュへ割り当てる（メッシュの頂点とインデックスを確保する）
+void AssignSegments(std::vector<Chunk>& chunks, ObjModelData& model) {
+	std::string_view name;
+	std::string_view material;
+	bool needNewMesh = true;
+	// メッシュごとの頂点数とインデックス数
+	std::vector<std::pair<size_t, size_t>> sizes;
+
+	for (Chunk& chunk : chunks) {
+		for (const std::string_view& library : chunk.materialLibraries) {
+			model.materialLibraries.emplace_back(library);
+		}
+		for (size_t s = 0; s < chunk.segments.size(); ++s) {
+			Segment& segment = chunk.segments[s];
+			if (segment.newObject) {
+				name = segment.name;
+				needNewMesh = true;
+			}
+			if (segment.newMaterial && segment.material != material) {
+				material = segment.material;
+				needNewMesh = true;
+			}
+
+			const bool last = s + 1 == chunk.segments.size();
+			const size_t faceEnd = last ? chunk.faceSizes.size() : chunk.segments[s + 1].faceBegin;
+			const size_t cornerEnd = last ? chunk.corners.size() : chunk.segments[s + 1].cornerBegin;
+			if (segment.faceBegin == faceEnd) {
+				continue;
+			}
+			if (needNewMesh) {
+				ObjMesh& mesh = model.meshes.emplace_back();
+				mesh.name = name;
+				mesh.material = material;
+				sizes.emplace_back(0, 0);
+				needNewMesh = false;
+			}
+			// 三角形の数は、面ごとの角の数 - 2 の合計
+			const size_t cornerCount = cornerEnd - segment.cornerBegin;
+			const size_t triangleCount = cornerCount - 2 * (faceEnd - segment.faceBegin);
+			auto& [vertexCount, indexCount] = sizes.back();
+			segment.meshIndex = model.meshes.size() - 1;
+			segment.vertexOffset = static_cast<uint32_t>(vertexCount);
+			segment.indexOffset = indexCount;
+			vertexCount += cornerCount;
+			indexCount += triangleCount * 3;
+		}
+	}
+
+	for (size_t i = 0; i < model.meshes.size(); ++i) {
+		model.meshes[i].vertices.resize(sizes[i].first);
+		model.meshes[i].indices.resize(sizes[i].second);
+	}
+}
+
+template<typename Body> void ParallelFor(ThreadPool& threadPool, size_t count, Body& body) { threadPool.ParallelFor(count, 1, body); }
+template<typename Body> void ParallelFor(JobSystem& jobSystem, size_t count, Body& body) { jobSystem.ParallelFor("ObjParser::Parse", count, 1, body); }
+
+// executor が nullptr なら呼び出し元のスレッドだけで処理する
+template<typename Executor, typename Function> void ForEachChunk(Executor* executor, size_t chunkCount, Function function) {
+	if (executor) {
+		auto body = [&function](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				function(i);
+			}
+		};
+		ParallelFor(*executor, chunkCount, body);
+	} else {
+		for (size_t i = 0; i < chunkCount; ++i) {
+			function(i);
+		}
+	}
+}
+
+template<typename Executor> bool ParseText(Executor* executor, std::string_view text, ObjModelData& model) {
+	model = {};
+	std::vector<Chunk> chunks = SplitChunks(text, executor ? kChunkBytes : text.size());
+
+	// 1. チャンクごとに解析
+	ForEachChunk(executor, chunks.size(), [&chunks](size_t i) { ParseChunk(chunks[i]); });
+
+	// 2. 前のチャンクまでの属性の数から相対参照を確定し、属性を結合する
+	uint32_t totals[kAttributeCount] = {};
+	for (Chunk& chunk : chunks) {
+		for (int attribute = 0; attribute < kAttributeCount; ++attribute) {
+			chunk.bases[attribute] = totals[attribute];
+			totals[attribute] += chunk.GetCount(static_cast<Attribute>(attribute));
+		}
+	}
+	Attributes attributes;
+	attributes.positions.resize(totals[kPosition]);
+	attributes.texcoords.resize(totals[kTexcoord]);
+	attributes.normals.resize(totals[kNormal]);
+	ForEachChunk(executor, chunks.size(), [&chunks, &attributes](size_t i) {
+		ResolveChunk(chunks[i], attributes.positions.data(), attributes.texcoords.data(), attributes.normals.data());
+		chunks[i].positions = {};
+		chunks[i].texcoords = {};
+		chunks[i].normals = {};
+	});
+
+	// 3. 面をメッシュに割り当て（ファイルの順に決めるので、分け方によらず同じ結果になる）、頂点を展開する
+	AssignSegments(chunks, model);
+	ForEachChunk(executor, chunks.size(), [&chunks, &attributes, &model](size_t i) { ExpandChunk(chunks[i], attributes, model.meshes); });
+
+	bool valid = true;
+	for (const Chunk& chunk : chunks) {
+		valid &= chunk.valid;
+	}
+	return valid;
+}
+
+} // namespace
+
+bool Parse(std::string_view text, ObjModelData& model) { return ParseText<ThreadPool>(nullptr, text, model); }
+
+bool Parse(ThreadPool& threadPool, std::string_view text, ObjModelData& model) { return ParseText(&threadPool, text, model); }
+
+bool Parse(JobSystem& jobSystem, std::string_view text, ObjModelData& model) { return ParseText(&jobSystem, text, model); }
+
+bool Load(const std::filesystem::path& path, ObjModelData& model) {
+	MappedFile file;
+	if (!file.Open(path)) {
+		return false;
+	}
+	return Parse(file.GetView(), model);
+}
+
+bool Load(ThreadPool& threadPool, const std::filesystem::path& path, ObjModelData& model) {
+	MappedFile file;
+	if (!file.Open(path)) {
+		return false;
+	}
+	return Parse(threadPool, file.GetView(), model);
+}
+
+bool Load(JobSystem& jobSystem, const std::filesystem::path& path, ObjModelData& model) {
+	MappedFile file;
+	if (!file.Open(path)) {
+		return false;
+	}
+	return Parse(jobSystem, file.GetView(), model);
+}
+
+} // namespace ObjParser
+
+} // namespace KamataEngine
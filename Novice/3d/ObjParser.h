@@ -0,0 +1,60 @@
+#pragma once
+
+#include "math/Vector2.h"
+#include "math/Vector3.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace KamataEngine {
+
+class JobSystem;
+class ThreadPool;
+
+/// <summary>
+/// OBJ の頂点（Mesh::VertexPosNormalUv と同じ並びなので、そのままコピーできる）
+/// </summary>
+struct ObjVertex {
+	Vector3 pos;    // xyz座標
+	Vector3 normal; // 法線ベクトル（vn がなければ 0）
+	Vector2 uv;     // uv座標（vt がなければ 0）
+};
+
+/// <summary>
+/// OBJ のメッシュ（o ごと、同じ o の中では usemtl でマテリアルが変わるごとに分ける）
+/// </summary>
+struct ObjMesh {
+	std::string name;     // o の名前
+	std::string material; // usemtl のマテリアル名
+	std::vector<ObjVertex> vertices;
+	std::vector<uint32_t> indices; // 三角形リスト（メッシュの頂点番号）
+};
+
+/// <summary>
+/// OBJ ファイルの内容
+/// </summary>
+struct ObjModelData {
+	std::vector<std::string> materialLibraries; // mtllib のファイル名
+	std::vector<ObjMesh> meshes;                // 面を持つメッシュだけ
+};
+
+namespace ObjParser {
+
+// OBJ のテキストを解析する。頂点は Model::CreateFromOBJ と同じく面の角ごとに作り（共有しない）、
+// 多角形は扇形に三角形へ分け、テクスチャ座標の v は 1 - v に反転する。
+// 戻り値は面の頂点番号がすべて範囲内だったか（範囲外の属性は 0 にする）。
+bool Parse(std::string_view text, ObjModelData& model);
+// 行の範囲で分けてスレッドプールかジョブシステムで並列に解析する（結果は Parse と同じ）
+bool Parse(ThreadPool& threadPool, std::string_view text, ObjModelData& model);
+bool Parse(JobSystem& jobSystem, std::string_view text, ObjModelData& model);
+
+// ファイルをメモリにマップして解析する（開けなければ false）
+bool Load(const std::filesystem::path& path, ObjModelData& model);
+bool Load(ThreadPool& threadPool, const std::filesystem::path& path, ObjModelData& model);
+bool Load(JobSystem& jobSystem, const std::filesystem::path& path, ObjModelData& model);
+
+} // namespace ObjParser
+
+} // namespace KamataEngine
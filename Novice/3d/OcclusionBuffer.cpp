@@ -0,0 +1,365 @@
+#include "3d/OcclusionBuffer.h"
+#include "base/JobSystem.h"
+#include "base/ThreadPool.h"
+#include "math/MathUtilityConstexpr.h"
+#include "math/SimdSupport.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace KamataEngine {
+
+using MathUtility::SimdLevel;
+
+namespace {
+
+using MathUtility::Constexpr::operator*;
+
+// 行ベクトル p * M の (x, y, z, w)
+struct ClipPoint {
+	float x, y, z, w;
+};
+
+inline ClipPoint TransformClip(const Vector3& p, const Matrix4x4& m) {
+	return {
+	    p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+	    p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+	    p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2],
+	    p.x * m.m[0][3] + p.y * m.m[1][3] + p.z * m.m[2][3] + m.m[3][3],
+	};
+}
+
+// 中心と半径で表した要素を AABB にする
+inline AABB GetAABB(const AABBSoA& b, size_t i) {
+	return {
+	    {b.centerX[i] - b.extentX[i], b.centerY[i] - b.extentY[i], b.centerZ[i] - b.extentZ[i]},
+	    {b.centerX[i] + b.extentX[i], b.centerY[i] + b.extentY[i], b.centerZ[i] + b.extentZ[i]},
+	};
+}
+
+// 1行分の [x0, x1) の8ピクセル単位のブロックで、三角形に覆われたピクセルの深度を更新する
+// rowEdge は辺関数の b * y + c、depth は三角形の深度
+using SpanFunction = void (*)(const float* edgeA, const float* rowEdge, float depth, float* row, uint32_t x0, uint32_t x1);
+
+#pragma region スカラー版
+
+void RasterizeSpanScalar(const float* edgeA, const float* rowEdge, float depth, float* row, uint32_t x0, uint32_t x1) {
+	for (uint32_t x = x0; x < x1; ++x) {
+		const float px = static_cast<float>(x) + 0.5f;
+		const bool covered = edgeA[0] * px + rowEdge[0] >= 0.0f && edgeA[1] * px + rowEdge[1] >= 0.0f && edgeA[2] * px + rowEdge[2] >= 0.0f;
+		if (covered && depth < row[x]) {
+			row[x] = depth;
+		}
+	}
+}
+
+#pragma endregion
+
+#if KAMATA_SIMD_X86
+
+#pragma region SSE版
+
+void RasterizeSpanSSE(const float* edgeA, const float* rowEdge, float depth, float* row, uint32_t x0, uint32_t x1) {
+	const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+	const __m128 a0 = _mm_set1_ps(edgeA[0]);
+	const __m128 a1 = _mm_set1_ps(edgeA[1]);
+	const __m128 a2 = _mm_set1_ps(edgeA[2]);
+	const __m128 r0 = _mm_set1_ps(rowEdge[0]);
+	const __m128 r1 = _mm_set1_ps(rowEdge[1]);
+	const __m128 r2 = _mm_set1_ps(rowEdge[2]);
+	const __m128 d = _mm_set1_ps(depth);
+	const __m128 zero = _mm_setzero_ps();
+	for (uint32_t x = x0; x < x1; x += 4) {
+		const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+		const __m128 covered = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), r0), zero), _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), r1), zero)),
+		                                  _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), r2), zero));
+		const __m128 current = _mm_loadu_ps(row + x);
+		const __m128 nearer = _mm_min_ps(current, d);
+		_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(covered, nearer), _mm_andnot_ps(covered, current)));
+	}
+}
+
+#pragma endregion
+
+#pragma region AVX2版
+
+KAMATA_TARGET_AVX2 void RasterizeSpanAVX2(const float* edgeA, const float* rowEdge, float depth, float* row, uint32_t x0, uint32_t x1) {
+	const __m256 offsets = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+	const __m256 a0 = _mm256_set1_ps(edgeA[0]);
+	const __m256 a1 = _mm256_set1_ps(edgeA[1]);
+	const __m256 a2 = _mm256_set1_ps(edgeA[2]);
+	const __m256 r0 = _mm256_set1_ps(rowEdge[0]);
+	const __m256 r1 = _mm256_set1_ps(rowEdge[1]);
+	const __m256 r2 = _mm256_set1_ps(rowEdge[2]);
+	const __m256 d = _mm256_set1_ps(depth);
+	const __m256 zero = _mm256_setzero_ps();
+	for (uint32_t x = x0; x < x1; x += 8) {
+		const __m256 px = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(x)), offsets);
+		const __m256 covered = _mm256_and_ps(
+		    _mm256_and_ps(_mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a0, px), r0), zero, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a1, px), r1), zero, _CMP_GE_OQ)),
+		    _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a2, px), r2), zero, _CMP_GE_OQ));
+		const __m256 current = _mm256_loadu_ps(row + x);
+		_mm256_storeu_ps(row + x, _mm256_blendv_ps(current, _mm256_min_ps(current, d), covered));
+	}
+	_mm256_zeroupper();
+}
+
+#pragma endregion
+
+#endif // KAMATA_SIMD_X86
+
+SpanFunction GetSpanFunction() {
+	switch (MathUtility::GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		return RasterizeSpanAVX2;
+	case SimdLevel::kSSE:
+		return RasterizeSpanSSE;
+#endif
+	default:
+		return RasterizeSpanScalar;
+	}
+}
+
+} // namespace
+
+void OcclusionBuffer::Initialize(uint32_t width, uint32_t height) {
+	assert(width > 0 && height > 0);
+	tilesX_ = (width + kTileSize - 1) / kTileSize;
+	tilesY_ = (height + kTileSize - 1) / kTileSize;
+	width_ = tilesX_ * kTileSize;
+	height_ = tilesY_ * kTileSize;
+	depths_.assign(static_cast<size_t>(width_) * height_, 1.0f);
+	tileMaxDepths_.assign(static_cast<size_t>(tilesX_) * tilesY_, 1.0f);
+	triangles_.clear();
+}
+
+void OcclusionBuffer::BeginFrame(const Matrix4x4& viewProjection, DepthMode depthMode) {
+	assert(width_ > 0);
+	viewProjection_ = viewProjection;
+	reverseZ_ = MathUtility::IsReverseZ(depthMode);
+	std::fill(depths_.begin(), depths_.end(), 1.0f);
+	std::fill(tileMaxDepths_.begin(), tileMaxDepths_.end(), 1.0f);
+	triangles_.clear();
+}
+
+void OcclusionBuffer::AddOccluder(const Vector3* points, size_t stride, std::span<const uint32_t> indices, const Matrix4x4& world) {
+	assert(indices.size() % 3 == 0);
+	const Matrix4x4 worldViewProjection = world * viewProjection_;
+	const float halfWidth = static_cast<float>(width_) * 0.5f;
+	const float halfHeight = static_cast<float>(height_) * 0.5f;
+	const std::byte* base = reinterpret_cast<const std::byte*>(points);
+
+	for (size_t i = 0; i < indices.size(); i += 3) {
+		float sx[3], sy[3];
+		float depth = 0.0f;
+		bool clipped = false;
+		for (int k = 0; k < 3; ++k) {
+			const Vector3& p = *reinterpret_cast<const Vector3*>(base + stride * indices[i + k]);
+			const ClipPoint clip = TransformClip(p, worldViewProjection);
+			const float vertexDepth = clip.w > 0.0f ? ToLinearOrder(clip.z / clip.w) : -1.0f;
+			// カメラの後ろやニアクリップ面より手前の頂点があれば描かない（遮蔽物を減らす分には保守的）
+			if (!(vertexDepth >= 0.0f)) {
+				clipped = true;
+				break;
+			}
+			const float invW = 1.0f / clip.w;
+			sx[k] = (clip.x * invW + 1.0f) * halfWidth;
+			sy[k] = (1.0f - clip.y * invW) * halfHeight;
+			depth = std::max(depth, vertexDepth);
+		}
+		if (clipped) {
+			continue;
+		}
+
+		// 辺関数が内側で正になるよう、向きが逆なら2頂点を入れ替える
+		const float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sy[1] - sy[0]) * (sx[2] - sx[0]);
+		if (area == 0.0f || !std::isfinite(area)) {
+			continue;
+		}
+		if (area < 0.0f) {
+			std::swap(sx[1], sx[2]);
+			std::swap(sy[1], sy[2]);
+		}
+
+		Triangle triangle;
+		for (int k = 0; k < 3; ++k) {
+			const int next = (k + 1) % 3;
+			triangle.edgeA[k] = -(sy[next] - sy[k]);
+			triangle.edgeB[k] = sx[next] - sx[k];
+			triangle.edgeC[k] = (sy[next] - sy[k]) * sx[k] - (sx[next] - sx[k]) * sy[k];
+		}
+		triangle.depth = std::min(depth, 1.0f);
+		// 中心が三角形の外接矩形に入るピクセルの範囲
+		const float minX = std::min({sx[0], sx[1], sx[2]});
+		const float maxX = std::max({sx[0], sx[1], sx[2]});
+		const float minY = std::min({sy[0], sy[1], sy[2]});
+		const float maxY = std::max({sy[0], sy[1], sy[2]});
+		triangle.minX = static_cast<int32_t>(std::max(std::ceil(minX - 0.5f), 0.0f));
+		triangle.minY = static_cast<int32_t>(std::max(std::ceil(minY - 0.5f), 0.0f));
+		triangle.maxX = static_cast<int32_t>(std::min(std::floor(maxX - 0.5f), static_cast<float>(width_ - 1)));
+		triangle.maxY = static_cast<int32_t>(std::min(std::floor(maxY - 0.5f), static_cast<float>(height_ - 1)));
+		if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+			continue;
+		}
+		triangles_.push_back(triangle);
+	}
+}
+
+void OcclusionBuffer::Rasterize() {
+	for (uint32_t tileRow = 0; tileRow < tilesY_; ++tileRow) {
+		RasterizeRows(tileRow * kTileSize, (tileRow + 1) * kTileSize);
+		UpdateTileDepths(tileRow);
+	}
+}
+
+template<typename ParallelFor> void OcclusionBuffer::RasterizeParallel(ParallelFor&& parallelFor) {
+	// タイル1行分の帯は他の帯と書き込み先が重ならない
+	parallelFor(tilesY_, 1, [this](size_t begin, size_t end) {
+		for (size_t tileRow = begin; tileRow < end; ++tileRow) {
+			RasterizeRows(static_cast<uint32_t>(tileRow) * kTileSize, static_cast<uint32_t>(tileRow + 1) * kTileSize);
+			UpdateTileDepths(static_cast<uint32_t>(tileRow));
+		}
+	});
+}
+
+void OcclusionBuffer::Rasterize(ThreadPool& threadPool) {
+	RasterizeParallel([&threadPool](size_t count, size_t grainSize, auto&& body) { threadPool.ParallelFor(count, grainSize, body); });
+}
+
+void OcclusionBuffer::Rasterize(JobSystem& jobSystem) {
+	RasterizeParallel([&jobSystem](size_t count, size_t grainSize, auto&& body) { jobSystem.ParallelFor("OcclusionBuffer::Rasterize", count, grainSize, body); });
+}
+
+void OcclusionBuffer::RasterizeRows(uint32_t beginRow, uint32_t endRow) {
+	const SpanFunction rasterizeSpan = GetSpanFunction();
+	for (const Triangle& triangle : triangles_) {
+		const int32_t top = std::max(triangle.minY, static_cast<int32_t>(beginRow));
+		const int32_t bottom = std::min(triangle.maxY + 1, static_cast<int32_t>(endRow));
+		if (top >= bottom) {
+			continue;
+		}
+		// 8ピクセル単位のブロックで処理する（横幅は kTileSize の倍数）
+		const uint32_t x0 = static_cast<uint32_t>(triangle.minX) & ~(kTileSize - 1);
+		const uint32_t x1 = (static_cast<uint32_t>(triangle.maxX) + kTileSize) & ~(kTileSize - 1);
+		for (int32_t y = top; y < bottom; ++y) {
+			const float py = static_cast<float>(y) + 0.5f;
+			const float rowEdge[3] = {
+			    triangle.edgeB[0] * py + triangle.edgeC[0],
+			    triangle.edgeB[1] * py + triangle.edgeC[1],
+			    triangle.edgeB[2] * py + triangle.edgeC[2],
+			};
+			rasterizeSpan(triangle.edgeA, rowEdge, triangle.depth, depths_.data() + static_cast<size_t>(y) * width_, x0, x1);
+		}
+	}
+}
+
+void OcclusionBuffer::UpdateTileDepths(uint32_t tileRow) {
+	for (uint32_t tileX = 0; tileX < tilesX_; ++tileX) {
+		float maxDepth = 0.0f;
+		for (uint32_t y = tileRow * kTileSize; y < (tileRow + 1) * kTileSize; ++y) {
+			const float* row = depths_.data() + static_cast<size_t>(y) * width_ + tileX * kTileSize;
+			for (uint32_t x = 0; x < kTileSize; ++x) {
+				maxDepth = std::max(maxDepth, row[x]);
+			}
+		}
+		tileMaxDepths_[static_cast<size_t>(tileRow) * tilesX_ + tileX] = maxDepth;
+	}
+}
+
+bool OcclusionBuffer::IsVisible(const AABB& aabb) const {
+	float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+	float minDepth = INFINITY;
+	for (int corner = 0; corner < 8; ++corner) {
+		const Vector3 p = {(corner & 1) ? aabb.max.x : aabb.min.x, (corner & 2) ? aabb.max.y : aabb.min.y, (corner & 4) ? aabb.max.z : aabb.min.z};
+		const ClipPoint clip = TransformClip(p, viewProjection_);
+		const float depth = clip.w > 0.0f ? ToLinearOrder(clip.z / clip.w) : -1.0f;
+		// ニアクリップ面をまたぐ
+		if (!(depth >= 0.0f)) {
+			return true;
+		}
+		const float invW = 1.0f / clip.w;
+		const float sx = (clip.x * invW + 1.0f) * (static_cast<float>(width_) * 0.5f);
+		const float sy = (1.0f - clip.y * invW) * (static_cast<float>(height_) * 0.5f);
+		minX = std::min(minX, sx);
+		maxX = std::max(maxX, sx);
+		minY = std::min(minY, sy);
+		maxY = std::max(maxY, sy);
+		minDepth = std::min(minDepth, depth);
+	}
+
+	// 矩形に少しでもかかるピクセルの範囲
+	const int32_t x0 = static_cast<int32_t>(std::max(std::floor(minX), 0.0f));
+	const int32_t y0 = static_cast<int32_t>(std::max(std::floor(minY), 0.0f));
+	const int32_t x1 = static_cast<int32_t>(std::min(std::ceil(maxX), static_cast<float>(width_)));
+	const int32_t y1 = static_cast<int32_t>(std::min(std::ceil(maxY), static_cast<float>(height_)));
+	if (x0 >= x1 || y0 >= y1) {
+		return true;
+	}
+
+	// タイルの最大深度より遠ければタイル全体で隠れている。そうでなければピクセルごとに調べる
+	const int32_t tileSize = static_cast<int32_t>(kTileSize);
+	for (int32_t tileY = y0 / tileSize; tileY <= (y1 - 1) / tileSize; ++tileY) {
+		for (int32_t tileX = x0 / tileSize; tileX <= (x1 - 1) / tileSize; ++tileX) {
+			if (tileMaxDepths_[static_cast<size_t>(tileY) * tilesX_ + tileX] < minDepth) {
+				continue;
+			}
+			const int32_t top = std::max(y0, tileY * tileSize);
+			const int32_t bottom = std::min(y1, (tileY + 1) * tileSize);
+			const int32_t left = std::max(x0, tileX * tileSize);
+			const int32_t right = std::min(x1, (tileX + 1) * tileSize);
+			for (int32_t y = top; y < bottom; ++y) {
+				const float* row = depths_.data() + static_cast<size_t>(y) * width_;
+				for (int32_t x = left; x < right; ++x) {
+					if (row[x] >= minDepth) {
+						return true;
+					}
+				}
+			}
+		}
+	}
+	return false;
+}
+
+void OcclusionBuffer::CullRange(const AABBSoA& b, size_t begin, size_t end, uint8_t* visible) const {
+	for (size_t i = begin; i < end; ++i) {
+		visible[i] = IsVisible(GetAABB(b, i));
+	}
+}
+
+size_t OcclusionBuffer::CullAABBs(const AABBSoA& b, std::span<uint32_t> visibleIndices) const {
+	assert(visibleIndices.size() >= b.size);
+	size_t count = 0;
+	for (size_t i = 0; i < b.size; ++i) {
+		if (IsVisible(GetAABB(b, i))) {
+			visibleIndices[count++] = static_cast<uint32_t>(i);
+		}
+	}
+	return count;
+}
+
+template<typename ParallelFor>
+size_t OcclusionBuffer::CullAABBsParallel(ParallelFor&& parallelFor, const AABBSoA& b, std::span<uint32_t> visibleIndices) const {
+	assert(visibleIndices.size() >= b.size);
+	// 判定結果は呼び出しごとに持つ（同じバッファへの判定を重ねて実行できるようにする）
+	std::vector<uint8_t> visibleFlags(b.size);
+	parallelFor(b.size, 256, [&](size_t begin, size_t end) { CullRange(b, begin, end, visibleFlags.data()); });
+	size_t count = 0;
+	for (size_t i = 0; i < b.size; ++i) {
+		if (visibleFlags[i]) {
+			visibleIndices[count++] = static_cast<uint32_t>(i);
+		}
+	}
+	return count;
+}
+
+size_t OcclusionBuffer::CullAABBs(ThreadPool& threadPool, const AABBSoA& b, std::span<uint32_t> visibleIndices) const {
+	return CullAABBsParallel([&threadPool](size_t count, size_t grainSize, auto&& body) { threadPool.ParallelFor(count, grainSize, body); }, b, visibleIndices);
+}
+
+size_t OcclusionBuffer::CullAABBs(JobSystem& jobSystem, const AABBSoA& b, std::span<uint32_t> visibleIndices) const {
+	return CullAABBsParallel(
+	    [&jobSystem](size_t count, size_t grainSize, auto&& body) { jobSystem.ParallelFor("OcclusionBuffer::CullAABBs", count, grainSize, body); }, b, visibleIndices);
+}
+
+} // namespace KamataEngine
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "math/BoundingVolume.h"
+#include "math/Matrix4x4.h"
+#include "math/Projection.h"
+#include "math/Vector3.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace KamataEngine {
+
+class JobSystem;
+class ThreadPool;
+
+/// <summary>
+/// CPU で遮蔽物を描いた低解像度の深度バッファによるオクルージョンカリング
+/// BeginFrame → AddOccluder（建物などの遮蔽物の三角形を登録）→ Rasterize → IsVisible / CullAABBs の順に使う。
+/// 深度は保守的に扱う（遮蔽物の三角形は3頂点のうち最も遠い深度で描き、境界はいちばん近い深度で判定する）ので、
+/// 見えているものを隠れていると判定することはない（ピクセル中心でのサンプリングによる1ピクセル未満の誤差を除く）。
+/// エンジンのクラスに依存しないので、ウィンドウなしで動かせる。
+/// </summary>
+class OcclusionBuffer final {
+public:
+	// 最大深度を持つタイルの大きさ（ピクセル）
+	static constexpr uint32_t kTileSize = 8;
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="width">横幅（kTileSize の倍数に切り上げる）</param>
+	/// <param name="height">高さ（kTileSize の倍数に切り上げる）</param>
+	void Initialize(uint32_t width = 320, uint32_t height = 180);
+
+	/// <summary>
+	/// 深度バッファと遮蔽物をクリアしてフレームを始める
+	/// </summary>
+	/// <param name="viewProjection">ビュー行列 * 射影行列</param>
+	/// <param name="depthMode">射影の深度の割り当て</param>
+	void BeginFrame(const Matrix4x4& viewProjection, DepthMode depthMode = DepthMode::kStandard);
+
+	/// <summary>
+	/// 遮蔽物の三角形を登録（ニアクリップ面をまたぐ三角形は描かない）
+	/// </summary>
+	/// <param name="points">頂点座標の先頭</param>
+	/// <param name="stride">頂点と頂点の間のバイト数</param>
+	/// <param name="indices">三角形リストのインデックス</param>
+	/// <param name="world">ワールド行列</param>
+	void AddOccluder(const Vector3* points, size_t stride, std::span<const uint32_t> indices, const Matrix4x4& world);
+
+	/// <summary>
+	/// 登録した遮蔽物を深度バッファに描く
+	/// </summary>
+	void Rasterize();
+
+	/// <summary>
+	/// 登録した遮蔽物を、画面を横長の帯に分けてスレッドプールで並列に描く
+	/// </summary>
+	void Rasterize(ThreadPool& threadPool);
+
+	/// <summary>
+	/// Rasterize(ThreadPool&) と同じ分け方でジョブシステムで並列に描く
+	/// </summary>
+	void Rasterize(JobSystem& jobSystem);
+
+	/// <summary>
+	/// 軸平行境界ボックスが遮蔽物に隠れていないか（画面外やニアクリップ面をまたぐものは見えているとみなす。先に視錐台カリングを行うこと）
+	/// </summary>
+	bool IsVisible(const AABB& aabb) const;
+
+	/// <summary>
+	/// 隠れていない要素の番号を visibleIndices に昇順で詰めて書き込み、その数を返す
+	/// visibleIndices の要素数は入力の要素数以上であること。
+	/// </summary>
+	size_t CullAABBs(const AABBSoA& boxes, std::span<uint32_t> visibleIndices) const;
+
+	/// <summary>
+	/// CullAABBs をスレッドプールで並列に行う（結果は CullAABBs と同じ。同じバッファに対して同時に呼んでよい）
+	/// </summary>
+	size_t CullAABBs(ThreadPool& threadPool, const AABBSoA& boxes, std::span<uint32_t> visibleIndices) const;
+
+	/// <summary>
+	/// CullAABBs をジョブシステムで並列に行う（結果は CullAABBs と同じ）
+	/// </summary>
+	size_t CullAABBs(JobSystem& jobSystem, const AABBSoA& boxes, std::span<uint32_t> visibleIndices) const;
+
+	/// <summary>
+	/// 深度バッファの取得（行ごとに GetWidth 個並ぶ。0 がニア、1 がファー。逆Z でもこの向きにそろえる）
+	/// </summary>
+	const float* GetDepths() const { return depths_.data(); }
+	uint32_t GetWidth() const { return width_; }
+	uint32_t GetHeight() const { return height_; }
+
+	/// <summary>
+	/// 登録した三角形の数（ニアクリップ面をまたぐものや裏返ったものを除く）
+	/// </summary>
+	size_t GetTriangleCount() const { return triangles_.size(); }
+
+private:
+	/// <summary>
+	/// スクリーン座標に変換した三角形（辺関数が内側で 0 以上になる向きにそろえる）
+	/// </summary>
+	struct Triangle {
+		float edgeA[3]; // 辺関数 a * x + b * y + c
+		float edgeB[3];
+		float edgeC[3];
+		float depth; // 3頂点のうち最も遠い深度
+		int32_t minX, minY, maxX, maxY;
+	};
+
+	// [beginRow, endRow) の行に全三角形を描き、タイルの最大深度を更新する
+	void RasterizeRows(uint32_t beginRow, uint32_t endRow);
+	void UpdateTileDepths(uint32_t tileRow);
+	// 深度を 0 がニアの向きにそろえる
+	float ToLinearOrder(float depth) const { return reverseZ_ ? 1.0f - depth : depth; }
+	void CullRange(const AABBSoA& boxes, size_t begin, size_t end, uint8_t* visible) const;
+	// parallelFor(count, grainSize, body) で分けて描く・判定する
+	template<typename ParallelFor> void RasterizeParallel(ParallelFor&& parallelFor);
+	template<typename ParallelFor> size_t CullAABBsParallel(ParallelFor&& parallelFor, const AABBSoA& boxes, std::span<uint32_t> visibleIndices) const;
+
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+	uint32_t tilesX_ = 0;
+	uint32_t tilesY_ = 0;
+	std::vector<float> depths_;
+	std::vector<float> tileMaxDepths_; // タイル内の最も遠い深度
+	std::vector<Triangle> triangles_;
+	Matrix4x4 viewProjection_;
+	bool reverseZ_ = false;
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,23 @@
+#include "3d/OcclusionCulling.h"
+#include "3d/Mesh.h"
+#include "3d/Model.h"
+#include "3d/WorldTransform.h"
+#include <memory>
+#include <vector>
+
+namespace KamataEngine {
+
+void AddOccluder(OcclusionBuffer& occlusionBuffer, Model& model, const WorldTransform& worldTransform) {
+	for (const std::unique_ptr<Mesh>& mesh : model.GetMeshes()) {
+		const std::vector<Mesh::VertexPosNormalUv>& vertices = mesh->GetVertices();
+		if (!vertices.empty()) {
+			occlusionBuffer.AddOccluder(&vertices.front().pos, sizeof(Mesh::VertexPosNormalUv), mesh->GetIndices(), worldTransform.matWorld_);
+		}
+	}
+}
+
+bool IsVisible(const OcclusionBuffer& occlusionBuffer, const MeshBounds& bounds, const WorldTransform& worldTransform) {
+	return occlusionBuffer.IsVisible(MathUtility::Transform(bounds.aabb, worldTransform.matWorld_));
+}
+
+} // namespace KamataEngine
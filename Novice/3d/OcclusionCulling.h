@@ -0,0 +1,17 @@
+#pragma once
+
+#include "3d/MeshBounds.h"
+#include "3d/OcclusionBuffer.h"
+
+namespace KamataEngine {
+
+class Model;
+class WorldTransform;
+
+// モデルの全メッシュの三角形を遮蔽物として登録（TransferMatrix 済みの matWorld_ を使う）
+void AddOccluder(OcclusionBuffer& occlusionBuffer, Model& model, const WorldTransform& worldTransform);
+
+// ローカル座標系の境界をワールド行列で変換し、遮蔽物に隠れていないか判定する
+bool IsVisible(const OcclusionBuffer& occlusionBuffer, const MeshBounds& bounds, const WorldTransform& worldTransform);
+
+} // namespace KamataEngine
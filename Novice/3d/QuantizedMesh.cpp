@@ -0,0 +1,220 @@
+#include "3d/QuantizedMesh.h"
+#include "3d/Model.h"
+#include "3d/ObjParser.h"
+#include "math/Quantization.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+namespace {
+
+uint32_t PositionSize(VertexFormat::Position format) { return format == VertexFormat::Position::kFloat3 ? 12u : 8u; }
+
+uint32_t NormalSize(VertexFormat::Normal format) {
+	switch (format) {
+	case VertexFormat::Normal::kOct16:
+		return 4u;
+	case VertexFormat::Normal::kOct8:
+		return 2u;
+	default:
+		return 12u;
+	}
+}
+
+uint32_t UvSize(VertexFormat::Uv format) { return format == VertexFormat::Uv::kFloat2 ? 8u : 4u; }
+
+// 量子化した軸の値を座標に戻す
+inline float DequantizeAxis(uint16_t q, float min, float max) { return min + Unorm16ToFloat(q) * (max - min); }
+
+// 座標を基準範囲内の割合にする（範囲の幅が 0 の軸は 0）
+inline float NormalizeAxis(float value, float min, float max) { return max > min ? (value - min) / (max - min) : 0.0f; }
+
+// pos, normal, uv を持つ頂点（Mesh::VertexPosNormalUv と ObjVertex）を圧縮する
+template<typename Vertex> QuantizedVertices QuantizeVertices(std::span<const Vertex> vertices, std::span<const uint32_t> indices, const VertexFormat& format) {
+	QuantizedVertices result;
+	result.format = format;
+	result.stride = GetVertexStride(format);
+	// 4バイト単位の要素を先に並べ、2バイトの Oct8 法線でも境界がずれないようにする
+	result.positionOffset = 0;
+	result.uvOffset = GetUvOffset(format);
+	result.normalOffset = GetNormalOffset(format);
+	result.bounds = vertices.empty() ? AABB{} : MakeAABB(&vertices.front().pos, vertices.size(), sizeof(Vertex));
+	result.vertexCount = vertices.size();
+	result.data.resize(vertices.size() * result.stride);
+	result.indices.assign(indices.begin(), indices.end());
+
+	const AABB& b = result.bounds;
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		const Vertex& v = vertices[i];
+		std::byte* dst = result.data.data() + i * result.stride;
+
+		if (format.position == VertexFormat::Position::kFloat3) {
+			std::memcpy(dst + result.positionOffset, &v.pos, sizeof(Vector3));
+		} else {
+			const uint16_t q[4] = {
+			    FloatToUnorm16(NormalizeAxis(v.pos.x, b.min.x, b.max.x)),
+			    FloatToUnorm16(NormalizeAxis(v.pos.y, b.min.y, b.max.y)),
+			    FloatToUnorm16(NormalizeAxis(v.pos.z, b.min.z, b.max.z)),
+			    0,
+			};
+			std::memcpy(dst + result.positionOffset, q, sizeof(q));
+		}
+
+		switch (format.uv) {
+		case VertexFormat::Uv::kFloat2:
+			std::memcpy(dst + result.uvOffset, &v.uv, sizeof(Vector2));
+			break;
+		case VertexFormat::Uv::kHalf2: {
+			const uint16_t q[2] = {FloatToHalf(v.uv.x), FloatToHalf(v.uv.y)};
+			std::memcpy(dst + result.uvOffset, q, sizeof(q));
+			break;
+		}
+		case VertexFormat::Uv::kUnorm16x2: {
+			const uint16_t q[2] = {FloatToUnorm16(v.uv.x), FloatToUnorm16(v.uv.y)};
+			std::memcpy(dst + result.uvOffset, q, sizeof(q));
+			break;
+		}
+		}
+
+		switch (format.normal) {
+		case VertexFormat::Normal::kFloat3:
+			std::memcpy(dst + result.normalOffset, &v.normal, sizeof(Vector3));
+			break;
+		case VertexFormat::Normal::kOct16: {
+			const uint32_t q = EncodeNormalOct16(v.normal);
+			std::memcpy(dst + result.normalOffset, &q, sizeof(q));
+			break;
+		}
+		case VertexFormat::Normal::kOct8: {
+			const uint16_t q = EncodeNormalOct8(v.normal);
+			std::memcpy(dst + result.normalOffset, &q, sizeof(q));
+			break;
+		}
+		}
+	}
+	return result;
+}
+
+} // namespace
+
+uint32_t GetVertexStride(const VertexFormat& format) { return (PositionSize(format.position) + UvSize(format.uv) + NormalSize(format.normal) + 3u) & ~3u; }
+
+uint32_t GetUvOffset(const VertexFormat& format) { return PositionSize(format.position); }
+
+uint32_t GetNormalOffset(const VertexFormat& format) { return PositionSize(format.position) + UvSize(format.uv); }
+
+
+QuantizedVertices Quantize(std::span<const Mesh::VertexPosNormalUv> vertices, std::span<const uint32_t> indices, const VertexFormat& format) {
+	return QuantizeVertices(vertices, indices, format);
+}
+
+QuantizedVertices Quantize(const ObjMesh& mesh, const VertexFormat& format) { return QuantizeVertices(std::span<const ObjVertex>(mesh.vertices), mesh.indices, format); }
+
+QuantizedVertices Quantize(Mesh& mesh, const VertexFormat& format) { return Quantize(mesh.GetVertices(), mesh.GetIndices(), format); }
+
+std::vector<QuantizedVertices> Quantize(Model& model, const VertexFormat& format) {
+	std::vector<QuantizedVertices> meshes;
+	for (const std::unique_ptr<Mesh>& mesh : model.GetMeshes()) {
+		meshes.push_back(Quantize(*mesh, format));
+	}
+	return meshes;
+}
+
+Mesh::VertexPosNormalUv Dequantize(const QuantizedVertices& vertices, size_t index) {
+	assert(index < vertices.vertexCount);
+	const VertexFormat& format = vertices.format;
+	const std::byte* src = vertices.data.data() + index * vertices.stride;
+	Mesh::VertexPosNormalUv v;
+
+	if (format.position == VertexFormat::Position::kFloat3) {
+		std::memcpy(&v.pos, src + vertices.positionOffset, sizeof(Vector3));
+	} else {
+		uint16_t q[4];
+		std::memcpy(q, src + vertices.positionOffset, sizeof(q));
+		const AABB& b = vertices.bounds;
+		v.pos = {DequantizeAxis(q[0], b.min.x, b.max.x), DequantizeAxis(q[1], b.min.y, b.max.y), DequantizeAxis(q[2], b.min.z, b.max.z)};
+	}
+
+	switch (format.uv) {
+	case VertexFormat::Uv::kFloat2:
+		std::memcpy(&v.uv, src + vertices.uvOffset, sizeof(Vector2));
+		break;
+	case VertexFormat::Uv::kHalf2: {
+		uint16_t q[2];
+		std::memcpy(q, src + vertices.uvOffset, sizeof(q));
+		v.uv = {HalfToFloat(q[0]), HalfToFloat(q[1])};
+		break;
+	}
+	case VertexFormat::Uv::kUnorm16x2: {
+		uint16_t q[2];
+		std::memcpy(q, src + vertices.uvOffset, sizeof(q));
+		v.uv = {Unorm16ToFloat(q[0]), Unorm16ToFloat(q[1])};
+		break;
+	}
+	}
+
+	switch (format.normal) {
+	case VertexFormat::Normal::kFloat3:
+		std::memcpy(&v.normal, src + vertices.normalOffset, sizeof(Vector3));
+		break;
+	case VertexFormat::Normal::kOct16: {
+		uint32_t q;
+		std::memcpy(&q, src + vertices.normalOffset, sizeof(q));
+		v.normal = DecodeNormalOct16(q);
+		break;
+	}
+	case VertexFormat::Normal::kOct8: {
+		uint16_t q;
+		std::memcpy(&q, src + vertices.normalOffset, sizeof(q));
+		v.normal = DecodeNormalOct8(q);
+		break;
+	}
+	}
+	return v;
+}
+
+void Dequantize(const QuantizedVertices& vertices, std::span<Mesh::VertexPosNormalUv> dst) {
+	assert(dst.size() >= vertices.vertexCount);
+	for (size_t i = 0; i < vertices.vertexCount; ++i) {
+		dst[i] = Dequantize(vertices, i);
+	}
+}
+
+QuantizationError MeasureQuantizationError(std::span<const Mesh::VertexPosNormalUv> original, const QuantizedVertices& vertices) {
+	assert(original.size() == vertices.vertexCount);
+	QuantizationError error = {};
+	double sumSq = 0.0;
+	for (size_t i = 0; i < original.size(); ++i) {
+		const Mesh::VertexPosNormalUv& a = original[i];
+		const Mesh::VertexPosNormalUv b = Dequantize(vertices, i);
+
+		const float dx = a.pos.x - b.pos.x;
+		const float dy = a.pos.y - b.pos.y;
+		const float dz = a.pos.z - b.pos.z;
+		const float distanceSq = dx * dx + dy * dy + dz * dz;
+		error.maxPosition = std::max(error.maxPosition, std::sqrt(distanceSq));
+		sumSq += distanceSq;
+
+		// 元の法線が正規化されていない場合に備えて方向だけを比べる
+		const float lengthA = std::sqrt(a.normal.x * a.normal.x + a.normal.y * a.normal.y + a.normal.z * a.normal.z);
+		const float lengthB = std::sqrt(b.normal.x * b.normal.x + b.normal.y * b.normal.y + b.normal.z * b.normal.z);
+		if (lengthA > 0.0f && lengthB > 0.0f) {
+			const float cosine = (a.normal.x * b.normal.x + a.normal.y * b.normal.y + a.normal.z * b.normal.z) / (lengthA * lengthB);
+			error.maxNormalAngle = std::max(error.maxNormalAngle, std::acos(std::clamp(cosine, -1.0f, 1.0f)));
+		}
+
+		error.maxUv = std::max({error.maxUv, std::fabs(a.uv.x - b.uv.x), std::fabs(a.uv.y - b.uv.y)});
+	}
+	error.rmsPosition = original.empty() ? 0.0f : static_cast<float>(std::sqrt(sumSq / static_cast<double>(original.size())));
+	return error;
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "3d/Mesh.h"
+#include "math/BoundingVolume.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace KamataEngine {
+
+class Model;
+struct ObjMesh;
+
+/// <summary>
+/// 頂点の各要素の格納形式
+/// </summary>
+struct VertexFormat final {
+	// 座標の形式
+	enum class Position {
+		kFloat3,    // float x 3（12バイト）
+		kUnorm16x4, // メッシュの AABB を基準にした 16bit 正規化整数 x 3 + 未使用 1（8バイト）
+	};
+	// 法線の形式
+	enum class Normal {
+		kFloat3, // float x 3（12バイト）
+		kOct16,  // 八面体写像 16bit x 2（4バイト）
+		kOct8,   // 八面体写像 8bit x 2（2バイト）
+	};
+	// uv の形式
+	enum class Uv {
+		kFloat2,    // float x 2（8バイト）
+		kHalf2,     // 半精度浮動小数点数 x 2（4バイト。タイリング用に [0, 1] の外も表せる）
+		kUnorm16x2, // 16bit 正規化整数 x 2（4バイト。[0, 1] に丸め込む）
+	};
+
+	Position position = Position::kUnorm16x4;
+	Normal normal = Normal::kOct16;
+	Uv uv = Uv::kHalf2;
+};
+
+// Mesh::VertexPosNormalUv と同じ形式
+inline constexpr VertexFormat kFullVertexFormat = {VertexFormat::Position::kFloat3, VertexFormat::Normal::kFloat3, VertexFormat::Uv::kFloat2};
+// 静的メッシュ用の圧縮形式（16バイト）
+inline constexpr VertexFormat kCompactVertexFormat = {};
+
+/// <summary>
+/// 圧縮した頂点データ
+/// </summary>
+struct QuantizedVertices final {
+	VertexFormat format;         // 格納形式
+	uint32_t stride;             // 頂点1つのバイト数（4の倍数）
+	uint32_t positionOffset;     // 頂点内の座標のバイト位置
+	uint32_t normalOffset;       // 頂点内の法線のバイト位置
+	uint32_t uvOffset;           // 頂点内の uv のバイト位置
+	AABB bounds;                 // 座標の量子化の基準（シェーダーでは min + q * (max - min) で復元する）
+	size_t vertexCount;          // 頂点数
+	std::vector<std::byte> data; // 頂点データ
+	std::vector<uint32_t> indices;
+};
+
+/// <summary>
+/// 圧縮による誤差
+/// </summary>
+struct QuantizationError final {
+	float maxPosition;    // 座標の最大誤差（距離）
+	float rmsPosition;    // 座標の二乗平均平方根誤差
+	float maxNormalAngle; // 法線の最大角度誤差 [rad]
+	float maxUv;          // uv の最大誤差（成分ごと）
+};
+
+namespace MathUtility {
+
+// 頂点のバイト数を求める
+uint32_t GetVertexStride(const VertexFormat& format);
+// 頂点内の uv と法線のバイト位置を求める（座標は常に先頭。4バイト単位の要素を先に並べる）
+uint32_t GetUvOffset(const VertexFormat& format);
+uint32_t GetNormalOffset(const VertexFormat& format);
+
+// 頂点データを圧縮する
+QuantizedVertices Quantize(std::span<const Mesh::VertexPosNormalUv> vertices, std::span<const uint32_t> indices, const VertexFormat& format);
+// ObjParser で読み込んだメッシュの頂点データを圧縮する（エンジンの float の頂点バッファを作らずに済む）
+QuantizedVertices Quantize(const ObjMesh& mesh, const VertexFormat& format);
+// メッシュの頂点データを圧縮する
+QuantizedVertices Quantize(Mesh& mesh, const VertexFormat& format);
+// モデルの全メッシュの頂点データを圧縮する
+// Model::CreateFromOBJ が作った float の頂点バッファはモデルに残るので、頂点メモリは減らない（誤差の確認用）。
+std::vector<QuantizedVertices> Quantize(Model& model, const VertexFormat& format);
+
+// 圧縮した頂点を1つ復元する
+Mesh::VertexPosNormalUv Dequantize(const QuantizedVertices& vertices, size_t index);
+// 圧縮した頂点をすべて復元する（dst の要素数は vertexCount 以上であること）
+void Dequantize(const QuantizedVertices& vertices, std::span<Mesh::VertexPosNormalUv> dst);
+
+// 元の頂点データとの誤差を求める（original は Quantize に渡したものと同じであること）
+QuantizationError MeasureQuantizationError(std::span<const Mesh::VertexPosNormalUv> original, const QuantizedVertices& vertices);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
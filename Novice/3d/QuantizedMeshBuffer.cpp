@@ -0,0 +1,95 @@
+#include "3d/QuantizedMeshBuffer.h"
+#include <cassert>
+#include <cstring>
+#include <d3dx12.h>
+
+namespace KamataEngine {
+
+namespace {
+
+DXGI_FORMAT ToDxgiFormat(VertexFormat::Position format) {
+	return format == VertexFormat::Position::kFloat3 ? DXGI_FORMAT_R32G32B32_FLOAT : DXGI_FORMAT_R16G16B16A16_UNORM;
+}
+
+DXGI_FORMAT ToDxgiFormat(VertexFormat::Normal format) {
+	switch (format) {
+	case VertexFormat::Normal::kOct16:
+		return DXGI_FORMAT_R16G16_SNORM;
+	case VertexFormat::Normal::kOct8:
+		return DXGI_FORMAT_R8G8_SNORM;
+	default:
+		return DXGI_FORMAT_R32G32B32_FLOAT;
+	}
+}
+
+DXGI_FORMAT ToDxgiFormat(VertexFormat::Uv format) {
+	switch (format) {
+	case VertexFormat::Uv::kHalf2:
+		return DXGI_FORMAT_R16G16_FLOAT;
+	case VertexFormat::Uv::kUnorm16x2:
+		return DXGI_FORMAT_R16G16_UNORM;
+	default:
+		return DXGI_FORMAT_R32G32_FLOAT;
+	}
+}
+
+// Mesh::CreateBuffers と同じく、アップロードヒープに作って書き込む
+Microsoft::WRL::ComPtr<ID3D12Resource> CreateUploadBuffer(ID3D12Device* device, const void* data, size_t size) {
+	Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+	HRESULT result;
+
+	CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+	result = device->CreateCommittedResource(
+	    &heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer));
+	assert(SUCCEEDED(result));
+
+	void* mapped = nullptr;
+	result = buffer->Map(0, nullptr, &mapped);
+	assert(SUCCEEDED(result));
+	std::memcpy(mapped, data, size);
+	buffer->Unmap(0, nullptr);
+	return buffer;
+}
+
+} // namespace
+
+void QuantizedMeshBuffer::Create(ID3D12Device* device, const QuantizedVertices& vertices) {
+	assert(device);
+	assert(!vertices.data.empty() && !vertices.indices.empty());
+
+	const size_t vertexBytes = vertices.data.size();
+	const size_t indexBytes = vertices.indices.size() * sizeof(uint32_t);
+	vertBuff_ = CreateUploadBuffer(device, vertices.data.data(), vertexBytes);
+	indexBuff_ = CreateUploadBuffer(device, vertices.indices.data(), indexBytes);
+
+	vbView_.BufferLocation = vertBuff_->GetGPUVirtualAddress();
+	vbView_.SizeInBytes = static_cast<UINT>(vertexBytes);
+	vbView_.StrideInBytes = vertices.stride;
+
+	ibView_.BufferLocation = indexBuff_->GetGPUVirtualAddress();
+	ibView_.Format = DXGI_FORMAT_R32_UINT;
+	ibView_.SizeInBytes = static_cast<UINT>(indexBytes);
+	indexCount_ = static_cast<UINT>(vertices.indices.size());
+
+	const AABB& b = vertices.bounds;
+	constants_.boundsMin = b.min;
+	constants_.boundsExtent = {b.max.x - b.min.x, b.max.y - b.min.y, b.max.z - b.min.z};
+}
+
+void QuantizedMeshBuffer::Draw(ID3D12GraphicsCommandList* commandList) const {
+	assert(commandList && indexCount_ > 0);
+	commandList->IASetVertexBuffers(0, 1, &vbView_);
+	commandList->IASetIndexBuffer(&ibView_);
+	commandList->DrawIndexedInstanced(indexCount_, 1, 0, 0, 0);
+}
+
+std::array<D3D12_INPUT_ELEMENT_DESC, QuantizedMeshBuffer::kInputElementCount> QuantizedMeshBuffer::GetInputElements(const VertexFormat& format) {
+	return {{
+	    {"POSITION", 0, ToDxgiFormat(format.position), 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, ToDxgiFormat(format.uv), 0, MathUtility::GetUvOffset(format), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"NORMAL", 0, ToDxgiFormat(format.normal), 0, MathUtility::GetNormalOffset(format), D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	}};
+}
+
+} // namespace KamataEngine
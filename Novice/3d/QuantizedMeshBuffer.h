@@ -0,0 +1,82 @@
+#pragma once
+
+#include "3d/QuantizedMesh.h"
+#include "math/Vector3.h"
+#include <array>
+#include <d3d12.h>
+#include <wrl.h>
+
+namespace KamataEngine {
+
+/// <summary>
+/// 圧縮した座標を頂点シェーダーで復元するための定数（ConstantBufferRing::Push でそのまま書き込める）
+/// </summary>
+struct QuantizedMeshConstants final {
+	Vector3 boundsMin;    // 量子化の基準の最小点
+	float padding0;
+	Vector3 boundsExtent; // 量子化の基準の大きさ（max - min）
+	float padding1;
+};
+
+/// <summary>
+/// 圧縮した頂点データの頂点バッファとインデックスバッファ
+/// 頂点は VertexFormat の形式のまま入力アセンブラに渡し、頂点シェーダーで次のように復元する。
+/// 座標 kUnorm16x4: boundsMin + position.xyz * boundsExtent（QuantizedMeshConstants）
+/// 法線 kOct16 / kOct8: SNORM で読んだ xy を八面体写像から展開して正規化（MathUtility::OctahedralDecode と同じ）
+/// uv kHalf2 / kUnorm16x2: float2 としてそのまま読める
+/// 生成後は QuantizedVertices の CPU 側のデータを捨ててよい。
+/// </summary>
+class QuantizedMeshBuffer final {
+public:
+	// 入力レイアウトの要素数（POSITION, TEXCOORD, NORMAL）
+	static constexpr size_t kInputElementCount = 3;
+
+	/// <summary>
+	/// 頂点バッファとインデックスバッファを生成して、頂点データを書き込む
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	/// <param name="vertices">圧縮した頂点データ</param>
+	void Create(ID3D12Device* device, const QuantizedVertices& vertices);
+
+	/// <summary>
+	/// 頂点バッファとインデックスバッファを設定して描画（ルートパラメータは呼び出し側で設定する）
+	/// </summary>
+	/// <param name="commandList">命令発行先コマンドリスト</param>
+	void Draw(ID3D12GraphicsCommandList* commandList) const;
+
+	/// <summary>
+	/// 頂点バッファ取得
+	/// </summary>
+	const D3D12_VERTEX_BUFFER_VIEW& GetVBView() const { return vbView_; }
+
+	/// <summary>
+	/// インデックスバッファ取得
+	/// </summary>
+	const D3D12_INDEX_BUFFER_VIEW& GetIBView() const { return ibView_; }
+
+	/// <summary>
+	/// インデックス数を取得
+	/// </summary>
+	UINT GetIndexCount() const { return indexCount_; }
+
+	/// <summary>
+	/// 座標の復元用の定数を取得
+	/// </summary>
+	const QuantizedMeshConstants& GetConstants() const { return constants_; }
+
+	/// <summary>
+	/// 形式に合わせた入力レイアウト（パイプラインの生成に使う。セマンティクスは Mesh::VertexPosNormalUv 用のシェーダーと同じ）
+	/// </summary>
+	/// <param name="format">頂点の格納形式</param>
+	static std::array<D3D12_INPUT_ELEMENT_DESC, kInputElementCount> GetInputElements(const VertexFormat& format);
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12Resource> vertBuff_;
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuff_;
+	D3D12_VERTEX_BUFFER_VIEW vbView_ = {};
+	D3D12_INDEX_BUFFER_VIEW ibView_ = {};
+	UINT indexCount_ = 0;
+	QuantizedMeshConstants constants_ = {};
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,313 @@
+#include "3d/TransformHierarchy.h"
+#include "3d/WorldTransform.h"
+#include "base/JobSystem.h"
+#include "base/ThreadPool.h"
+#include "math/AffineMatrix.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+namespace KamataEngine {
+
+namespace {
+
+using MathUtility::operator*;
+
+inline bool IsEqual(const Vector3& v1, const Vector3& v2) { return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z; }
+
+// order[新しい位置] = 元の位置 の順に並べ直す
+template<typename T> void Permute(std::vector<T>& values, const std::vector<uint32_t>& order) {
+	std::vector<T> sorted;
+	sorted.reserve(order.size());
+	for (uint32_t index : order) {
+		sorted.push_back(values[index]);
+	}
+	values.swap(sorted);
+}
+
+} // namespace
+
+uint32_t TransformHierarchy::Create(uint32_t parent) {
+	const uint32_t parentIndex = parent == kInvalidNode ? kInvalidNode : IndexOf(parent);
+
+	uint32_t node;
+	if (freeNodes_.empty()) {
+		node = static_cast<uint32_t>(indices_.size());
+		indices_.push_back(0);
+	} else {
+		node = freeNodes_.back();
+		freeNodes_.pop_back();
+	}
+	indices_[node] = static_cast<uint32_t>(nodes_.size());
+
+	// 末尾に追加しても親より後ろになるが、深さごとにまとめるため並べ直しを予約する
+	nodes_.push_back(node);
+	parents_.push_back(parentIndex);
+	scales_.push_back({1.0f, 1.0f, 1.0f});
+	rotations_.push_back({0.0f, 0.0f, 0.0f});
+	translations_.push_back({0.0f, 0.0f, 0.0f});
+	worldMatrices_.push_back(MathUtility::MakeAffineMatrix3x4(scales_.back(), rotations_.back(), translations_.back()));
+	bindings_.push_back(nullptr);
+	dirtyFlags_.push_back(1);
+	worldChanged_.push_back(0);
+	needsSort_ = true;
+	return node;
+}
+
+uint32_t TransformHierarchy::Add(WorldTransform& worldTransform) {
+	const uint32_t parent = worldTransform.parent_ ? Find(*worldTransform.parent_) : kInvalidNode;
+	const uint32_t node = Create(parent);
+	Bind(node, &worldTransform);
+	return node;
+}
+
+void TransformHierarchy::Destroy(uint32_t node) {
+	SortIfNeeded();
+	const uint32_t root = IndexOf(node);
+
+	// 親が子より前に並んでいるので、前から見れば子孫を1回のループで判定できる
+	std::vector<bool> removed(nodes_.size(), false);
+	std::vector<uint32_t> order;
+	order.reserve(nodes_.size());
+	for (uint32_t i = 0; i < nodes_.size(); ++i) {
+		removed[i] = i == root || (parents_[i] != kInvalidNode && removed[parents_[i]]);
+		if (!removed[i]) {
+			order.push_back(i);
+			continue;
+		}
+		if (bindings_[i]) {
+			boundNodes_.erase(bindings_[i]);
+		}
+		indices_[nodes_[i]] = kInvalidNode;
+		freeNodes_.push_back(nodes_[i]);
+	}
+	Reorder(order);
+	// 詰めただけなので親子の順序は保たれているが、深さごとの先頭位置を求め直す
+	needsSort_ = true;
+}
+
+void TransformHierarchy::Clear() {
+	indices_.clear();
+	freeNodes_.clear();
+	nodes_.clear();
+	parents_.clear();
+	scales_.clear();
+	rotations_.clear();
+	translations_.clear();
+	worldMatrices_.clear();
+	bindings_.clear();
+	dirtyFlags_.clear();
+	worldChanged_.clear();
+	depthOffsets_.clear();
+	boundNodes_.clear();
+	needsSort_ = false;
+}
+
+void TransformHierarchy::SetParent(uint32_t node, uint32_t parent) {
+	const uint32_t index = IndexOf(node);
+	const uint32_t parentIndex = parent == kInvalidNode ? kInvalidNode : IndexOf(parent);
+#ifdef _DEBUG
+	// 自身の子孫を親にすると循環する
+	for (uint32_t i = parentIndex; i != kInvalidNode; i = parents_[i]) {
+		assert(i != index);
+	}
+#endif
+	parents_[index] = parentIndex;
+	dirtyFlags_[index] = 1;
+	needsSort_ = true;
+}
+
+uint32_t TransformHierarchy::GetParent(uint32_t node) const {
+	const uint32_t parentIndex = parents_[IndexOf(node)];
+	return parentIndex == kInvalidNode ? kInvalidNode : nodes_[parentIndex];
+}
+
+void TransformHierarchy::Bind(uint32_t node, WorldTransform* worldTransform) {
+	const uint32_t index = IndexOf(node);
+	if (bindings_[index]) {
+		boundNodes_.erase(bindings_[index]);
+	}
+	bindings_[index] = worldTransform;
+	if (worldTransform) {
+		boundNodes_[worldTransform] = node;
+		// 結び付けた直後は一度転送する
+		dirtyFlags_[index] = 1;
+	}
+}
+
+uint32_t TransformHierarchy::Find(const WorldTransform& worldTransform) const {
+	auto it = boundNodes_.find(&worldTransform);
+	return it == boundNodes_.end() ? kInvalidNode : it->second;
+}
+
+void TransformHierarchy::SetScale(uint32_t node, const Vector3& scale) {
+	const uint32_t index = IndexOf(node);
+	scales_[index] = scale;
+	dirtyFlags_[index] = 1;
+}
+
+void TransformHierarchy::SetRotation(uint32_t node, const Vector3& rotation) {
+	const uint32_t index = IndexOf(node);
+	rotations_[index] = rotation;
+	dirtyFlags_[index] = 1;
+}
+
+void TransformHierarchy::SetTranslation(uint32_t node, const Vector3& translation) {
+	const uint32_t index = IndexOf(node);
+	translations_[index] = translation;
+	dirtyFlags_[index] = 1;
+}
+
+const Vector3& TransformHierarchy::GetScale(uint32_t node) const { return scales_[IndexOf(node)]; }
+
+const Vector3& TransformHierarchy::GetRotation(uint32_t node) const { return rotations_[IndexOf(node)]; }
+
+const Vector3& TransformHierarchy::GetTranslation(uint32_t node) const { return translations_[IndexOf(node)]; }
+
+void TransformHierarchy::MarkDirty(uint32_t node) { dirtyFlags_[IndexOf(node)] = 1; }
+
+Matrix4x4 TransformHierarchy::GetWorldMatrix(uint32_t node) const { return MathUtility::MakeMatrix4x4(worldMatrices_[IndexOf(node)]); }
+
+void TransformHierarchy::Update() {
+	SortIfNeeded();
+	stats_ = {nodes_.size(), 0, 0};
+	UpdateRange(0, nodes_.size(), stats_);
+}
+
+template<typename ParallelFor> void TransformHierarchy::UpdateParallel(ParallelFor&& parallelFor) {
+	SortIfNeeded();
+	stats_ = {nodes_.size(), 0, 0};
+
+	// 前の深さがすべて終わってから次の深さを処理する（ParallelFor が全範囲の完了まで戻らない）
+	std::atomic<size_t> recomputed = 0;
+	std::atomic<size_t> transferred = 0;
+	for (size_t depth = 0; depth + 1 < depthOffsets_.size(); ++depth) {
+		const size_t begin = depthOffsets_[depth];
+		const size_t end = depthOffsets_[depth + 1];
+		if (end - begin < parallelThreshold_) {
+			UpdateRange(begin, end, stats_);
+			continue;
+		}
+		parallelFor(end - begin, parallelThreshold_, [&](size_t chunkBegin, size_t chunkEnd) {
+			TransformUpdateStats chunkStats;
+			UpdateRange(begin + chunkBegin, begin + chunkEnd, chunkStats);
+			recomputed.fetch_add(chunkStats.recomputed, std::memory_order_relaxed);
+			transferred.fetch_add(chunkStats.transferred, std::memory_order_relaxed);
+		});
+	}
+	stats_.recomputed += recomputed.load(std::memory_order_relaxed);
+	stats_.transferred += transferred.load(std::memory_order_relaxed);
+}
+
+void TransformHierarchy::Update(ThreadPool& threadPool) {
+	UpdateParallel([&threadPool](size_t count, size_t grainSize, auto&& body) { threadPool.ParallelFor(count, grainSize, body); });
+}
+
+void TransformHierarchy::Update(JobSystem& jobSystem) {
+	UpdateParallel([&jobSystem](size_t count, size_t grainSize, auto&& body) { jobSystem.ParallelFor("TransformHierarchy::Update", count, grainSize, body); });
+}
+
+void TransformHierarchy::UpdateRange(size_t begin, size_t end, TransformUpdateStats& stats) {
+	for (size_t i = begin; i < end; ++i) {
+		// 結び付けたワールド変換は前回読み取った値と比べて変更を検出する
+		WorldTransform* binding = bindings_[i];
+		if (binding && !(IsEqual(scales_[i], binding->scale_) && IsEqual(rotations_[i], binding->rotation_) && IsEqual(translations_[i], binding->translation_))) {
+			scales_[i] = binding->scale_;
+			rotations_[i] = binding->rotation_;
+			translations_[i] = binding->translation_;
+			dirtyFlags_[i] = 1;
+		}
+
+		// 親は必ず前にあるので、親の変更の有無とワールド行列は確定している
+		const uint32_t parent = parents_[i];
+		const bool changed = dirtyFlags_[i] || (parent != kInvalidNode && worldChanged_[parent]);
+		dirtyFlags_[i] = 0;
+		worldChanged_[i] = changed;
+		if (!changed) {
+			continue;
+		}
+
+		const Matrix3x4 local = MathUtility::MakeAffineMatrix3x4(scales_[i], rotations_[i], translations_[i]);
+		worldMatrices_[i] = parent == kInvalidNode ? local : local * worldMatrices_[parent];
+		++stats.recomputed;
+
+		if (binding) {
+			binding->matWorld_ = MathUtility::MakeMatrix4x4(worldMatrices_[i]);
+			binding->TransferMatrix();
+			++stats.transferred;
+		}
+	}
+}
+
+void TransformHierarchy::SortIfNeeded() {
+	if (!needsSort_) {
+		return;
+	}
+	needsSort_ = false;
+
+	// 深さを求める（親子関係の変更後は親が後ろにあることもあるので、根までたどって決める）
+	const size_t count = nodes_.size();
+	std::vector<uint32_t> depths(count, kInvalidNode);
+	std::vector<uint32_t> path;
+	uint32_t maxDepth = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		uint32_t j = i;
+		while (depths[j] == kInvalidNode && parents_[j] != kInvalidNode) {
+			path.push_back(j);
+			j = parents_[j];
+		}
+		if (depths[j] == kInvalidNode) {
+			depths[j] = 0;
+		}
+		uint32_t depth = depths[j];
+		while (!path.empty()) {
+			depths[path.back()] = ++depth;
+			path.pop_back();
+		}
+		maxDepth = std::max(maxDepth, depths[i]);
+	}
+
+	// 深さで安定な計数ソートを行う
+	depthOffsets_.assign(count == 0 ? 1 : maxDepth + 2, 0);
+	for (uint32_t i = 0; i < count; ++i) {
+		++depthOffsets_[depths[i] + 1];
+	}
+	for (size_t d = 1; d < depthOffsets_.size(); ++d) {
+		depthOffsets_[d] += depthOffsets_[d - 1];
+	}
+	std::vector<uint32_t> order(count);
+	std::vector<uint32_t> cursors(depthOffsets_.begin(), depthOffsets_.end() - 1);
+	for (uint32_t i = 0; i < count; ++i) {
+		order[cursors[depths[i]]++] = i;
+	}
+	Reorder(order);
+}
+
+void TransformHierarchy::Reorder(const std::vector<uint32_t>& order) {
+	std::vector<uint32_t> newIndices(nodes_.size(), kInvalidNode);
+	for (uint32_t i = 0; i < order.size(); ++i) {
+		newIndices[order[i]] = i;
+	}
+	Permute(nodes_, order);
+	Permute(parents_, order);
+	Permute(scales_, order);
+	Permute(rotations_, order);
+	Permute(translations_, order);
+	Permute(worldMatrices_, order);
+	Permute(bindings_, order);
+	Permute(dirtyFlags_, order);
+	Permute(worldChanged_, order);
+	for (uint32_t i = 0; i < nodes_.size(); ++i) {
+		indices_[nodes_[i]] = i;
+		if (parents_[i] != kInvalidNode) {
+			parents_[i] = newIndices[parents_[i]];
+		}
+	}
+}
+
+uint32_t TransformHierarchy::IndexOf(uint32_t node) const {
+	assert(node < indices_.size() && indices_[node] != kInvalidNode);
+	return indices_[node];
+}
+
+} // namespace KamataEngine
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "math/Matrix3x4.h"
+#include "math/Matrix4x4.h"
+#include "math/Vector3.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace KamataEngine {
+
+class JobSystem;
+class ThreadPool;
+class WorldTransform;
+
+/// <summary>
+/// TransformHierarchy::Update 1回分の統計
+/// </summary>
+struct TransformUpdateStats final {
+	size_t nodeCount = 0;   // 全ノード数
+	size_t recomputed = 0;  // ワールド行列を計算し直したノード数
+	size_t transferred = 0; // TransferMatrix を呼んだワールド変換の数
+};
+
+/// <summary>
+/// 親子関係のあるワールド変換をまとめて更新する階層
+/// ローカルの SRT とワールド行列を深さ順（親が必ず子より前）の連続した配列で保持し、
+/// Update の1回の前から順のループで全ノードのワールド行列を求める。
+/// SRT が変わったノードとその子孫だけを計算し直し、変わったワールド変換だけを転送する。
+/// </summary>
+class TransformHierarchy final {
+public:
+	// 無効なノード番号（親なしを表す）
+	static constexpr uint32_t kInvalidNode = UINT32_MAX;
+
+	/// <summary>
+	/// ノードを作成
+	/// </summary>
+	/// <param name="parent">親ノード（kInvalidNode ならルート）</param>
+	/// <returns>ノード番号（破棄するまで変わらない）</returns>
+	uint32_t Create(uint32_t parent = kInvalidNode);
+
+	/// <summary>
+	/// ワールド変換のノードを作成して結び付ける（parent_ が結び付け済みなら、そのノードを親にする）
+	/// </summary>
+	/// <param name="worldTransform">ワールド変換（破棄するまで有効であること）</param>
+	/// <returns>ノード番号</returns>
+	uint32_t Add(WorldTransform& worldTransform);
+
+	/// <summary>
+	/// ノードとその子孫をすべて破棄
+	/// </summary>
+	void Destroy(uint32_t node);
+
+	/// <summary>
+	/// すべてのノードを破棄
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 親を変更
+	/// </summary>
+	/// <param name="node">ノード</param>
+	/// <param name="parent">新しい親（kInvalidNode ならルート。node の子孫でないこと）</param>
+	void SetParent(uint32_t node, uint32_t parent);
+
+	/// <summary>
+	/// 親を取得
+	/// </summary>
+	uint32_t GetParent(uint32_t node) const;
+
+	/// <summary>
+	/// ワールド変換を結び付ける
+	/// 結び付けたノードは Update のたびに worldTransform の scale_, rotation_, translation_ を読み取り、
+	/// 前回から変わっていれば（または祖先が変わっていれば）ワールド行列を matWorld_ に書き込んで TransferMatrix を呼ぶ。
+	/// </summary>
+	/// <param name="node">ノード</param>
+	/// <param name="worldTransform">ワールド変換（nullptr なら結び付けを解除）</param>
+	void Bind(uint32_t node, WorldTransform* worldTransform);
+
+	/// <summary>
+	/// ワールド変換が結び付いたノードを探す
+	/// </summary>
+	/// <returns>ノード番号（見つからなければ kInvalidNode）</returns>
+	uint32_t Find(const WorldTransform& worldTransform) const;
+
+	/// <summary>
+	/// ローカルの SRT の設定・取得（結び付けたノードはワールド変換の値で上書きされる）
+	/// </summary>
+	void SetScale(uint32_t node, const Vector3& scale);
+	void SetRotation(uint32_t node, const Vector3& rotation);
+	void SetTranslation(uint32_t node, const Vector3& translation);
+	const Vector3& GetScale(uint32_t node) const;
+	const Vector3& GetRotation(uint32_t node) const;
+	const Vector3& GetTranslation(uint32_t node) const;
+
+	/// <summary>
+	/// 次の Update でノードとその子孫を計算し直す
+	/// </summary>
+	void MarkDirty(uint32_t node);
+
+	/// <summary>
+	/// ワールド行列を取得（最後の Update の結果）
+	/// </summary>
+	Matrix4x4 GetWorldMatrix(uint32_t node) const;
+
+	/// <summary>
+	/// 変更のあったノードと子孫のワールド行列を更新
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// 変更のあったノードと子孫のワールド行列をスレッドプールで並列に更新
+	/// 同じ深さのノードは互いに依存しないので、深さごとに分割して処理する。
+	/// ノード数が並列化の閾値未満の深さは呼び出し元のスレッドだけで処理する。
+	/// 結び付けたワールド変換の TransferMatrix もワーカースレッドから呼ばれる。
+	/// </summary>
+	/// <param name="threadPool">スレッドプール</param>
+	void Update(ThreadPool& threadPool);
+
+	/// <summary>
+	/// 変更のあったノードと子孫のワールド行列をジョブシステムで並列に更新（分け方は ThreadPool 版と同じ）
+	/// </summary>
+	/// <param name="jobSystem">ジョブシステム</param>
+	void Update(JobSystem& jobSystem);
+
+	/// <summary>
+	/// 並列化の閾値を設定（1つの深さのノード数がこれ未満なら分割しない。分割の単位にも使う）
+	/// </summary>
+	void SetParallelThreshold(size_t threshold) { parallelThreshold_ = threshold > 0 ? threshold : 1; }
+
+	/// <summary>
+	/// 最後の Update の統計を取得
+	/// </summary>
+	const TransformUpdateStats& GetStats() const { return stats_; }
+
+	/// <summary>
+	/// ノード数を取得
+	/// </summary>
+	size_t GetNodeCount() const { return nodes_.size(); }
+
+private:
+	// 親子関係が変わっていれば深さ順に並べ直す
+	void SortIfNeeded();
+	// order[新しい位置] = 元の位置 の順に配列を並べ直す（order にない要素は取り除く）
+	void Reorder(const std::vector<uint32_t>& order);
+	// [begin, end) のノードを更新して、統計に加える
+	void UpdateRange(size_t begin, size_t end, TransformUpdateStats& stats);
+	// 深さごとに parallelFor(count, grainSize, body) で分けて更新する
+	template<typename ParallelFor> void UpdateParallel(ParallelFor&& parallelFor);
+	uint32_t IndexOf(uint32_t node) const;
+
+	// ノード番号 → 配列上の位置（破棄済みは kInvalidNode）
+	std::vector<uint32_t> indices_;
+	std::vector<uint32_t> freeNodes_;
+
+	// 以下は深さ順に並んだ配列
+	std::vector<uint32_t> nodes_;   // 配列上の位置 → ノード番号
+	std::vector<uint32_t> parents_; // 親の配列上の位置（ルートは kInvalidNode）
+	std::vector<Vector3> scales_;
+	std::vector<Vector3> rotations_;
+	std::vector<Vector3> translations_;
+	std::vector<Matrix3x4> worldMatrices_;
+	std::vector<WorldTransform*> bindings_;
+	std::vector<uint8_t> dirtyFlags_;   // 前回の Update 以降に SRT が変わったか
+	std::vector<uint8_t> worldChanged_; // 直前の Update でワールド行列が変わったか（子の判定用）
+	// 深さごとの先頭位置（末尾に全ノード数）
+	std::vector<uint32_t> depthOffsets_;
+
+	std::unordered_map<const WorldTransform*, uint32_t> boundNodes_;
+	bool needsSort_ = false;
+	size_t parallelThreshold_ = 2048;
+	TransformUpdateStats stats_;
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,69 @@
+#include "base/ConstantBufferRing.h"
+#include <algorithm>
+#include <cassert>
+
+namespace KamataEngine {
+
+namespace {
+
+constexpr size_t AlignUp(size_t size, size_t alignment) { return (size + alignment - 1) & ~(alignment - 1); }
+
+} // namespace
+
+void CpuUploadBuffer::Create(size_t size, uint64_t gpuBaseAddress) {
+	assert(gpuBaseAddress % ConstantBufferRing::kAlignment == 0);
+	// 先頭を 256 バイト境界に合わせるため余分に確保する
+	storage_ = std::make_unique<uint8_t[]>(size + ConstantBufferRing::kAlignment);
+	const uintptr_t address = reinterpret_cast<uintptr_t>(storage_.get());
+	memory_.cpuAddress = storage_.get() + (AlignUp(address, ConstantBufferRing::kAlignment) - address);
+	memory_.gpuAddress = gpuBaseAddress;
+	memory_.size = size;
+}
+
+void ConstantBufferRing::Initialize(const UploadMemory& memory, uint32_t frameCount) {
+	assert(memory.cpuAddress && frameCount > 0);
+	assert(memory.gpuAddress % kAlignment == 0);
+	memory_ = memory;
+	frameCount_ = frameCount;
+	frameIndex_ = 0;
+	// フレームの境界も 256 バイト単位にそろえる
+	bytesPerFrame_ = memory.size / frameCount / kAlignment * kAlignment;
+	offset_.store(0, std::memory_order_relaxed);
+	allocationCount_.store(0, std::memory_order_relaxed);
+	failedAllocations_.store(0, std::memory_order_relaxed);
+	highWaterBytes_ = 0;
+}
+
+void ConstantBufferRing::BeginFrame() {
+	assert(frameCount_ > 0);
+	highWaterBytes_ = std::max(highWaterBytes_, std::min(offset_.load(std::memory_order_relaxed), bytesPerFrame_));
+	frameIndex_ = (frameIndex_ + 1) % frameCount_;
+	offset_.store(0, std::memory_order_relaxed);
+	allocationCount_.store(0, std::memory_order_relaxed);
+	failedAllocations_.store(0, std::memory_order_relaxed);
+}
+
+ConstantBufferAllocation ConstantBufferRing::Allocate(size_t size) {
+	assert(frameCount_ > 0);
+	const size_t alignedSize = AlignUp(std::max<size_t>(size, 1), kAlignment);
+	const size_t offset = offset_.fetch_add(alignedSize, std::memory_order_relaxed);
+	if (offset + alignedSize > bytesPerFrame_) {
+		failedAllocations_.fetch_add(1, std::memory_order_relaxed);
+		return {};
+	}
+	allocationCount_.fetch_add(1, std::memory_order_relaxed);
+
+	const size_t frameOffset = static_cast<size_t>(frameIndex_) * bytesPerFrame_ + offset;
+	return {memory_.cpuAddress + frameOffset, memory_.gpuAddress + frameOffset, alignedSize};
+}
+
+ConstantBufferRingStats ConstantBufferRing::GetStats() const {
+	ConstantBufferRingStats stats;
+	stats.allocationCount = allocationCount_.load(std::memory_order_relaxed);
+	stats.usedBytes = std::min(offset_.load(std::memory_order_relaxed), bytesPerFrame_);
+	stats.highWaterBytes = std::max(highWaterBytes_, stats.usedBytes);
+	stats.failedAllocations = failedAllocations_.load(std::memory_order_relaxed);
+	return stats;
+}
+
+} // namespace KamataEngine
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace KamataEngine {
+
+/// <summary>
+/// 常にマップされたアップロード用メモリ（CPU から書き込み、GPU から読む）
+/// </summary>
+struct UploadMemory final {
+	uint8_t* cpuAddress = nullptr; // CPU から書き込むアドレス
+	uint64_t gpuAddress = 0;       // 先頭の GPU 仮想アドレス
+	size_t size = 0;               // バイト数
+};
+
+/// <summary>
+/// 定数バッファの割り当て結果
+/// </summary>
+struct ConstantBufferAllocation final {
+	void* cpuAddress = nullptr; // 書き込み先（割り当てに失敗したら nullptr）
+	uint64_t gpuAddress = 0;    // SetGraphicsRootConstantBufferView に渡すアドレス
+	size_t size = 0;            // 割り当てたバイト数（256 の倍数）
+
+	explicit operator bool() const { return cpuAddress != nullptr; }
+};
+
+/// <summary>
+/// 定数バッファリングの統計（現在のフレーム分）
+/// </summary>
+struct ConstantBufferRingStats final {
+	size_t allocationCount = 0;   // 割り当て回数
+	size_t usedBytes = 0;         // 使用中のバイト数
+	size_t highWaterBytes = 0;    // これまでの1フレームの最大使用バイト数
+	size_t failedAllocations = 0; // 容量不足で失敗した回数
+};
+
+/// <summary>
+/// GPU のない環境で使う、ヒープ上のアップロード用メモリ（GPU 仮想アドレスは仮の値）
+/// </summary>
+class CpuUploadBuffer final {
+public:
+	/// <summary>
+	/// 確保
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <param name="gpuBaseAddress">先頭に割り当てる仮の GPU 仮想アドレス（256 の倍数）</param>
+	void Create(size_t size, uint64_t gpuBaseAddress = 0x10000);
+
+	/// <summary>
+	/// メモリを取得
+	/// </summary>
+	UploadMemory GetMemory() const { return memory_; }
+
+private:
+	std::unique_ptr<uint8_t[]> storage_;
+	UploadMemory memory_;
+};
+
+/// <summary>
+/// フレームごとの線形な定数バッファ割り当て
+/// 1つの大きなアップロード用メモリを処理中のフレーム数に分け、フレーム内では先頭から順に 256 バイト単位で切り出す。
+/// 割り当てはフレームの終わりにまとめて捨てるので、個別の解放はない。
+/// BeginFrame で再利用する領域を GPU が読み終えていること（フェンスで待つこと）は呼び出し側が保証する。
+/// </summary>
+class ConstantBufferRing final {
+public:
+	// 定数バッファの配置単位（D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT）
+	static constexpr size_t kAlignment = 256;
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="memory">アップロード用メモリ（D3D12UploadBuffer または CpuUploadBuffer。破棄するまで有効であること）</param>
+	/// <param name="frameCount">処理中のフレーム数（バックバッファ数）</param>
+	void Initialize(const UploadMemory& memory, uint32_t frameCount);
+
+	/// <summary>
+	/// 次のフレームの領域に切り替えて、先頭から割り当て直す
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 割り当て（複数のスレッドから同時に呼んでよい）
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <returns>割り当て結果（容量不足なら空）</returns>
+	ConstantBufferAllocation Allocate(size_t size);
+
+	/// <summary>
+	/// 割り当ててデータを書き込む
+	/// </summary>
+	template<typename T> ConstantBufferAllocation Push(const T& data) {
+		ConstantBufferAllocation allocation = Allocate(sizeof(T));
+		if (allocation) {
+			std::memcpy(allocation.cpuAddress, &data, sizeof(T));
+		}
+		return allocation;
+	}
+
+	/// <summary>
+	/// 現在のフレーム番号を取得（0 ～ frameCount - 1）
+	/// </summary>
+	uint32_t GetFrameIndex() const { return frameIndex_; }
+
+	/// <summary>
+	/// 1フレームの容量を取得
+	/// </summary>
+	size_t GetBytesPerFrame() const { return bytesPerFrame_; }
+
+	/// <summary>
+	/// 統計を取得
+	/// </summary>
+	ConstantBufferRingStats GetStats() const;
+
+private:
+	UploadMemory memory_;
+	uint32_t frameCount_ = 0;
+	uint32_t frameIndex_ = 0;
+	size_t bytesPerFrame_ = 0;
+	std::atomic<size_t> offset_ = 0;
+	std::atomic<size_t> allocationCount_ = 0;
+	std::atomic<size_t> failedAllocations_ = 0;
+	size_t highWaterBytes_ = 0;
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,33 @@
+#include "base/D3D12UploadBuffer.h"
+#include <cassert>
+#include <d3dx12.h>
+
+namespace KamataEngine {
+
+D3D12UploadBuffer::~D3D12UploadBuffer() {
+	if (resource_ && memory_.cpuAddress) {
+		resource_->Unmap(0, nullptr);
+	}
+}
+
+void D3D12UploadBuffer::Create(ID3D12Device* device, size_t size) {
+	assert(device);
+	HRESULT result;
+
+	CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+	result = device->CreateCommittedResource(
+	    &heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&resource_));
+	assert(SUCCEEDED(result));
+
+	// アップロードヒープは解放までマップしたままでよい
+	void* mapped = nullptr;
+	result = resource_->Map(0, nullptr, &mapped);
+	assert(SUCCEEDED(result));
+
+	memory_.cpuAddress = static_cast<uint8_t*>(mapped);
+	memory_.gpuAddress = resource_->GetGPUVirtualAddress();
+	memory_.size = size;
+}
+
+} // namespace KamataEngine
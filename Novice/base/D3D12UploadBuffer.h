@@ -0,0 +1,38 @@
+#pragma once
+
+#include "base/ConstantBufferRing.h"
+#include <d3d12.h>
+#include <wrl.h>
+
+namespace KamataEngine {
+
+/// <summary>
+/// アップロードヒープ上の、常にマップしたままのバッファ（ConstantBufferRing の GPU 用メモリ）
+/// </summary>
+class D3D12UploadBuffer final {
+public:
+	~D3D12UploadBuffer();
+
+	/// <summary>
+	/// 生成してマップする
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	/// <param name="size">バイト数</param>
+	void Create(ID3D12Device* device, size_t size);
+
+	/// <summary>
+	/// メモリを取得
+	/// </summary>
+	UploadMemory GetMemory() const { return memory_; }
+
+	/// <summary>
+	/// リソースの取得
+	/// </summary>
+	ID3D12Resource* GetResource() const { return resource_.Get(); }
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource_;
+	UploadMemory memory_;
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,229 @@
+#include "base/EntityWorld.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+namespace KamataEngine {
+
+namespace EntityWorldDetail {
+
+namespace {
+
+// 登録済みの型情報（deque なので追加しても既存の要素の位置は変わらない）
+std::mutex registryMutex;
+std::deque<ComponentInfo> registry;
+
+} // namespace
+
+uint32_t RegisterComponent(const ComponentInfo& info) {
+	std::lock_guard<std::mutex> lock(registryMutex);
+	assert(registry.size() < 64);
+	registry.push_back(info);
+	return static_cast<uint32_t>(registry.size() - 1);
+}
+
+const ComponentInfo& GetComponentInfo(uint32_t id) {
+	std::lock_guard<std::mutex> lock(registryMutex);
+	return registry[id];
+}
+
+} // namespace EntityWorldDetail
+
+namespace {
+
+inline size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+} // namespace
+
+EntityWorld::~EntityWorld() {
+	for (Archetype& archetype : archetypes_) {
+		for (size_t chunk = 0; chunk < archetype.chunks.size(); ++chunk) {
+			const Entity* entities = GetEntities(archetype, chunk);
+			for (uint32_t i = 0; i < archetype.chunks[chunk].used; ++i) {
+				if (entities[i].index == kInvalid) {
+					continue;
+				}
+				const uint32_t slot = static_cast<uint32_t>(chunk) * archetype.capacity + i;
+				for (size_t column = 0; column < archetype.componentIds.size(); ++column) {
+					archetype.infos[column]->destruct(GetComponent(archetype, slot, column));
+				}
+			}
+			::operator delete(archetype.chunks[chunk].data, std::align_val_t(archetype.chunkAlignment));
+		}
+	}
+}
+
+void EntityWorld::Destroy(Entity entity) {
+	if (!IsAlive(entity)) {
+		return;
+	}
+	Record& record = records_[entity.index];
+	Archetype& archetype = archetypes_[record.archetype];
+	for (size_t column = 0; column < archetype.componentIds.size(); ++column) {
+		archetype.infos[column]->destruct(GetComponent(archetype, record.slot, column));
+	}
+	FreeSlot(archetype, record.slot);
+
+	record.archetype = kInvalid;
+	++record.generation;
+	freeRecords_.push_back(entity.index);
+	--entityCount_;
+}
+
+Entity EntityWorld::Create(uint64_t mask) {
+	const uint32_t archetypeIndex = GetOrCreateArchetype(mask);
+	Archetype& archetype = archetypes_[archetypeIndex];
+	const uint32_t slot = AllocateSlot(archetype);
+	for (size_t column = 0; column < archetype.componentIds.size(); ++column) {
+		archetype.infos[column]->construct(GetComponent(archetype, slot, column));
+	}
+
+	uint32_t index;
+	if (freeRecords_.empty()) {
+		index = static_cast<uint32_t>(records_.size());
+		records_.push_back({});
+	} else {
+		index = freeRecords_.back();
+		freeRecords_.pop_back();
+	}
+	Record& record = records_[index];
+	record.archetype = archetypeIndex;
+	record.slot = slot;
+
+	const Entity entity{index, record.generation};
+	GetEntities(archetype, slot / archetype.capacity)[slot % archetype.capacity] = entity;
+	++entityCount_;
+	return entity;
+}
+
+uint32_t EntityWorld::GetOrCreateArchetype(uint64_t mask) {
+	auto it = archetypeIndices_.find(mask);
+	if (it != archetypeIndices_.end()) {
+		return it->second;
+	}
+
+	Archetype archetype;
+	archetype.mask = mask;
+	std::fill(std::begin(archetype.columns), std::end(archetype.columns), int8_t{-1});
+	size_t bytesPerEntity = sizeof(Entity);
+	size_t alignment = alignof(Entity);
+	for (uint32_t id = 0; id < 64; ++id) {
+		if ((mask & Bit(id)) == 0) {
+			continue;
+		}
+		const EntityWorldDetail::ComponentInfo& info = EntityWorldDetail::GetComponentInfo(id);
+		archetype.columns[id] = static_cast<int8_t>(archetype.componentIds.size());
+		archetype.componentIds.push_back(id);
+		archetype.infos.push_back(&info);
+		bytesPerEntity += info.size;
+		alignment = std::max(alignment, info.alignment);
+	}
+
+	// 配列の間の詰め物を見込んで、収まるまで要素数を減らす
+	auto layout = [&](uint32_t capacity) {
+		archetype.offsets.clear();
+		size_t offset = sizeof(Entity) * capacity;
+		for (const EntityWorldDetail::ComponentInfo* info : archetype.infos) {
+			offset = AlignUp(offset, info->alignment);
+			archetype.offsets.push_back(offset);
+			offset += info->size * capacity;
+		}
+		return offset;
+	};
+	uint32_t capacity = static_cast<uint32_t>(std::max<size_t>(kChunkBytes / bytesPerEntity, 1));
+	while (capacity > 1 && layout(capacity) > kChunkBytes) {
+		--capacity;
+	}
+	archetype.capacity = capacity;
+	archetype.chunkBytes = std::max(layout(capacity), kChunkBytes);
+	archetype.chunkAlignment = std::max<size_t>(alignment, 64);
+
+	const uint32_t index = static_cast<uint32_t>(archetypes_.size());
+	archetypes_.push_back(std::move(archetype));
+	archetypeIndices_.emplace(mask, index);
+	return index;
+}
+
+uint32_t EntityWorld::AllocateSlot(Archetype& archetype) {
+	if (!archetype.freeSlots.empty()) {
+		const uint32_t slot = archetype.freeSlots.back();
+		archetype.freeSlots.pop_back();
+		return slot;
+	}
+	if (archetype.chunks.empty() || archetype.chunks.back().used == archetype.capacity) {
+		Chunk chunk;
+		chunk.data = static_cast<std::byte*>(::operator new(archetype.chunkBytes, std::align_val_t(archetype.chunkAlignment)));
+		archetype.chunks.push_back(chunk);
+	}
+	Chunk& chunk = archetype.chunks.back();
+	return static_cast<uint32_t>(archetype.chunks.size() - 1) * archetype.capacity + chunk.used++;
+}
+
+void EntityWorld::FreeSlot(Archetype& archetype, uint32_t slot) {
+	GetEntities(archetype, slot / archetype.capacity)[slot % archetype.capacity].index = kInvalid;
+	archetype.freeSlots.push_back(slot);
+}
+
+void* EntityWorld::GetComponent(Entity entity, uint32_t id) {
+	if (!IsAlive(entity)) {
+		return nullptr;
+	}
+	const Record& record = records_[entity.index];
+	const Archetype& archetype = archetypes_[record.archetype];
+	const int column = archetype.columns[id];
+	return column < 0 ? nullptr : GetComponent(archetype, record.slot, column);
+}
+
+void* EntityWorld::GetComponent(const Archetype& archetype, uint32_t slot, size_t column) {
+	return archetype.chunks[slot / archetype.capacity].data + archetype.offsets[column] + archetype.infos[column]->size * (slot % archetype.capacity);
+}
+
+void* EntityWorld::ChangeArchetype(Entity entity, uint64_t mask, uint32_t addedId) {
+	assert(IsAlive(entity));
+	Record& record = records_[entity.index];
+	// アーキタイプを追加すると配列が再確保されるので、先に作っておく
+	const uint32_t newIndex = GetOrCreateArchetype(mask);
+	Archetype& oldArchetype = archetypes_[record.archetype];
+	Archetype& newArchetype = archetypes_[newIndex];
+	const uint32_t newSlot = AllocateSlot(newArchetype);
+
+	void* added = nullptr;
+	for (size_t column = 0; column < newArchetype.componentIds.size(); ++column) {
+		const uint32_t id = newArchetype.componentIds[column];
+		void* dst = GetComponent(newArchetype, newSlot, column);
+		if (id == addedId) {
+			added = dst;
+			continue;
+		}
+		// WorldTransform などムーブできないコンポーネントを持つエンティティのアーキタイプは変えられない
+		assert(newArchetype.infos[column]->move);
+		newArchetype.infos[column]->move(dst, GetComponent(oldArchetype, record.slot, oldArchetype.columns[id]));
+	}
+	// 取り除くコンポーネントは破棄する
+	for (size_t column = 0; column < oldArchetype.componentIds.size(); ++column) {
+		if ((mask & Bit(oldArchetype.componentIds[column])) == 0) {
+			oldArchetype.infos[column]->destruct(GetComponent(oldArchetype, record.slot, column));
+		}
+	}
+	FreeSlot(oldArchetype, record.slot);
+
+	GetEntities(newArchetype, newSlot / newArchetype.capacity)[newSlot % newArchetype.capacity] = entity;
+	record.archetype = newIndex;
+	record.slot = newSlot;
+	return added;
+}
+
+std::vector<EntityWorld::ChunkRef> EntityWorld::CollectChunks(uint64_t mask) const {
+	std::vector<ChunkRef> chunks;
+	for (uint32_t a = 0; a < archetypes_.size(); ++a) {
+		if ((archetypes_[a].mask & mask) != mask) {
+			continue;
+		}
+		for (uint32_t chunk = 0; chunk < archetypes_[a].chunks.size(); ++chunk) {
+			chunks.push_back({a, chunk});
+		}
+	}
+	return chunks;
+}
+
+} // namespace KamataEngine
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "base/JobSystem.h"
+#include "base/ThreadPool.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace KamataEngine {
+
+/// <summary>
+/// エンティティ（破棄済みのエンティティは、番号が再利用されても無効と判定できる）
+/// </summary>
+struct Entity final {
+	uint32_t index = UINT32_MAX;
+	uint32_t generation = 0;
+
+	bool operator==(const Entity&) const = default;
+};
+
+namespace EntityWorldDetail {
+
+/// <summary>
+/// コンポーネントの型情報
+/// </summary>
+struct ComponentInfo {
+	size_t size;
+	size_t alignment;
+	void (*construct)(void* dst);
+	void (*destruct)(void* object);
+	void (*move)(void* dst, void* src); // ムーブできない型は nullptr
+};
+
+// 型情報を登録して番号を返す（スレッドセーフ）
+uint32_t RegisterComponent(const ComponentInfo& info);
+const ComponentInfo& GetComponentInfo(uint32_t id);
+
+template<typename T> void Construct(void* dst) { new (dst) T(); }
+
+template<typename T> void Destruct(void* object) { static_cast<T*>(object)->~T(); }
+
+// src から dst へムーブして src を破棄する
+template<typename T> void Move(void* dst, void* src) {
+	new (dst) T(std::move(*static_cast<T*>(src)));
+	static_cast<T*>(src)->~T();
+}
+
+// コンポーネントの型ごとの番号（最初に使われたときに登録する）
+template<typename T> uint32_t GetComponentId() {
+	static_assert(std::is_default_constructible_v<T>, "components must be default constructible");
+	static const uint32_t id = [] {
+		ComponentInfo info{sizeof(T), alignof(T), &Construct<T>, &Destruct<T>, nullptr};
+		if constexpr (std::is_move_constructible_v<T>) {
+			info.move = &Move<T>;
+		}
+		return RegisterComponent(info);
+	}();
+	return id;
+}
+
+} // namespace EntityWorldDetail
+
+/// <summary>
+/// アーキタイプ（コンポーネントの組み合わせ）ごとにエンティティをチャンクへ連続して格納するコンポーネントストア
+/// チャンク内はコンポーネントごとの配列（SoA）で、ForEach は条件に合うチャンクを先頭から順に走査する。
+/// 破棄したエンティティの場所は空きとして同じアーキタイプの次の生成で再利用し、生きているコンポーネントは移動しない。
+/// そのため WorldTransform のようにコピー・ムーブできないエンジンの型もそのままコンポーネントにできる
+/// （ただしそのようなコンポーネントを持つエンティティには AddComponent / RemoveComponent を使えない）。
+/// コンポーネントの型は 64 種類まで。
+/// </summary>
+class EntityWorld final {
+public:
+	// 1チャンクのバイト数
+	static constexpr size_t kChunkBytes = 16 * 1024;
+
+	EntityWorld() = default;
+	~EntityWorld();
+	EntityWorld(const EntityWorld&) = delete;
+	EntityWorld& operator=(const EntityWorld&) = delete;
+
+	/// <summary>
+	/// コンポーネントを既定値で構築したエンティティを生成
+	/// </summary>
+	/// <typeparam name="Components">コンポーネントの型（既定コンストラクタを持つこと）</typeparam>
+	template<typename... Components> Entity Create() { return Create(MakeMask<Components...>()); }
+
+	/// <summary>
+	/// エンティティを破棄（無効なエンティティなら何もしない）
+	/// </summary>
+	void Destroy(Entity entity);
+
+	/// <summary>
+	/// エンティティが有効か
+	/// </summary>
+	bool IsAlive(Entity entity) const {
+		return entity.index < records_.size() && records_[entity.index].generation == entity.generation && records_[entity.index].archetype != kInvalid;
+	}
+
+	/// <summary>
+	/// コンポーネントを取得
+	/// </summary>
+	/// <returns>コンポーネント（持っていなければ nullptr）</returns>
+	template<typename T> T* Get(Entity entity) { return static_cast<T*>(GetComponent(entity, EntityWorldDetail::GetComponentId<T>())); }
+
+	/// <summary>
+	/// コンポーネントを持っているか
+	/// </summary>
+	template<typename T> bool Has(Entity entity) const {
+		return IsAlive(entity) && (archetypes_[records_[entity.index].archetype].mask & Bit(EntityWorldDetail::GetComponentId<T>())) != 0;
+	}
+
+	/// <summary>
+	/// コンポーネントを追加（エンティティは別のアーキタイプへ移動する。持っているコンポーネントがすべてムーブできること）
+	/// </summary>
+	/// <returns>追加したコンポーネント（すでに持っていればそのコンポーネント）</returns>
+	template<typename T, typename... Args> T& AddComponent(Entity entity, Args&&... args) {
+		assert(IsAlive(entity));
+		const uint32_t id = EntityWorldDetail::GetComponentId<T>();
+		if (T* existing = Get<T>(entity)) {
+			return *existing;
+		}
+		void* component = ChangeArchetype(entity, archetypes_[records_[entity.index].archetype].mask | Bit(id), id);
+		return *new (component) T(std::forward<Args>(args)...);
+	}
+
+	/// <summary>
+	/// コンポーネントを取り除く（エンティティは別のアーキタイプへ移動する。残るコンポーネントがすべてムーブできること）
+	/// </summary>
+	template<typename T> void RemoveComponent(Entity entity) {
+		if (Has<T>(entity)) {
+			ChangeArchetype(entity, archetypes_[records_[entity.index].archetype].mask & ~Bit(EntityWorldDetail::GetComponentId<T>()), kInvalid);
+		}
+	}
+
+	/// <summary>
+	/// Components をすべて持つエンティティについて function を呼ぶ
+	/// function は function(Components&...) または function(Entity, Components&...) の形。
+	/// 走査中にエンティティの生成・破棄・コンポーネントの追加・削除をしないこと。
+	/// </summary>
+	template<typename... Components, typename Function> void ForEach(Function&& function) {
+		const uint64_t mask = MakeMask<Components...>();
+		for (Archetype& archetype : archetypes_) {
+			if ((archetype.mask & mask) != mask) {
+				continue;
+			}
+			for (size_t chunk = 0; chunk < archetype.chunks.size(); ++chunk) {
+				ForEachInChunk<Components...>(archetype, chunk, function);
+			}
+		}
+	}
+
+	/// <summary>
+	/// ForEach をチャンク単位でスレッドプールに分けて並列に実行する
+	/// function は複数のスレッドから同時に呼ばれる（同じエンティティについて2回呼ばれることはない）。
+	/// 書き込むコンポーネントが重ならなければ、同じワールドに対して複数の ParallelForEach を同時に実行してよい。
+	/// </summary>
+	template<typename... Components, typename Function> void ParallelForEach(ThreadPool& threadPool, Function&& function) {
+		const std::vector<ChunkRef> chunks = CollectChunks(MakeMask<Components...>());
+		threadPool.ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				ForEachInChunk<Components...>(archetypes_[chunks[i].archetype], chunks[i].chunk, function);
+			}
+		});
+	}
+
+	/// <summary>
+	/// ForEach をチャンク単位でジョブシステムに分けて並列に実行する（function の条件は ThreadPool 版と同じ）
+	/// ジョブの中から呼んでもよい。
+	/// </summary>
+	template<typename... Components, typename Function> void ParallelForEach(JobSystem& jobSystem, Function&& function) {
+		const std::vector<ChunkRef> chunks = CollectChunks(MakeMask<Components...>());
+		jobSystem.ParallelFor("EntityWorld::ParallelForEach", chunks.size(), 1, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				ForEachInChunk<Components...>(archetypes_[chunks[i].archetype], chunks[i].chunk, function);
+			}
+		});
+	}
+
+	/// <summary>
+	/// 有効なエンティティ数を取得
+	/// </summary>
+	size_t GetEntityCount() const { return entityCount_; }
+
+	/// <summary>
+	/// アーキタイプ数を取得
+	/// </summary>
+	size_t GetArchetypeCount() const { return archetypes_.size(); }
+
+private:
+	static constexpr uint32_t kInvalid = UINT32_MAX;
+
+	/// <summary>
+	/// 固定サイズのメモリに、エンティティとコンポーネントごとの配列を並べたもの
+	/// </summary>
+	struct Chunk {
+		std::byte* data = nullptr;
+		uint32_t used = 0; // 先頭から使ったことのある要素数（この範囲に空きが混ざる）
+	};
+
+	/// <summary>
+	/// コンポーネントの組み合わせが同じエンティティの集まり
+	/// </summary>
+	struct Archetype {
+		uint64_t mask = 0;
+		std::vector<uint32_t> componentIds;                         // 番号の昇順
+		std::vector<const EntityWorldDetail::ComponentInfo*> infos; // componentIds の型情報
+		std::vector<size_t> offsets;                                // チャンク内の各コンポーネント配列の位置
+		int8_t columns[64];                                         // コンポーネント番号 → componentIds 上の位置（なければ -1）
+		uint32_t capacity = 0;                                      // チャンクあたりの要素数
+		size_t chunkBytes = 0;                                      // 大きなコンポーネントがあれば kChunkBytes を超える
+		size_t chunkAlignment = 0;
+		std::vector<Chunk> chunks;
+		std::vector<uint32_t> freeSlots; // 空き（チャンク番号 * capacity + 要素番号）
+	};
+
+	// エンティティ番号ごとの所在
+	struct Record {
+		uint32_t archetype = kInvalid;
+		uint32_t slot = 0;
+		uint32_t generation = 0;
+	};
+
+	struct ChunkRef {
+		uint32_t archetype;
+		uint32_t chunk;
+	};
+
+	static constexpr uint64_t Bit(uint32_t id) {
+		assert(id < 64);
+		return uint64_t{1} << id;
+	}
+
+	template<typename... Components> static uint64_t MakeMask() { return (uint64_t{0} | ... | Bit(EntityWorldDetail::GetComponentId<Components>())); }
+
+	// チャンク内のエンティティ配列とコンポーネント配列
+	static Entity* GetEntities(const Archetype& archetype, size_t chunk) { return reinterpret_cast<Entity*>(archetype.chunks[chunk].data); }
+	template<typename T> static T* GetColumn(const Archetype& archetype, size_t chunk) {
+		const int column = archetype.columns[EntityWorldDetail::GetComponentId<T>()];
+		return std::launder(reinterpret_cast<T*>(archetype.chunks[chunk].data + archetype.offsets[column]));
+	}
+
+	template<typename... Components, typename Function> static void ForEachInChunk(const Archetype& archetype, size_t chunk, Function& function) {
+		const Entity* entities = GetEntities(archetype, chunk);
+		const uint32_t used = archetype.chunks[chunk].used;
+		auto columns = std::make_tuple(GetColumn<Components>(archetype, chunk)...);
+		for (uint32_t i = 0; i < used; ++i) {
+			// 空きは index が無効
+			if (entities[i].index == kInvalid) {
+				continue;
+			}
+			if constexpr (std::is_invocable_v<Function&, Entity, Components&...>) {
+				function(entities[i], std::get<Components*>(columns)[i]...);
+			} else {
+				function(std::get<Components*>(columns)[i]...);
+			}
+		}
+	}
+
+	Entity Create(uint64_t mask);
+	uint32_t GetOrCreateArchetype(uint64_t mask);
+	// アーキタイプの空きを1つ確保する
+	uint32_t AllocateSlot(Archetype& archetype);
+	void FreeSlot(Archetype& archetype, uint32_t slot);
+	void* GetComponent(Entity entity, uint32_t id);
+	static void* GetComponent(const Archetype& archetype, uint32_t slot, size_t column);
+	// 別のアーキタイプへ移す（addedId のコンポーネントは構築せずに場所を返す）
+	void* ChangeArchetype(Entity entity, uint64_t mask, uint32_t addedId);
+	// mask のコンポーネントをすべて持つアーキタイプのチャンクを集める（同時に走る走査と共有しないよう、呼び出しごとに作る）
+	std::vector<ChunkRef> CollectChunks(uint64_t mask) const;
+
+	std::vector<Archetype> archetypes_;
+	std::unordered_map<uint64_t, uint32_t> archetypeIndices_;
+	std::vector<Record> records_;
+	std::vector<uint32_t> freeRecords_;
+	size_t entityCount_ = 0;
+};
+
+} // namespace KamataEngine
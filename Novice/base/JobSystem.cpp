@@ -0,0 +1,290 @@
+#include "base/JobSystem.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace KamataEngine {
+
+namespace {
+
+// 呼び出したスレッドが属するジョブシステムとスレッド番号
+struct ThreadContext {
+	const JobSystem* system = nullptr;
+	uint32_t index = 0;
+};
+thread_local ThreadContext threadContext;
+
+int64_t GetNanoseconds() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+} // namespace
+
+JobCounter::~JobCounter() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(waiters_.empty());
+}
+
+JobSystem::JobSystem(size_t workerCount) {
+	mainThreadId_ = std::this_thread::get_id();
+	threadContext = {this, 0};
+	startTime_ = GetNanoseconds();
+
+	queues_.reserve(workerCount + 1);
+	for (size_t i = 0; i < workerCount + 1; ++i) {
+		queues_.push_back(std::make_unique<ThreadState>());
+	}
+	workers_.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; ++i) {
+		workers_.emplace_back([this, i] { WorkerMain(static_cast<uint32_t>(i + 1)); });
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		stop_ = true;
+	}
+	wakeCondition_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+	if (threadContext.system == this) {
+		threadContext = {};
+	}
+}
+
+size_t JobSystem::GetDefaultWorkerCount() {
+	const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+	const uint32_t threadIndex = GetThreadIndex();
+	const bool mainThread = IsMainThread();
+	while (!counter.IsDone()) {
+		if (mainThread && TryRunMainThreadJob()) {
+			continue;
+		}
+		if (TryRunJob(threadIndex)) {
+			continue;
+		}
+		// 他のスレッドが実行中のジョブの完了を待つ
+		std::this_thread::yield();
+	}
+}
+
+void JobSystem::RunMainThreadJobs() {
+	assert(IsMainThread());
+	while (TryRunMainThreadJob()) {
+	}
+}
+
+std::vector<JobThreadStats> JobSystem::GetStats() const {
+	std::vector<JobThreadStats> stats;
+	stats.reserve(queues_.size());
+	for (const std::unique_ptr<ThreadState>& state : queues_) {
+		stats.push_back({state->executed.load(std::memory_order_relaxed), state->stolen.load(std::memory_order_relaxed),
+		                 state->busyNanoseconds.load(std::memory_order_relaxed)});
+	}
+	return stats;
+}
+
+void JobSystem::ResetStats() {
+	for (const std::unique_ptr<ThreadState>& state : queues_) {
+		state->executed.store(0, std::memory_order_relaxed);
+		state->stolen.store(0, std::memory_order_relaxed);
+		state->busyNanoseconds.store(0, std::memory_order_relaxed);
+	}
+}
+
+std::vector<JobRecord> JobSystem::TakeRecords() {
+	std::vector<JobRecord> records;
+	for (const std::unique_ptr<ThreadState>& state : queues_) {
+		std::lock_guard<std::mutex> lock(state->recordMutex);
+		records.insert(records.end(), state->records.begin(), state->records.end());
+		state->records.clear();
+	}
+	std::sort(records.begin(), records.end(), [](const JobRecord& a, const JobRecord& b) { return a.beginNanoseconds < b.beginNanoseconds; });
+	return records;
+}
+
+void JobSystem::ParallelFor(const char* name, size_t count, size_t grainSize, RangeFunction function, void* context) {
+	assert(grainSize > 0);
+	if (count == 0) {
+		return;
+	}
+	const size_t chunkCount = (count + grainSize - 1) / grainSize;
+	if (chunkCount == 1 || queues_.size() == 1) {
+		function(context, 0, count);
+		return;
+	}
+
+	// 各ジョブは未処理の範囲がなくなるまで取り出す（呼び出し元が Wait で戻るまで state は有効）
+	struct State {
+		std::atomic<size_t> next;
+		size_t count;
+		size_t grainSize;
+		RangeFunction function;
+		void* context;
+
+		void Work() {
+			for (;;) {
+				const size_t begin = next.fetch_add(grainSize, std::memory_order_relaxed);
+				if (begin >= count) {
+					return;
+				}
+				function(context, begin, std::min(begin + grainSize, count));
+			}
+		}
+	};
+	State state{{0}, count, grainSize, function, context};
+
+	JobCounter counter;
+	const size_t jobCount = std::min(chunkCount, queues_.size()) - 1;
+	for (size_t i = 0; i < jobCount; ++i) {
+		State* statePointer = &state;
+		Schedule(name, [statePointer] { statePointer->Work(); }, &counter);
+	}
+	state.Work();
+	Wait(counter);
+}
+
+void JobSystem::Submit(const Job& job, JobCounter* dependency) {
+	if (job.counter) {
+		job.counter->value_.fetch_add(1, std::memory_order_relaxed);
+	}
+	if (dependency) {
+		// 依存先の完了時に積み直す（完了との前後はロックで決める）
+		std::lock_guard<std::mutex> lock(dependency->mutex_);
+		if (!dependency->IsDone()) {
+			dependency->waiters_.push_back(job);
+			return;
+		}
+	}
+	Enqueue(job);
+}
+
+void JobSystem::Enqueue(const Job& job) {
+	if (job.mainThread) {
+		std::lock_guard<std::mutex> lock(mainThreadMutex_);
+		mainThreadJobs_.push_back(job);
+		return;
+	}
+
+	ThreadState& state = *queues_[GetThreadIndex()];
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		state.jobs.push_back(job);
+	}
+	// ワーカーが寝る直前に pendingJobs_ を確かめるので、寝ているワーカーがいるときだけ起こせばよい
+	pendingJobs_.fetch_add(1);
+	if (sleepingWorkers_.load() > 0) {
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex_);
+		}
+		wakeCondition_.notify_one();
+	}
+}
+
+void JobSystem::WorkerMain(uint32_t threadIndex) {
+	threadContext = {this, threadIndex};
+	for (;;) {
+		if (TryRunJob(threadIndex)) {
+			continue;
+		}
+		sleepingWorkers_.fetch_add(1);
+		{
+			std::unique_lock<std::mutex> lock(sleepMutex_);
+			wakeCondition_.wait(lock, [this] { return stop_ || pendingJobs_.load() > 0; });
+			if (stop_) {
+				return;
+			}
+		}
+		sleepingWorkers_.fetch_sub(1);
+	}
+}
+
+bool JobSystem::TryRunJob(uint32_t threadIndex) {
+	Job job;
+	bool found = false;
+	bool stolen = false;
+
+	// 自分のキューは最後に積んだものから（キャッシュに残っているデータを使う）
+	{
+		ThreadState& state = *queues_[threadIndex];
+		std::lock_guard<std::mutex> lock(state.mutex);
+		if (!state.jobs.empty()) {
+			job = state.jobs.back();
+			state.jobs.pop_back();
+			found = true;
+		}
+	}
+	// 他のスレッドのキューからは最初に積んだものを盗む
+	for (size_t i = 1; !found && i < queues_.size(); ++i) {
+		ThreadState& victim = *queues_[(threadIndex + i) % queues_.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty()) {
+			job = victim.jobs.front();
+			victim.jobs.pop_front();
+			found = true;
+			stolen = true;
+		}
+	}
+	if (!found) {
+		return false;
+	}
+
+	pendingJobs_.fetch_sub(1);
+	if (stolen) {
+		queues_[threadIndex]->stolen.fetch_add(1, std::memory_order_relaxed);
+	}
+	Execute(job, threadIndex);
+	return true;
+}
+
+bool JobSystem::TryRunMainThreadJob() {
+	Job job;
+	{
+		std::lock_guard<std::mutex> lock(mainThreadMutex_);
+		if (mainThreadJobs_.empty()) {
+			return false;
+		}
+		job = mainThreadJobs_.front();
+		mainThreadJobs_.pop_front();
+	}
+	Execute(job, 0);
+	return true;
+}
+
+void JobSystem::Execute(Job& job, uint32_t threadIndex) {
+	ThreadState& state = *queues_[threadIndex];
+	if (profilingEnabled_.load(std::memory_order_relaxed)) {
+		const int64_t begin = GetNanoseconds();
+		job.function(job.data);
+		const int64_t end = GetNanoseconds();
+		state.busyNanoseconds.fetch_add(static_cast<uint64_t>(end - begin), std::memory_order_relaxed);
+		std::lock_guard<std::mutex> lock(state.recordMutex);
+		state.records.push_back({job.name, threadIndex, begin - startTime_, end - startTime_});
+	} else {
+		job.function(job.data);
+	}
+	state.executed.fetch_add(1, std::memory_order_relaxed);
+
+	// 完了したら、このカウンタを待っていたジョブを積む。
+	// 0 になった直後に待っている側がカウンタを破棄できるので、ロックを外した後はカウンタに触れない
+	if (JobCounter* counter = job.counter) {
+		std::vector<Job> released;
+		{
+			std::lock_guard<std::mutex> lock(counter->mutex_);
+			if (counter->value_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				released.swap(counter->waiters_);
+			}
+		}
+		for (const Job& waiter : released) {
+			Enqueue(waiter);
+		}
+	}
+}
+
+uint32_t JobSystem::GetThreadIndex() const { return threadContext.system == this ? threadContext.index : 0; }
+
+} // namespace KamataEngine
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace KamataEngine {
+
+class JobCounter;
+
+// alignas による詰め物の警告（C4324）は、意図した配置なので抑える
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+/// <summary>
+/// ジョブ1つ分（関数とその引数をコピーして持つ）
+/// </summary>
+struct Job final {
+	// ジョブに持たせられる関数オブジェクトの最大バイト数
+	static constexpr size_t kDataSize = 48;
+
+	void (*function)(void* data) = nullptr;
+	alignas(16) std::byte data[kDataSize];
+	JobCounter* counter = nullptr;
+	const char* name = nullptr;
+	bool mainThread = false;
+};
+#pragma warning(pop)
+
+/// <summary>
+/// ジョブの完了を数えるカウンタ
+/// 登録したジョブが残っている間は 0 より大きい。JobSystem::Wait で待つか、後続ジョブの依存先に指定する。
+/// </summary>
+class JobCounter final {
+public:
+	JobCounter() = default;
+	// 完了したジョブがまだカウンタに触れている間は待つ
+	~JobCounter();
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	/// <summary>
+	/// 残っているジョブがないか
+	/// </summary>
+	bool IsDone() const { return value_.load(std::memory_order_acquire) == 0; }
+
+private:
+	friend class JobSystem;
+
+	std::atomic<uint32_t> value_ = 0;
+	// 減らす処理と、このカウンタが 0 になるのを待っているジョブを保護する
+	std::mutex mutex_;
+	std::vector<Job> waiters_;
+};
+
+/// <summary>
+/// スレッドごとのジョブの統計
+/// </summary>
+struct JobThreadStats final {
+	uint64_t executed = 0;        // 実行したジョブ数
+	uint64_t stolen = 0;          // 他のスレッドのキューから盗んで実行したジョブ数
+	uint64_t busyNanoseconds = 0; // ジョブの実行に使った時間（計測を有効にしている間だけ数える）
+};
+
+/// <summary>
+/// 計測を有効にしている間に実行したジョブ1つ分の記録
+/// </summary>
+struct JobRecord final {
+	const char* name;
+	uint32_t threadIndex;     // 0 はメインスレッド
+	int64_t beginNanoseconds; // JobSystem の生成時からの時間
+	int64_t endNanoseconds;
+};
+
+/// <summary>
+/// ワークスティーリングのジョブシステム
+/// スレッドごとにジョブのキューを持ち、自分のキューは後ろから（最後に積んだものから）取り出し、
+/// 空になったら他のスレッドのキューの前から盗む。生成したスレッドをメインスレッドとし、メインスレッドも Wait の間はジョブを実行する。
+/// D3D12 の呼び出しなどメインスレッドでしか行えない処理は ScheduleOnMainThread で登録し、RunMainThreadJobs か Wait で実行する。
+/// </summary>
+class JobSystem final {
+public:
+	/// <summary>
+	/// コンストラクタ（呼び出したスレッドをメインスレッドにする）
+	/// </summary>
+	/// <param name="workerCount">ワーカースレッド数（メインスレッドを除く）</param>
+	explicit JobSystem(size_t workerCount = GetDefaultWorkerCount());
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// <summary>
+	/// ジョブを登録
+	/// function はコピーして持つので、トリビアルにコピーでき Job::kDataSize バイト以内であること（大きなデータはポインタで渡す）。
+	/// </summary>
+	/// <param name="name">計測用の名前（文字列リテラルなど、ジョブの完了後も有効なもの）</param>
+	/// <param name="function">void() を呼べる関数オブジェクト</param>
+	/// <param name="counter">完了を数えるカウンタ（nullptr 可）</param>
+	/// <param name="dependency">このカウンタが 0 になってから実行する（nullptr 可）</param>
+	template<typename Function> void Schedule(const char* name, Function&& function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr) {
+		Submit(MakeJob(name, std::forward<Function>(function), counter, false), dependency);
+	}
+
+	/// <summary>
+	/// メインスレッドでだけ実行するジョブを登録（引数は Schedule と同じ）
+	/// </summary>
+	template<typename Function>
+	void ScheduleOnMainThread(const char* name, Function&& function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr) {
+		Submit(MakeJob(name, std::forward<Function>(function), counter, true), dependency);
+	}
+
+	/// <summary>
+	/// カウンタが 0 になるまで、ジョブを実行しながら待つ
+	/// </summary>
+	void Wait(JobCounter& counter);
+
+	/// <summary>
+	/// [0, count) を grainSize ずつに分けて body(begin, end) を並列に呼び、終わるまで待つ
+	/// 呼び出し元も処理に加わる。ジョブの中から入れ子に呼んでもよい。
+	/// </summary>
+	/// <param name="name">計測用の名前</param>
+	/// <param name="count">要素数</param>
+	/// <param name="grainSize">1回の body で処理する最大要素数</param>
+	/// <param name="body">void(size_t begin, size_t end) を呼べる関数オブジェクト</param>
+	template<typename Body> void ParallelFor(const char* name, size_t count, size_t grainSize, Body&& body) {
+		using BodyType = std::remove_reference_t<Body>;
+		ParallelFor(name, count, grainSize, [](void* context, size_t begin, size_t end) { (*static_cast<BodyType*>(context))(begin, end); }, &body);
+	}
+
+	/// <summary>
+	/// メインスレッド用のジョブを、登録済みのものがなくなるまで実行（メインスレッドから毎フレーム呼ぶ）
+	/// </summary>
+	void RunMainThreadJobs();
+
+	/// <summary>
+	/// 呼び出したスレッドがメインスレッドか
+	/// </summary>
+	bool IsMainThread() const { return std::this_thread::get_id() == mainThreadId_; }
+
+	/// <summary>
+	/// ジョブを実行するスレッド数を取得（ワーカー数 + メインスレッド）
+	/// </summary>
+	size_t GetThreadCount() const { return queues_.size(); }
+
+	/// <summary>
+	/// ジョブの実行時間の計測を有効にする（無効なら時間の記録と busyNanoseconds の集計を行わない）
+	/// </summary>
+	void SetProfilingEnabled(bool enabled) { profilingEnabled_.store(enabled, std::memory_order_relaxed); }
+
+	/// <summary>
+	/// スレッドごとの統計を取得（要素 0 がメインスレッド）
+	/// </summary>
+	std::vector<JobThreadStats> GetStats() const;
+
+	/// <summary>
+	/// 統計をリセット
+	/// </summary>
+	void ResetStats();
+
+	/// <summary>
+	/// 計測したジョブの記録を取り出す（取り出した記録は消える）
+	/// </summary>
+	std::vector<JobRecord> TakeRecords();
+
+	/// <summary>
+	/// 既定のワーカー数（論理コア数 - 1）
+	/// </summary>
+	static size_t GetDefaultWorkerCount();
+
+private:
+	using RangeFunction = void (*)(void* context, size_t begin, size_t end);
+
+	// スレッドごとにキャッシュラインを分ける（C4324 は同上）
+#pragma warning(push)
+#pragma warning(disable : 4324)
+	/// <summary>
+	/// スレッドごとのキューと統計
+	/// </summary>
+	struct alignas(64) ThreadState {
+		std::mutex mutex;
+		std::deque<Job> jobs;
+		std::atomic<uint64_t> executed = 0;
+		std::atomic<uint64_t> stolen = 0;
+		std::atomic<uint64_t> busyNanoseconds = 0;
+		std::mutex recordMutex;
+		std::vector<JobRecord> records;
+	};
+#pragma warning(pop)
+
+	template<typename Function> static Job MakeJob(const char* name, Function&& function, JobCounter* counter, bool mainThread) {
+		using FunctionType = std::decay_t<Function>;
+		static_assert(std::is_trivially_copyable_v<FunctionType> && sizeof(FunctionType) <= Job::kDataSize && alignof(FunctionType) <= 16,
+		              "job functions must be trivially copyable and fit in Job::kDataSize bytes");
+		Job job;
+		job.function = [](void* data) { (*std::launder(static_cast<FunctionType*>(data)))(); };
+		new (job.data) FunctionType(std::forward<Function>(function));
+		job.counter = counter;
+		job.name = name;
+		job.mainThread = mainThread;
+		return job;
+	}
+
+	void ParallelFor(const char* name, size_t count, size_t grainSize, RangeFunction function, void* context);
+	// カウンタを増やし、依存先が終わっていればキューに積む
+	void Submit(const Job& job, JobCounter* dependency);
+	void Enqueue(const Job& job);
+	void WorkerMain(uint32_t threadIndex);
+	// 自分のキューか他のスレッドのキューからジョブを1つ取り出して実行する
+	bool TryRunJob(uint32_t threadIndex);
+	bool TryRunMainThreadJob();
+	void Execute(Job& job, uint32_t threadIndex);
+	// 呼び出したスレッドの番号（このジョブシステムのスレッドでなければメインスレッドのキューを使う）
+	uint32_t GetThreadIndex() const;
+
+	std::vector<std::unique_ptr<ThreadState>> queues_;
+	std::vector<std::thread> workers_;
+	std::thread::id mainThreadId_;
+
+	std::mutex mainThreadMutex_;
+	std::deque<Job> mainThreadJobs_;
+
+	// 寝ているワーカーを起こすため、盗めるジョブの数を数える
+	std::atomic<int64_t> pendingJobs_ = 0;
+	std::atomic<uint32_t> sleepingWorkers_ = 0;
+	std::mutex sleepMutex_;
+	std::condition_variable wakeCondition_;
+	bool stop_ = false;
+
+	std::atomic<bool> profilingEnabled_ = false;
+	int64_t startTime_ = 0;
+};
+
+} // namespace KamataEngine
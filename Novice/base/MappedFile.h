@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace KamataEngine {
+
+/// <summary>
+/// 読み取り専用でメモリにマップしたファイル（読み込みのコピーなしで内容を参照する）
+/// </summary>
+class MappedFile final {
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// <summary>
+	/// ファイルを開いてマップ（開いていたファイルは閉じる）
+	/// </summary>
+	/// <param name="path">ファイルパス</param>
+	/// <returns>成功したか（空のファイルは成功して GetSize が 0 になる）</returns>
+	bool Open(const std::filesystem::path& path);
+
+	/// <summary>
+	/// マップを解除して閉じる
+	/// </summary>
+	void Close();
+
+	bool IsOpen() const { return open_; }
+	const char* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+	std::string_view GetView() const { return {data_, size_}; }
+
+private:
+	const char* data_ = nullptr;
+	size_t size_ = 0;
+	bool open_ = false;
+#ifdef _WIN32
+	void* file_ = nullptr;    // HANDLE
+	void* mapping_ = nullptr; // HANDLE
+#else
+	int descriptor_ = -1;
+#endif
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace KamataEngine {
+
+/// <summary>
+/// ObjectPool のハンドル（破棄済みのスロットを指すハンドルは、スロットが再利用されても無効と判定できる）
+/// </summary>
+template<typename T> struct PoolHandle final {
+	uint32_t index = UINT32_MAX;
+	uint32_t generation = 0;
+
+	bool operator==(const PoolHandle&) const = default;
+};
+
+/// <summary>
+/// ObjectPool の統計
+/// </summary>
+struct ObjectPoolStats final {
+	size_t liveCount = 0;     // 使用中のスロット数
+	size_t capacity = 0;      // 確保済みのスロット数
+	size_t highWaterMark = 0; // 使用中のスロット数の最大値
+	size_t createCount = 0;   // Create の累計回数
+	size_t destroyCount = 0;  // Destroy の累計回数
+};
+
+/// <summary>
+/// 固定サイズのスラブにオブジェクトを並べて確保するプール
+/// オブジェクトは移動しないので、WorldTransform や Camera のようにコピー・ムーブできない型も置ける。
+/// 空きスロットはフリーリストで管理し、Create / Destroy は O(1)。スラブが足りないときだけメモリを確保する。
+/// </summary>
+/// <typeparam name="T">要素の型</typeparam>
+/// <typeparam name="kSlabSize">1つのスラブの要素数</typeparam>
+template<typename T, size_t kSlabSize = 256> class ObjectPool final {
+public:
+	using Handle = PoolHandle<T>;
+
+	ObjectPool() = default;
+	~ObjectPool() { Clear(); }
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	/// <summary>
+	/// スロットをあらかじめ確保
+	/// </summary>
+	/// <param name="capacity">スロット数</param>
+	void Reserve(size_t capacity) {
+		while (generations_.size() < capacity) {
+			AddSlab();
+		}
+	}
+
+	/// <summary>
+	/// オブジェクトを生成（WorldTransform などの Initialize は呼び出し側で行う）
+	/// </summary>
+	/// <param name="args">コンストラクタの引数</param>
+	/// <returns>ハンドル</returns>
+	template<typename... Args> Handle Create(Args&&... args) {
+		if (freeList_.empty()) {
+			AddSlab();
+		}
+		const uint32_t index = freeList_.back();
+		freeList_.pop_back();
+		new (Slot(index)) T(std::forward<Args>(args)...);
+		// 世代が奇数なら使用中
+		const uint32_t generation = ++generations_[index];
+		++liveCount_;
+		++createCount_;
+		if (liveCount_ > highWaterMark_) {
+			highWaterMark_ = liveCount_;
+		}
+		return {index, generation};
+	}
+
+	/// <summary>
+	/// オブジェクトを破棄（無効なハンドルなら何もしない）
+	/// </summary>
+	void Destroy(Handle handle) {
+		T* object = Get(handle);
+		if (!object) {
+			return;
+		}
+		object->~T();
+		++generations_[handle.index];
+		freeList_.push_back(handle.index);
+		--liveCount_;
+		++destroyCount_;
+	}
+
+	/// <summary>
+	/// すべてのオブジェクトを破棄（スラブは残す）
+	/// </summary>
+	void Clear() {
+		for (uint32_t index = 0; index < generations_.size(); ++index) {
+			if (IsAlive(index)) {
+				Destroy({index, generations_[index]});
+			}
+		}
+	}
+
+	/// <summary>
+	/// オブジェクトを取得
+	/// </summary>
+	/// <returns>オブジェクト（破棄済みなら nullptr）</returns>
+	T* Get(Handle handle) { return IsValid(handle) ? Slot(handle.index) : nullptr; }
+	const T* Get(Handle handle) const { return IsValid(handle) ? Slot(handle.index) : nullptr; }
+
+	/// <summary>
+	/// ハンドルが使用中のオブジェクトを指しているか
+	/// </summary>
+	bool IsValid(Handle handle) const { return handle.index < generations_.size() && generations_[handle.index] == handle.generation && IsAlive(handle.index); }
+
+	/// <summary>
+	/// 使用中のすべてのオブジェクトに対して function(T&) を呼ぶ（スロット順）
+	/// </summary>
+	template<typename Function> void ForEach(Function&& function) {
+		for (uint32_t index = 0; index < generations_.size(); ++index) {
+			if (IsAlive(index)) {
+				function(*Slot(index));
+			}
+		}
+	}
+
+	/// <summary>
+	/// 統計を取得
+	/// </summary>
+	ObjectPoolStats GetStats() const { return {liveCount_, generations_.size(), highWaterMark_, createCount_, destroyCount_}; }
+
+private:
+	struct Slab {
+		alignas(T) std::byte storage[sizeof(T) * kSlabSize];
+	};
+
+	bool IsAlive(uint32_t index) const { return (generations_[index] & 1u) != 0; }
+
+	T* Slot(uint32_t index) const { return std::launder(reinterpret_cast<T*>(slabs_[index / kSlabSize]->storage + sizeof(T) * (index % kSlabSize))); }
+
+	void AddSlab() {
+		const uint32_t first = static_cast<uint32_t>(generations_.size());
+		slabs_.push_back(std::make_unique<Slab>());
+		generations_.resize(first + kSlabSize, 0);
+		// 先頭のスロットから使われるよう逆順に積む
+		freeList_.reserve(freeList_.size() + kSlabSize);
+		for (uint32_t i = kSlabSize; i-- > 0;) {
+			freeList_.push_back(first + i);
+		}
+	}
+
+	std::vector<std::unique_ptr<Slab>> slabs_;
+	std::vector<uint32_t> generations_;
+	std::vector<uint32_t> freeList_;
+	size_t liveCount_ = 0;
+	size_t highWaterMark_ = 0;
+	size_t createCount_ = 0;
+	size_t destroyCount_ = 0;
+};
+
+class Camera;
+class WorldTransform;
+
+// 弾などの頻繁に生成・破棄するオブジェクト用
+using WorldTransformPool = ObjectPool<WorldTransform>;
+using WorldTransformHandle = PoolHandle<WorldTransform>;
+using CameraPool = ObjectPool<Camera, 16>;
+using CameraHandle = PoolHandle<Camera>;
+
+} // namespace KamataEngine
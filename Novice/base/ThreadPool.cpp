@@ -0,0 +1,103 @@
+#include "base/ThreadPool.h"
+#include <algorithm>
+#include <cassert>
+
+namespace KamataEngine {
+
+ThreadPool::ThreadPool(size_t workerCount) {
+	workers_.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; ++i) {
+		workers_.emplace_back([this] { WorkerMain(); });
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	wakeCondition_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+}
+
+size_t ThreadPool::GetDefaultWorkerCount() {
+	const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+void ThreadPool::Run(size_t count, size_t grainSize, Function function, void* context) {
+	assert(grainSize > 0);
+	if (count == 0) {
+		return;
+	}
+	// 1回分に収まるならスレッドを起こさない
+	if (workers_.empty() || count <= grainSize) {
+		function(context, 0, count);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		assert(!active_);
+		function_ = function;
+		context_ = context;
+		count_ = count;
+		grainSize_ = grainSize;
+		next_.store(0, std::memory_order_relaxed);
+		++generation_;
+		active_ = true;
+	}
+	wakeCondition_.notify_all();
+
+	Work(count, grainSize, function, context);
+
+	// 処理中のワーカーが抜けるまで待ち、以降は加われないようにする
+	std::unique_lock<std::mutex> lock(mutex_);
+	doneCondition_.wait(lock, [this] { return busyWorkers_ == 0; });
+	active_ = false;
+}
+
+void ThreadPool::WorkerMain() {
+	uint64_t seenGeneration = 0;
+	for (;;) {
+		Function function;
+		void* context;
+		size_t count;
+		size_t grainSize;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			wakeCondition_.wait(lock, [&] { return stop_ || (active_ && generation_ != seenGeneration); });
+			if (stop_) {
+				return;
+			}
+			seenGeneration = generation_;
+			function = function_;
+			context = context_;
+			count = count_;
+			grainSize = grainSize_;
+			++busyWorkers_;
+		}
+
+		Work(count, grainSize, function, context);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			--busyWorkers_;
+		}
+		doneCondition_.notify_one();
+	}
+}
+
+void ThreadPool::Work(size_t count, size_t grainSize, Function function, void* context) {
+	for (;;) {
+		const size_t begin = next_.fetch_add(grainSize, std::memory_order_relaxed);
+		if (begin >= count) {
+			return;
+		}
+		function(context, begin, std::min(begin + grainSize, count));
+	}
+}
+
+} // namespace KamataEngine
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace KamataEngine {
+
+/// <summary>
+/// 固定数のワーカースレッドでループを分割実行するスレッドプール
+/// ParallelFor は呼び出し元のスレッドも処理に加わり、全範囲が終わるまで戻らない。
+/// </summary>
+class ThreadPool final {
+public:
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="workerCount">ワーカースレッド数（呼び出し元を除く。0 なら呼び出し元だけで実行する）</param>
+	explicit ThreadPool(size_t workerCount = GetDefaultWorkerCount());
+	~ThreadPool();
+
+	/// <summary>
+	/// [0, count) を grainSize ずつに分けて body(begin, end) を並列に呼ぶ
+	/// body は複数のスレッドから同時に呼ばれる。ParallelFor を入れ子に呼ばないこと。
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="grainSize">1回の body で処理する最大要素数</param>
+	/// <param name="body">void(size_t begin, size_t end) を呼べる関数オブジェクト</param>
+	template<typename Body> void ParallelFor(size_t count, size_t grainSize, Body&& body) {
+		Run(count, grainSize, [](void* context, size_t begin, size_t end) { (*static_cast<std::remove_reference_t<Body>*>(context))(begin, end); }, &body);
+	}
+
+	/// <summary>
+	/// 処理に加わるスレッド数を取得（ワーカー数 + 呼び出し元）
+	/// </summary>
+	size_t GetThreadCount() const { return workers_.size() + 1; }
+
+	/// <summary>
+	/// 既定のワーカー数（論理コア数 - 1）
+	/// </summary>
+	static size_t GetDefaultWorkerCount();
+
+private:
+	using Function = void (*)(void* context, size_t begin, size_t end);
+
+	void Run(size_t count, size_t grainSize, Function function, void* context);
+	void WorkerMain();
+	// 未処理の範囲がなくなるまで取り出して処理する
+	void Work(size_t count, size_t grainSize, Function function, void* context);
+
+	std::vector<std::thread> workers_;
+	std::mutex mutex_;
+	std::condition_variable wakeCondition_;
+	std::condition_variable doneCondition_;
+
+	// 実行中のループ（mutex_ で保護する。next_ だけは処理中に各スレッドが進める）
+	Function function_ = nullptr;
+	void* context_ = nullptr;
+	size_t count_ = 0;
+	size_t grainSize_ = 0;
+	std::atomic<size_t> next_ = 0;
+	uint64_t generation_ = 0;
+	bool active_ = false;
+	size_t busyWorkers_ = 0;
+	bool stop_ = false;
+};
+
+} // namespace KamataEngine
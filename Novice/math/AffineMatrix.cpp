@@ -0,0 +1,156 @@
+#include "math/AffineMatrix.h"
+#include <cmath>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+namespace {
+
+// 4x4行列の上3行3列（線形部分）と平行移動成分
+struct AffineRows {
+	float l[3][3];
+	float t[3];
+};
+
+// S * Rx * Ry * Rz * T の各行を求める
+AffineRows MakeAffineRows(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+	const float sinX = std::sin(rotate.x);
+	const float cosX = std::cos(rotate.x);
+	const float sinY = std::sin(rotate.y);
+	const float cosY = std::cos(rotate.y);
+	const float sinZ = std::sin(rotate.z);
+	const float cosZ = std::cos(rotate.z);
+
+	AffineRows rows;
+	rows.l[0][0] = scale.x * (cosY * cosZ);
+	rows.l[0][1] = scale.x * (cosY * sinZ);
+	rows.l[0][2] = scale.x * -sinY;
+	rows.l[1][0] = scale.y * (sinX * sinY * cosZ - cosX * sinZ);
+	rows.l[1][1] = scale.y * (sinX * sinY * sinZ + cosX * cosZ);
+	rows.l[1][2] = scale.y * (sinX * cosY);
+	rows.l[2][0] = scale.z * (cosX * sinY * cosZ + sinX * sinZ);
+	rows.l[2][1] = scale.z * (cosX * sinY * sinZ - sinX * cosZ);
+	rows.l[2][2] = scale.z * (cosX * cosY);
+	rows.t[0] = translate.x;
+	rows.t[1] = translate.y;
+	rows.t[2] = translate.z;
+	return rows;
+}
+
+// 線形部分は3x3の余因子行列、平行移動は -t * L^-1 で求める
+AffineRows InverseAffineRows(const AffineRows& a, float* det) {
+	const float c00 = a.l[1][1] * a.l[2][2] - a.l[1][2] * a.l[2][1];
+	const float c01 = a.l[1][2] * a.l[2][0] - a.l[1][0] * a.l[2][2];
+	const float c02 = a.l[1][0] * a.l[2][1] - a.l[1][1] * a.l[2][0];
+	const float determinant = a.l[0][0] * c00 + a.l[0][1] * c01 + a.l[0][2] * c02;
+	if (det) {
+		*det = determinant;
+	}
+	const float invDet = 1.0f / determinant;
+
+	AffineRows result;
+	result.l[0][0] = c00 * invDet;
+	result.l[0][1] = (a.l[0][2] * a.l[2][1] - a.l[0][1] * a.l[2][2]) * invDet;
+	result.l[0][2] = (a.l[0][1] * a.l[1][2] - a.l[0][2] * a.l[1][1]) * invDet;
+	result.l[1][0] = c01 * invDet;
+	result.l[1][1] = (a.l[0][0] * a.l[2][2] - a.l[0][2] * a.l[2][0]) * invDet;
+	result.l[1][2] = (a.l[0][2] * a.l[1][0] - a.l[0][0] * a.l[1][2]) * invDet;
+	result.l[2][0] = c02 * invDet;
+	result.l[2][1] = (a.l[0][1] * a.l[2][0] - a.l[0][0] * a.l[2][1]) * invDet;
+	result.l[2][2] = (a.l[0][0] * a.l[1][1] - a.l[0][1] * a.l[1][0]) * invDet;
+	for (int j = 0; j < 3; ++j) {
+		result.t[j] = -(a.t[0] * result.l[0][j] + a.t[1] * result.l[1][j] + a.t[2] * result.l[2][j]);
+	}
+	return result;
+}
+
+Matrix4x4 ToMatrix4x4(const AffineRows& a) {
+	return {{
+	    {a.l[0][0], a.l[0][1], a.l[0][2], 0.0f},
+	    {a.l[1][0], a.l[1][1], a.l[1][2], 0.0f},
+	    {a.l[2][0], a.l[2][1], a.l[2][2], 0.0f},
+	    {a.t[0], a.t[1], a.t[2], 1.0f},
+	}};
+}
+
+Matrix3x4 ToMatrix3x4(const AffineRows& a) {
+	return {{
+	    {a.l[0][0], a.l[1][0], a.l[2][0], a.t[0]},
+	    {a.l[0][1], a.l[1][1], a.l[2][1], a.t[1]},
+	    {a.l[0][2], a.l[1][2], a.l[2][2], a.t[2]},
+	}};
+}
+
+AffineRows ToAffineRows(const Matrix4x4& m) {
+	AffineRows a;
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			a.l[i][j] = m.m[i][j];
+		}
+		a.t[i] = m.m[3][i];
+	}
+	return a;
+}
+
+AffineRows ToAffineRows(const Matrix3x4& m) {
+	AffineRows a;
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			a.l[i][j] = m.m[j][i];
+		}
+		a.t[i] = m.m[i][3];
+	}
+	return a;
+}
+
+} // namespace
+
+Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) { return ToMatrix4x4(MakeAffineRows(scale, rotate, translate)); }
+
+Matrix3x4 MakeAffineMatrix3x4(const Vector3& scale, const Vector3& rotate, const Vector3& translate) { return ToMatrix3x4(MakeAffineRows(scale, rotate, translate)); }
+
+Matrix3x4 MakeMatrix3x4(const Matrix4x4& m) { return ToMatrix3x4(ToAffineRows(m)); }
+
+Matrix4x4 MakeMatrix4x4(const Matrix3x4& m) { return ToMatrix4x4(ToAffineRows(m)); }
+
+Matrix3x4 operator*(const Matrix3x4& m1, const Matrix3x4& m2) {
+	// 転置して格納しているので、4x4行列の m1 * m2 は m2 の各行と m1 の各列の積になる
+	Matrix3x4 result;
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m2.m[i][0] * m1.m[0][j] + m2.m[i][1] * m1.m[1][j] + m2.m[i][2] * m1.m[2][j];
+		}
+		result.m[i][3] += m2.m[i][3];
+	}
+	return result;
+}
+
+Matrix3x4& operator*=(Matrix3x4& lhm, const Matrix3x4& rhm) {
+	lhm = lhm * rhm;
+	return lhm;
+}
+
+Matrix3x4 Inverse(const Matrix3x4& m, float* det) { return ToMatrix3x4(InverseAffineRows(ToAffineRows(m), det)); }
+
+Matrix4x4 InverseAffine(const Matrix4x4& m, float* det) { return ToMatrix4x4(InverseAffineRows(ToAffineRows(m), det)); }
+
+Vector3 Transform(const Vector3& v, const Matrix3x4& m) {
+	return {
+	    v.x * m.m[0][0] + v.y * m.m[0][1] + v.z * m.m[0][2] + m.m[0][3],
+	    v.x * m.m[1][0] + v.y * m.m[1][1] + v.z * m.m[1][2] + m.m[1][3],
+	    v.x * m.m[2][0] + v.y * m.m[2][1] + v.z * m.m[2][2] + m.m[2][3],
+	};
+}
+
+Vector3 TransformNormal(const Vector3& v, const Matrix3x4& m) {
+	return {
+	    v.x * m.m[0][0] + v.y * m.m[0][1] + v.z * m.m[0][2],
+	    v.x * m.m[1][0] + v.y * m.m[1][1] + v.z * m.m[1][2],
+	    v.x * m.m[2][0] + v.y * m.m[2][1] + v.z * m.m[2][2],
+	};
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
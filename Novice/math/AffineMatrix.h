@@ -0,0 +1,37 @@
+#pragma once
+
+#include "math/Matrix3x4.h"
+#include "math/Matrix4x4.h"
+#include "math/Vector3.h"
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+// アフィン変換行列の作成（S * Rx * Ry * Rz * T を行列積なしで直接求める）
+Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+Matrix3x4 MakeAffineMatrix3x4(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+
+// 3x4行列と4x4行列の相互変換（4x4行列の右端の列は (0, 0, 0, 1) とみなす）
+Matrix3x4 MakeMatrix3x4(const Matrix4x4& m);
+Matrix4x4 MakeMatrix4x4(const Matrix3x4& m);
+
+// 2項演算子オーバーロード（4x4行列と同じく m1 の変換を先に適用する）
+Matrix3x4 operator*(const Matrix3x4& m1, const Matrix3x4& m2);
+
+// 代入演算子オーバーロード
+Matrix3x4& operator*=(Matrix3x4& lhm, const Matrix3x4& rhm);
+
+// 逆行列を求める（アフィン変換専用）
+Matrix3x4 Inverse(const Matrix3x4& m, float* det = nullptr);
+// 逆行列を求める（右端の列が (0, 0, 0, 1) の4x4行列専用）
+Matrix4x4 InverseAffine(const Matrix4x4& m, float* det = nullptr);
+
+// 座標変換
+Vector3 Transform(const Vector3& v, const Matrix3x4& m);
+// ベクトル変換
+Vector3 TransformNormal(const Vector3& v, const Matrix3x4& m);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,433 @@
+#include "math/BoundingVolume.h"
+#include "math/MathUtilityConstexpr.h"
+#include "math/SimdSupport.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+namespace {
+
+using Constexpr::operator+;
+using Constexpr::operator-;
+using Constexpr::operator*;
+using Constexpr::Cross;
+using Constexpr::Dot;
+
+// stride バイトごとに並んだ i 番目の点
+inline const Vector3& PointAt(const Vector3* points, size_t i, size_t stride) { return *reinterpret_cast<const Vector3*>(reinterpret_cast<const std::byte*>(points) + i * stride); }
+
+inline float LengthOf(const Vector3& v) { return std::sqrt(Dot(v, v)); }
+
+// 対称3x3行列の固有ベクトルをヤコビ法で求める（列 j が j 番目の固有ベクトル）
+void EigenVectorsSymmetric(float (&a)[3][3], float (&v)[3][3]) {
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			v[i][j] = i == j ? 1.0f : 0.0f;
+		}
+	}
+	constexpr int kMaxSweeps = 16;
+	for (int sweep = 0; sweep < kMaxSweeps; ++sweep) {
+		const float offDiagonal = std::fabs(a[0][1]) + std::fabs(a[0][2]) + std::fabs(a[1][2]);
+		if (offDiagonal < 1e-9f) {
+			break;
+		}
+		for (int p = 0; p < 2; ++p) {
+			for (int q = p + 1; q < 3; ++q) {
+				if (a[p][q] == 0.0f) {
+					continue;
+				}
+				// a[p][q] を 0 にする回転
+				const float theta = (a[q][q] - a[p][p]) / (2.0f * a[p][q]);
+				const float t = (theta >= 0.0f ? 1.0f : -1.0f) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0f));
+				const float c = 1.0f / std::sqrt(t * t + 1.0f);
+				const float s = t * c;
+				for (int k = 0; k < 3; ++k) {
+					const float akp = a[k][p];
+					const float akq = a[k][q];
+					a[k][p] = c * akp - s * akq;
+					a[k][q] = s * akp + c * akq;
+				}
+				for (int k = 0; k < 3; ++k) {
+					const float apk = a[p][k];
+					const float aqk = a[q][k];
+					a[p][k] = c * apk - s * aqk;
+					a[q][k] = s * apk + c * aqk;
+				}
+				for (int k = 0; k < 3; ++k) {
+					const float vkp = v[k][p];
+					const float vkq = v[k][q];
+					v[k][p] = c * vkp - s * vkq;
+					v[k][q] = s * vkp + c * vkq;
+				}
+			}
+		}
+	}
+}
+
+} // namespace
+
+AABB MakeAABB(const Vector3* points, size_t count, size_t stride) {
+	if (count == 0) {
+		return {};
+	}
+	AABB aabb = {PointAt(points, 0, stride), PointAt(points, 0, stride)};
+	for (size_t i = 1; i < count; ++i) {
+		const Vector3& p = PointAt(points, i, stride);
+		aabb.min = {std::min(aabb.min.x, p.x), std::min(aabb.min.y, p.y), std::min(aabb.min.z, p.z)};
+		aabb.max = {std::max(aabb.max.x, p.x), std::max(aabb.max.y, p.y), std::max(aabb.max.z, p.z)};
+	}
+	return aabb;
+}
+
+Sphere MakeSphere(const Vector3* points, size_t count, size_t stride) {
+	if (count == 0) {
+		return {};
+	}
+	// AABB の中心から最も遠い点までを半径とする
+	const AABB aabb = MakeAABB(points, count, stride);
+	const Vector3 center = (aabb.min + aabb.max) * 0.5f;
+	float radiusSq = 0.0f;
+	for (size_t i = 0; i < count; ++i) {
+		const Vector3 d = PointAt(points, i, stride) - center;
+		radiusSq = std::max(radiusSq, Dot(d, d));
+	}
+	return {center, std::sqrt(radiusSq)};
+}
+
+OBB MakeOBB(const Vector3* points, size_t count, size_t stride) {
+	if (count == 0) {
+		return {{}, {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}}, {}};
+	}
+	// 平均と共分散行列
+	Vector3 mean = {};
+	for (size_t i = 0; i < count; ++i) {
+		mean = mean + PointAt(points, i, stride);
+	}
+	mean = mean * (1.0f / static_cast<float>(count));
+	float covariance[3][3] = {};
+	for (size_t i = 0; i < count; ++i) {
+		const Vector3 d = PointAt(points, i, stride) - mean;
+		const float c[3] = {d.x, d.y, d.z};
+		for (int r = 0; r < 3; ++r) {
+			for (int k = r; k < 3; ++k) {
+				covariance[r][k] += c[r] * c[k];
+			}
+		}
+	}
+	covariance[1][0] = covariance[0][1];
+	covariance[2][0] = covariance[0][2];
+	covariance[2][1] = covariance[1][2];
+
+	// 共分散行列の固有ベクトルを軸にする
+	float eigen[3][3];
+	EigenVectorsSymmetric(covariance, eigen);
+	OBB obb;
+	obb.orientations[0] = {eigen[0][0], eigen[1][0], eigen[2][0]};
+	obb.orientations[1] = {eigen[0][1], eigen[1][1], eigen[2][1]};
+	obb.orientations[0] = obb.orientations[0] * (1.0f / LengthOf(obb.orientations[0]));
+	obb.orientations[1] = obb.orientations[1] - obb.orientations[0] * Dot(obb.orientations[0], obb.orientations[1]);
+	obb.orientations[1] = obb.orientations[1] * (1.0f / LengthOf(obb.orientations[1]));
+	obb.orientations[2] = Cross(obb.orientations[0], obb.orientations[1]);
+
+	// 各軸への射影の範囲から中心と大きさを決める
+	float minProjection[3] = {INFINITY, INFINITY, INFINITY};
+	float maxProjection[3] = {-INFINITY, -INFINITY, -INFINITY};
+	for (size_t i = 0; i < count; ++i) {
+		const Vector3 d = PointAt(points, i, stride) - mean;
+		for (int axis = 0; axis < 3; ++axis) {
+			const float projection = Dot(d, obb.orientations[axis]);
+			minProjection[axis] = std::min(minProjection[axis], projection);
+			maxProjection[axis] = std::max(maxProjection[axis], projection);
+		}
+	}
+	obb.center = mean;
+	for (int axis = 0; axis < 3; ++axis) {
+		obb.center = obb.center + obb.orientations[axis] * ((minProjection[axis] + maxProjection[axis]) * 0.5f);
+	}
+	obb.size = {(maxProjection[0] - minProjection[0]) * 0.5f, (maxProjection[1] - minProjection[1]) * 0.5f, (maxProjection[2] - minProjection[2]) * 0.5f};
+	return obb;
+}
+
+Sphere MakeSphere(const AABB& aabb) { return {(aabb.min + aabb.max) * 0.5f, LengthOf(aabb.max - aabb.min) * 0.5f}; }
+
+OBB MakeOBB(const AABB& aabb) { return {(aabb.min + aabb.max) * 0.5f, {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}}, (aabb.max - aabb.min) * 0.5f}; }
+
+AABB MakeAABB(const OBB& obb) {
+	const Vector3(&o)[3] = obb.orientations;
+	const Vector3 extent = {
+	    std::fabs(o[0].x) * obb.size.x + std::fabs(o[1].x) * obb.size.y + std::fabs(o[2].x) * obb.size.z,
+	    std::fabs(o[0].y) * obb.size.x + std::fabs(o[1].y) * obb.size.y + std::fabs(o[2].y) * obb.size.z,
+	    std::fabs(o[0].z) * obb.size.x + std::fabs(o[1].z) * obb.size.y + std::fabs(o[2].z) * obb.size.z,
+	};
+	return {obb.center - extent, obb.center + extent};
+}
+
+AABB Merge(const AABB& a, const AABB& b) {
+	return {
+	    {std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)},
+	    {std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)},
+	};
+}
+
+Sphere Merge(const Sphere& a, const Sphere& b) {
+	const Vector3 d = b.center - a.center;
+	const float distance = LengthOf(d);
+	if (distance + b.radius <= a.radius) {
+		return a;
+	}
+	if (distance + a.radius <= b.radius) {
+		return b;
+	}
+	const float radius = (distance + a.radius + b.radius) * 0.5f;
+	return {a.center + d * ((radius - a.radius) / distance), radius};
+}
+
+AABB Transform(const AABB& aabb, const Matrix4x4& m) {
+	// 中心を変換し、半径は行列の各要素の絶対値で広げる
+	const Vector3 center = Constexpr::Transform((aabb.min + aabb.max) * 0.5f, m);
+	const Vector3 e = (aabb.max - aabb.min) * 0.5f;
+	const Vector3 extent = {
+	    std::fabs(m.m[0][0]) * e.x + std::fabs(m.m[1][0]) * e.y + std::fabs(m.m[2][0]) * e.z,
+	    std::fabs(m.m[0][1]) * e.x + std::fabs(m.m[1][1]) * e.y + std::fabs(m.m[2][1]) * e.z,
+	    std::fabs(m.m[0][2]) * e.x + std::fabs(m.m[1][2]) * e.y + std::fabs(m.m[2][2]) * e.z,
+	};
+	return {center - extent, center + extent};
+}
+
+Sphere Transform(const Sphere& sphere, const Matrix4x4& m) {
+	// 最も大きい軸のスケールで半径を広げる
+	float scaleSq = 0.0f;
+	for (int i = 0; i < 3; ++i) {
+		scaleSq = std::max(scaleSq, m.m[i][0] * m.m[i][0] + m.m[i][1] * m.m[i][1] + m.m[i][2] * m.m[i][2]);
+	}
+	return {Constexpr::Transform(sphere.center, m), sphere.radius * std::sqrt(scaleSq)};
+}
+
+OBB Transform(const OBB& obb, const Matrix4x4& m) {
+	// せん断を含まない変換を前提に、軸の伸縮を大きさに移す
+	OBB result;
+	result.center = Constexpr::Transform(obb.center, m);
+	const float size[3] = {obb.size.x, obb.size.y, obb.size.z};
+	float newSize[3];
+	for (int i = 0; i < 3; ++i) {
+		const Vector3 axis = Constexpr::TransformNormal(obb.orientations[i], m);
+		const float length = LengthOf(axis);
+		result.orientations[i] = length > 0.0f ? axis * (1.0f / length) : obb.orientations[i];
+		newSize[i] = size[i] * length;
+	}
+	result.size = {newSize[0], newSize[1], newSize[2]};
+	return result;
+}
+
+bool IsCollision(const AABB& a, const AABB& b) {
+	return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y && a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+bool IsCollision(const Sphere& a, const Sphere& b) {
+	const Vector3 d = b.center - a.center;
+	const float radius = a.radius + b.radius;
+	return Dot(d, d) <= radius * radius;
+}
+
+bool IsCollision(const AABB& aabb, const Sphere& sphere) {
+	// 球の中心に最も近い AABB 上の点
+	const Vector3 closest = {
+	    std::clamp(sphere.center.x, aabb.min.x, aabb.max.x),
+	    std::clamp(sphere.center.y, aabb.min.y, aabb.max.y),
+	    std::clamp(sphere.center.z, aabb.min.z, aabb.max.z),
+	};
+	const Vector3 d = closest - sphere.center;
+	return Dot(d, d) <= sphere.radius * sphere.radius;
+}
+
+bool IsCollision(const OBB& a, const OBB& b) {
+	// 分離軸定理（各ボックスの3軸と、軸同士の外積9本）
+	constexpr float kEpsilon = 1e-6f;
+	const float ea[3] = {a.size.x, a.size.y, a.size.z};
+	const float eb[3] = {b.size.x, b.size.y, b.size.z};
+	float r[3][3];
+	float absR[3][3];
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			r[i][j] = Dot(a.orientations[i], b.orientations[j]);
+			absR[i][j] = std::fabs(r[i][j]) + kEpsilon;
+		}
+	}
+	const Vector3 d = b.center - a.center;
+	const float t[3] = {Dot(d, a.orientations[0]), Dot(d, a.orientations[1]), Dot(d, a.orientations[2])};
+
+	for (int i = 0; i < 3; ++i) {
+		if (std::fabs(t[i]) > ea[i] + eb[0] * absR[i][0] + eb[1] * absR[i][1] + eb[2] * absR[i][2]) {
+			return false;
+		}
+	}
+	for (int j = 0; j < 3; ++j) {
+		const float distance = std::fabs(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j]);
+		if (distance > ea[0] * absR[0][j] + ea[1] * absR[1][j] + ea[2] * absR[2][j] + eb[j]) {
+			return false;
+		}
+	}
+	for (int i = 0; i < 3; ++i) {
+		const int i1 = (i + 1) % 3;
+		const int i2 = (i + 2) % 3;
+		for (int j = 0; j < 3; ++j) {
+			const int j1 = (j + 1) % 3;
+			const int j2 = (j + 2) % 3;
+			const float distance = std::fabs(t[i2] * r[i1][j] - t[i1] * r[i2][j]);
+			const float radiusA = ea[i1] * absR[i2][j] + ea[i2] * absR[i1][j];
+			const float radiusB = eb[j1] * absR[i][j2] + eb[j2] * absR[i][j1];
+			if (distance > radiusA + radiusB) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+namespace {
+
+#pragma region スカラー版
+
+size_t FindAABBsScalar(const Vector3& c, const Vector3& e, const AABBSoA& b, uint32_t* out, size_t begin, size_t count) {
+	for (size_t i = begin; i < b.size; ++i) {
+		if (std::fabs(c.x - b.centerX[i]) <= e.x + b.extentX[i] && std::fabs(c.y - b.centerY[i]) <= e.y + b.extentY[i] && std::fabs(c.z - b.centerZ[i]) <= e.z + b.extentZ[i]) {
+			out[count++] = static_cast<uint32_t>(i);
+		}
+	}
+	return count;
+}
+
+size_t FindSpheresScalar(const Sphere& sphere, const SphereSoA& s, uint32_t* out, size_t begin, size_t count) {
+	for (size_t i = begin; i < s.size; ++i) {
+		const float dx = s.x[i] - sphere.center.x;
+		const float dy = s.y[i] - sphere.center.y;
+		const float dz = s.z[i] - sphere.center.z;
+		const float radius = sphere.radius + s.radius[i];
+		if (dx * dx + dy * dy + dz * dz <= radius * radius) {
+			out[count++] = static_cast<uint32_t>(i);
+		}
+	}
+	return count;
+}
+
+#pragma endregion
+
+#if KAMATA_SIMD_X86
+
+#pragma region SSE版
+
+size_t FindAABBsSSE(const Vector3& c, const Vector3& e, const AABBSoA& b, uint32_t* out) {
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z);
+	const __m128 ex = _mm_set1_ps(e.x), ey = _mm_set1_ps(e.y), ez = _mm_set1_ps(e.z);
+	size_t count = 0;
+	size_t i = 0;
+	for (; i + 4 <= b.size; i += 4) {
+		const __m128 hitX = _mm_cmple_ps(_mm_andnot_ps(signMask, _mm_sub_ps(cx, _mm_loadu_ps(b.centerX + i))), _mm_add_ps(ex, _mm_loadu_ps(b.extentX + i)));
+		const __m128 hitY = _mm_cmple_ps(_mm_andnot_ps(signMask, _mm_sub_ps(cy, _mm_loadu_ps(b.centerY + i))), _mm_add_ps(ey, _mm_loadu_ps(b.extentY + i)));
+		const __m128 hitZ = _mm_cmple_ps(_mm_andnot_ps(signMask, _mm_sub_ps(cz, _mm_loadu_ps(b.centerZ + i))), _mm_add_ps(ez, _mm_loadu_ps(b.extentZ + i)));
+		count = AppendMaskedIndices(static_cast<uint32_t>(_mm_movemask_ps(_mm_and_ps(_mm_and_ps(hitX, hitY), hitZ))), i, out, count);
+	}
+	return FindAABBsScalar(c, e, b, out, i, count);
+}
+
+size_t FindSpheresSSE(const Sphere& sphere, const SphereSoA& s, uint32_t* out) {
+	const __m128 cx = _mm_set1_ps(sphere.center.x), cy = _mm_set1_ps(sphere.center.y), cz = _mm_set1_ps(sphere.center.z);
+	const __m128 r = _mm_set1_ps(sphere.radius);
+	size_t count = 0;
+	size_t i = 0;
+	for (; i + 4 <= s.size; i += 4) {
+		const __m128 dx = _mm_sub_ps(_mm_loadu_ps(s.x + i), cx);
+		const __m128 dy = _mm_sub_ps(_mm_loadu_ps(s.y + i), cy);
+		const __m128 dz = _mm_sub_ps(_mm_loadu_ps(s.z + i), cz);
+		const __m128 radius = _mm_add_ps(r, _mm_loadu_ps(s.radius + i));
+		const __m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		count = AppendMaskedIndices(static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(distanceSq, _mm_mul_ps(radius, radius)))), i, out, count);
+	}
+	return FindSpheresScalar(sphere, s, out, i, count);
+}
+
+#pragma endregion
+
+#pragma region AVX2版
+
+KAMATA_TARGET_AVX2 size_t FindAABBsAVX2(const Vector3& c, const Vector3& e, const AABBSoA& b, uint32_t* out) {
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 cx = _mm256_set1_ps(c.x), cy = _mm256_set1_ps(c.y), cz = _mm256_set1_ps(c.z);
+	const __m256 ex = _mm256_set1_ps(e.x), ey = _mm256_set1_ps(e.y), ez = _mm256_set1_ps(e.z);
+	size_t count = 0;
+	size_t i = 0;
+	for (; i + 8 <= b.size; i += 8) {
+		const __m256 hitX =
+		    _mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(cx, _mm256_loadu_ps(b.centerX + i))), _mm256_add_ps(ex, _mm256_loadu_ps(b.extentX + i)), _CMP_LE_OQ);
+		const __m256 hitY =
+		    _mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(cy, _mm256_loadu_ps(b.centerY + i))), _mm256_add_ps(ey, _mm256_loadu_ps(b.extentY + i)), _CMP_LE_OQ);
+		const __m256 hitZ =
+		    _mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(cz, _mm256_loadu_ps(b.centerZ + i))), _mm256_add_ps(ez, _mm256_loadu_ps(b.extentZ + i)), _CMP_LE_OQ);
+		count = AppendMaskedIndices(static_cast<uint32_t>(_mm256_movemask_ps(_mm256_and_ps(_mm256_and_ps(hitX, hitY), hitZ))), i, out, count);
+	}
+	_mm256_zeroupper();
+	return FindAABBsScalar(c, e, b, out, i, count);
+}
+
+KAMATA_TARGET_AVX2 size_t FindSpheresAVX2(const Sphere& sphere, const SphereSoA& s, uint32_t* out) {
+	const __m256 cx = _mm256_set1_ps(sphere.center.x), cy = _mm256_set1_ps(sphere.center.y), cz = _mm256_set1_ps(sphere.center.z);
+	const __m256 r = _mm256_set1_ps(sphere.radius);
+	size_t count = 0;
+	size_t i = 0;
+	for (; i + 8 <= s.size; i += 8) {
+		const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(s.x + i), cx);
+		const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(s.y + i), cy);
+		const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(s.z + i), cz);
+		const __m256 radius = _mm256_add_ps(r, _mm256_loadu_ps(s.radius + i));
+		const __m256 distanceSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+		count = AppendMaskedIndices(static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(distanceSq, _mm256_mul_ps(radius, radius), _CMP_LE_OQ))), i, out, count);
+	}
+	_mm256_zeroupper();
+	return FindSpheresScalar(sphere, s, out, i, count);
+}
+
+#pragma endregion
+
+#endif // KAMATA_SIMD_X86
+
+} // namespace
+
+size_t FindCollisions(const AABB& aabb, const AABBSoA& boxes, std::span<uint32_t> hitIndices) {
+	assert(hitIndices.size() >= boxes.size);
+	const Vector3 center = (aabb.min + aabb.max) * 0.5f;
+	const Vector3 extent = (aabb.max - aabb.min) * 0.5f;
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		return FindAABBsAVX2(center, extent, boxes, hitIndices.data());
+	case SimdLevel::kSSE:
+		return FindAABBsSSE(center, extent, boxes, hitIndices.data());
+#endif
+	default:
+		return FindAABBsScalar(center, extent, boxes, hitIndices.data(), 0, 0);
+	}
+}
+
+size_t FindCollisions(const Sphere& sphere, const SphereSoA& spheres, std::span<uint32_t> hitIndices) {
+	assert(hitIndices.size() >= spheres.size);
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		return FindSpheresAVX2(sphere, spheres, hitIndices.data());
+	case SimdLevel::kSSE:
+		return FindSpheresSSE(sphere, spheres, hitIndices.data());
+#endif
+	default:
+		return FindSpheresScalar(sphere, spheres, hitIndices.data(), 0, 0);
+	}
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
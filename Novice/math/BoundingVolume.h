@@ -0,0 +1,95 @@
+#pragma once
+
+#include "math/Matrix4x4.h"
+#include "math/Vector3.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace KamataEngine {
+
+/// <summary>
+/// 軸平行境界ボックス
+/// </summary>
+struct AABB final {
+	Vector3 min; // 最小点
+	Vector3 max; // 最大点
+};
+
+/// <summary>
+/// 境界球
+/// </summary>
+struct Sphere final {
+	Vector3 center; // 中心点
+	float radius;   // 半径
+};
+
+/// <summary>
+/// 有向境界ボックス
+/// </summary>
+struct OBB final {
+	Vector3 center;          // 中心点
+	Vector3 orientations[3]; // 座標軸（正規化・直交済み）
+	Vector3 size;            // 座標軸方向の長さの半分
+};
+
+/// <summary>
+/// SoA 形式の境界球配列
+/// </summary>
+struct SphereSoA {
+	const float* x;
+	const float* y;
+	const float* z;
+	const float* radius;
+	size_t size;
+};
+
+/// <summary>
+/// SoA 形式の軸平行境界ボックス配列（中心と半径で表す）
+/// </summary>
+struct AABBSoA {
+	const float* centerX;
+	const float* centerY;
+	const float* centerZ;
+	const float* extentX;
+	const float* extentY;
+	const float* extentZ;
+	size_t size;
+};
+
+namespace MathUtility {
+
+// 点群を囲む境界を求める（stride は点と点の間のバイト数。頂点構造体の先頭が座標なら sizeof(頂点) を渡す）
+AABB MakeAABB(const Vector3* points, size_t count, size_t stride = sizeof(Vector3));
+Sphere MakeSphere(const Vector3* points, size_t count, size_t stride = sizeof(Vector3));
+// 主成分分析で軸を決めた有向境界ボックス
+OBB MakeOBB(const Vector3* points, size_t count, size_t stride = sizeof(Vector3));
+
+// 他の境界との変換
+Sphere MakeSphere(const AABB& aabb);
+OBB MakeOBB(const AABB& aabb);
+AABB MakeAABB(const OBB& obb);
+
+// 2つの境界を囲む境界を求める
+AABB Merge(const AABB& a, const AABB& b);
+Sphere Merge(const Sphere& a, const Sphere& b);
+
+// ワールド行列で変換した境界を求める（WorldTransform::matWorld_ などを渡す）
+AABB Transform(const AABB& aabb, const Matrix4x4& m);
+Sphere Transform(const Sphere& sphere, const Matrix4x4& m);
+OBB Transform(const OBB& obb, const Matrix4x4& m);
+
+// 衝突判定
+bool IsCollision(const AABB& a, const AABB& b);
+bool IsCollision(const Sphere& a, const Sphere& b);
+bool IsCollision(const AABB& aabb, const Sphere& sphere);
+bool IsCollision(const OBB& a, const OBB& b);
+
+// 1つの境界と配列の各要素の衝突判定をまとめて行う
+// 衝突した要素の番号を hitIndices に昇順で詰めて書き込み、その数を返す。hitIndices の要素数は入力の要素数以上であること。
+size_t FindCollisions(const AABB& aabb, const AABBSoA& boxes, std::span<uint32_t> hitIndices);
+size_t FindCollisions(const Sphere& sphere, const SphereSoA& spheres, std::span<uint32_t> hitIndices);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,34 @@
+#include "math/Easing.h"
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+float Ease(EaseType type, float t) {
+	switch (type) {
+	case EaseType::kInQuad:
+		return Ease<EaseType::kInQuad>(t);
+	case EaseType::kOutQuad:
+		return Ease<EaseType::kOutQuad>(t);
+	case EaseType::kInOutQuad:
+		return Ease<EaseType::kInOutQuad>(t);
+	case EaseType::kInCubic:
+		return Ease<EaseType::kInCubic>(t);
+	case EaseType::kOutCubic:
+		return Ease<EaseType::kOutCubic>(t);
+	case EaseType::kInOutCubic:
+		return Ease<EaseType::kInOutCubic>(t);
+	case EaseType::kInBack:
+		return Ease<EaseType::kInBack>(t);
+	case EaseType::kOutBack:
+		return Ease<EaseType::kOutBack>(t);
+	case EaseType::kSmoothStep:
+		return Ease<EaseType::kSmoothStep>(t);
+	default:
+		return Ease<EaseType::kLinear>(t);
+	}
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
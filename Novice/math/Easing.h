@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+
+namespace KamataEngine {
+
+/// <summary>
+/// イージングの種類
+/// </summary>
+enum class EaseType {
+	kLinear,     // 等速
+	kInQuad,     // 2次で加速
+	kOutQuad,    // 2次で減速
+	kInOutQuad,  // 2次で加速して減速
+	kInCubic,    // 3次で加速
+	kOutCubic,   // 3次で減速
+	kInOutCubic, // 3次で加速して減速
+	kInBack,     // 一度戻ってから加速
+	kOutBack,    // 行き過ぎてから戻る
+	kSmoothStep, // smoothstep (3t^2 - 2t^3)
+	kCount,
+};
+
+namespace MathUtility {
+
+// イージングの係数（Back 系の行き過ぎ量）
+inline constexpr float kEaseBack1 = 1.70158f;
+inline constexpr float kEaseBack3 = kEaseBack1 + 1.0f;
+
+// イージング関数（t は 0 ～ 1。TweenSystem の SIMD 版もこれと同じ演算順で計算する）
+template<EaseType kType> inline float Ease(float t) {
+	const float u = 1.0f - t;
+	if constexpr (kType == EaseType::kInQuad) {
+		return t * t;
+	} else if constexpr (kType == EaseType::kOutQuad) {
+		return 1.0f - u * u;
+	} else if constexpr (kType == EaseType::kInOutQuad) {
+		return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * u * u;
+	} else if constexpr (kType == EaseType::kInCubic) {
+		return t * t * t;
+	} else if constexpr (kType == EaseType::kOutCubic) {
+		return 1.0f - u * u * u;
+	} else if constexpr (kType == EaseType::kInOutCubic) {
+		return t < 0.5f ? 4.0f * t * t * t : 1.0f - 4.0f * u * u * u;
+	} else if constexpr (kType == EaseType::kInBack) {
+		return t * t * (kEaseBack3 * t - kEaseBack1);
+	} else if constexpr (kType == EaseType::kOutBack) {
+		return 1.0f - u * u * (kEaseBack3 * u - kEaseBack1);
+	} else if constexpr (kType == EaseType::kSmoothStep) {
+		return t * t * (3.0f - 2.0f * t);
+	} else {
+		return t;
+	}
+}
+
+// イージング関数（種類を実行時に指定する）
+float Ease(EaseType type, float t);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
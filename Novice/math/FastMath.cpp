@@ -0,0 +1,286 @@
+#include "math/FastMath.h"
+#include <cassert>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+namespace {
+
+using namespace FastMathDetail;
+
+#pragma region スカラー版
+
+template<FastMathPrecision kPrecision> void SinCosScalar(const float* angles, float* sines, float* cosines, size_t begin, size_t end) {
+	for (size_t i = begin; i < end; ++i) {
+		FastSinCos<kPrecision>(angles[i], sines[i], cosines[i]);
+	}
+}
+
+template<FastMathPrecision kPrecision> void RsqrtScalar(const float* src, float* dst, size_t begin, size_t end) {
+	for (size_t i = begin; i < end; ++i) {
+		dst[i] = FastRsqrt<kPrecision>(src[i]);
+	}
+}
+
+template<FastMathPrecision kPrecision> void NormalizeScalar(const Vector3* src, Vector3* dst, size_t begin, size_t end) {
+	for (size_t i = begin; i < end; ++i) {
+		Vector3 v = src[i];
+		dst[i] = FastNormalize<kPrecision>(v);
+	}
+}
+
+#pragma endregion
+
+#if KAMATA_SIMD_X86
+
+#pragma region SSE版
+
+// スカラー版の SinCosReduced と FastSinCos の象限処理を 4 要素ずつ行う
+template<FastMathPrecision kPrecision> inline void SinCosSSE(__m128 x, __m128& sine, __m128& cosine) {
+	const __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(kTwoOverPi)));
+	const __m128 q = _mm_cvtepi32_ps(quadrant);
+	const __m128 r = _mm_sub_ps(
+	    _mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(kHalfPi1))), _mm_mul_ps(q, _mm_set1_ps(kHalfPi2))), _mm_mul_ps(q, _mm_set1_ps(kHalfPi3)));
+	const __m128 z = _mm_mul_ps(r, r);
+	using C = Coefficients<kPrecision>;
+	__m128 ps, pc;
+	if constexpr (kPrecision == FastMathPrecision::kHigh) {
+		ps = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(C::kSin[2]), z), _mm_set1_ps(C::kSin[1])), z), _mm_set1_ps(C::kSin[0]));
+		pc = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(C::kCos[2]), z), _mm_set1_ps(C::kCos[1])), z), _mm_set1_ps(C::kCos[0]));
+	} else {
+		ps = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(C::kSin[1]), z), _mm_set1_ps(C::kSin[0]));
+		pc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(C::kCos[1]), z), _mm_set1_ps(C::kCos[0]));
+	}
+	const __m128 s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, z), r), r);
+	const __m128 c = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(pc, z), z), _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_set1_ps(1.0f));
+
+	const __m128i one = _mm_set1_epi32(1);
+	const __m128i two = _mm_set1_epi32(2);
+	const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+	const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+	const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+	const __m128 swappedSin = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+	const __m128 swappedCos = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+	sine = _mm_xor_ps(swappedSin, sinSign);
+	cosine = _mm_xor_ps(swappedCos, cosSign);
+}
+
+template<FastMathPrecision kPrecision> inline __m128 RsqrtSSE(__m128 x) {
+	const __m128 y = _mm_rsqrt_ps(x);
+	if constexpr (kPrecision == FastMathPrecision::kHigh) {
+		return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), y), y)));
+	} else {
+		return y;
+	}
+}
+
+template<FastMathPrecision kPrecision> void SinCosSSE(const float* angles, float* sines, float* cosines, size_t count) {
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 s, c;
+		SinCosSSE<kPrecision>(_mm_loadu_ps(angles + i), s, c);
+		_mm_storeu_ps(sines + i, s);
+		_mm_storeu_ps(cosines + i, c);
+	}
+	SinCosScalar<kPrecision>(angles, sines, cosines, i, count);
+}
+
+template<FastMathPrecision kPrecision> void RsqrtSSE(const float* src, float* dst, size_t count) {
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(dst + i, RsqrtSSE<kPrecision>(_mm_loadu_ps(src + i)));
+	}
+	RsqrtScalar<kPrecision>(src, dst, i, count);
+}
+
+template<FastMathPrecision kPrecision> void NormalizeSSE(const Vector3* src, Vector3* dst, size_t count) {
+	const float* in = reinterpret_cast<const float*>(src);
+	float* out = reinterpret_cast<float*>(dst);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z;
+		Deinterleave4(in + i * 3, x, y, z);
+		const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+		const __m128 nonZero = _mm_cmpgt_ps(lengthSq, _mm_setzero_ps());
+		const __m128 invLength = RsqrtSSE<kPrecision>(lengthSq);
+		x = _mm_or_ps(_mm_and_ps(nonZero, _mm_mul_ps(x, invLength)), _mm_andnot_ps(nonZero, x));
+		y = _mm_or_ps(_mm_and_ps(nonZero, _mm_mul_ps(y, invLength)), _mm_andnot_ps(nonZero, y));
+		z = _mm_or_ps(_mm_and_ps(nonZero, _mm_mul_ps(z, invLength)), _mm_andnot_ps(nonZero, z));
+		Interleave4(out + i * 3, x, y, z);
+	}
+	NormalizeScalar<kPrecision>(src, dst, i, count);
+}
+
+#pragma endregion
+
+#pragma region AVX2版
+
+template<FastMathPrecision kPrecision> KAMATA_TARGET_AVX2 inline void SinCosAVX(__m256 x, __m256& sine, __m256& cosine) {
+	const __m256i quadrant = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(kTwoOverPi)));
+	const __m256 q = _mm256_cvtepi32_ps(quadrant);
+	const __m256 r = _mm256_sub_ps(
+	    _mm256_sub_ps(_mm256_sub_ps(x, _mm256_mul_ps(q, _mm256_set1_ps(kHalfPi1))), _mm256_mul_ps(q, _mm256_set1_ps(kHalfPi2))),
+	    _mm256_mul_ps(q, _mm256_set1_ps(kHalfPi3)));
+	const __m256 z = _mm256_mul_ps(r, r);
+	using C = Coefficients<kPrecision>;
+	__m256 ps, pc;
+	if constexpr (kPrecision == FastMathPrecision::kHigh) {
+		ps = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(C::kSin[2]), z), _mm256_set1_ps(C::kSin[1])), z), _mm256_set1_ps(C::kSin[0]));
+		pc = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(C::kCos[2]), z), _mm256_set1_ps(C::kCos[1])), z), _mm256_set1_ps(C::kCos[0]));
+	} else {
+		ps = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(C::kSin[1]), z), _mm256_set1_ps(C::kSin[0]));
+		pc = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(C::kCos[1]), z), _mm256_set1_ps(C::kCos[0]));
+	}
+	const __m256 s = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(ps, z), r), r);
+	const __m256 c = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(pc, z), z), _mm256_mul_ps(_mm256_set1_ps(0.5f), z)), _mm256_set1_ps(1.0f));
+
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i two = _mm256_set1_epi32(2);
+	const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, one), one));
+	const __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, two), 30));
+	const __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, one), two), 30));
+	sine = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sinSign);
+	cosine = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosSign);
+}
+
+template<FastMathPrecision kPrecision> KAMATA_TARGET_AVX2 inline __m256 RsqrtAVX(__m256 x) {
+	const __m256 y = _mm256_rsqrt_ps(x);
+	if constexpr (kPrecision == FastMathPrecision::kHigh) {
+		return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x), y), y)));
+	} else {
+		return y;
+	}
+}
+
+template<FastMathPrecision kPrecision> KAMATA_TARGET_AVX2 void SinCosAVX2(const float* angles, float* sines, float* cosines, size_t count) {
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 s, c;
+		SinCosAVX<kPrecision>(_mm256_loadu_ps(angles + i), s, c);
+		_mm256_storeu_ps(sines + i, s);
+		_mm256_storeu_ps(cosines + i, c);
+	}
+	_mm256_zeroupper();
+	SinCosScalar<kPrecision>(angles, sines, cosines, i, count);
+}
+
+template<FastMathPrecision kPrecision> KAMATA_TARGET_AVX2 void RsqrtAVX2(const float* src, float* dst, size_t count) {
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(dst + i, RsqrtAVX<kPrecision>(_mm256_loadu_ps(src + i)));
+	}
+	_mm256_zeroupper();
+	RsqrtScalar<kPrecision>(src, dst, i, count);
+}
+
+KAMATA_TARGET_AVX2 inline __m256 Combine(__m128 lo, __m128 hi) { return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1); }
+
+template<FastMathPrecision kPrecision> KAMATA_TARGET_AVX2 void NormalizeAVX2(const Vector3* src, Vector3* dst, size_t count) {
+	const float* in = reinterpret_cast<const float*>(src);
+	float* out = reinterpret_cast<float*>(dst);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128 x0, y0, z0, x1, y1, z1;
+		Deinterleave4(in + i * 3, x0, y0, z0);
+		Deinterleave4(in + i * 3 + 12, x1, y1, z1);
+		__m256 x = Combine(x0, x1);
+		__m256 y = Combine(y0, y1);
+		__m256 z = Combine(z0, z1);
+		const __m256 lengthSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+		const __m256 nonZero = _mm256_cmp_ps(lengthSq, _mm256_setzero_ps(), _CMP_GT_OQ);
+		const __m256 invLength = RsqrtAVX<kPrecision>(lengthSq);
+		x = _mm256_blendv_ps(x, _mm256_mul_ps(x, invLength), nonZero);
+		y = _mm256_blendv_ps(y, _mm256_mul_ps(y, invLength), nonZero);
+		z = _mm256_blendv_ps(z, _mm256_mul_ps(z, invLength), nonZero);
+		Interleave4(out + i * 3, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+		Interleave4(out + i * 3 + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+	}
+	_mm256_zeroupper();
+	NormalizeScalar<kPrecision>(src, dst, i, count);
+}
+
+#pragma endregion
+
+#endif // KAMATA_SIMD_X86
+
+template<FastMathPrecision kPrecision> void SinCos(const float* angles, float* sines, float* cosines, size_t count) {
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		SinCosAVX2<kPrecision>(angles, sines, cosines, count);
+		return;
+	case SimdLevel::kSSE:
+		SinCosSSE<kPrecision>(angles, sines, cosines, count);
+		return;
+#endif
+	default:
+		SinCosScalar<kPrecision>(angles, sines, cosines, 0, count);
+		return;
+	}
+}
+
+template<FastMathPrecision kPrecision> void Rsqrt(const float* src, float* dst, size_t count) {
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		RsqrtAVX2<kPrecision>(src, dst, count);
+		return;
+	case SimdLevel::kSSE:
+		RsqrtSSE<kPrecision>(src, dst, count);
+		return;
+#endif
+	default:
+		RsqrtScalar<kPrecision>(src, dst, 0, count);
+		return;
+	}
+}
+
+template<FastMathPrecision kPrecision> void Normalize(const Vector3* src, Vector3* dst, size_t count) {
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		NormalizeAVX2<kPrecision>(src, dst, count);
+		return;
+	case SimdLevel::kSSE:
+		NormalizeSSE<kPrecision>(src, dst, count);
+		return;
+#endif
+	default:
+		NormalizeScalar<kPrecision>(src, dst, 0, count);
+		return;
+	}
+}
+
+} // namespace
+
+void FastSinCos(std::span<const float> angles, std::span<float> sines, std::span<float> cosines, FastMathPrecision precision) {
+	assert(sines.size() >= angles.size() && cosines.size() >= angles.size());
+	if (precision == FastMathPrecision::kHigh) {
+		SinCos<FastMathPrecision::kHigh>(angles.data(), sines.data(), cosines.data(), angles.size());
+	} else {
+		SinCos<FastMathPrecision::kLow>(angles.data(), sines.data(), cosines.data(), angles.size());
+	}
+}
+
+void FastRsqrt(std::span<const float> src, std::span<float> dst, FastMathPrecision precision) {
+	assert(dst.size() >= src.size());
+	if (precision == FastMathPrecision::kHigh) {
+		Rsqrt<FastMathPrecision::kHigh>(src.data(), dst.data(), src.size());
+	} else {
+		Rsqrt<FastMathPrecision::kLow>(src.data(), dst.data(), src.size());
+	}
+}
+
+void FastNormalize(std::span<const Vector3> src, std::span<Vector3> dst, FastMathPrecision precision) {
+	assert(dst.size() >= src.size());
+	if (precision == FastMathPrecision::kHigh) {
+		Normalize<FastMathPrecision::kHigh>(src.data(), dst.data(), src.size());
+	} else {
+		Normalize<FastMathPrecision::kLow>(src.data(), dst.data(), src.size());
+	}
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
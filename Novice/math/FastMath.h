@@ -0,0 +1,176 @@
+#pragma once
+
+#include "math/Matrix4x4.h"
+#include "math/SimdSupport.h"
+#include "math/Vector3.h"
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+namespace KamataEngine {
+
+/// <summary>
+/// 近似関数の精度
+/// </summary>
+enum class FastMathPrecision {
+	kLow,  // 低精度（sin/cos の最大絶対誤差 1e-6 程度、rsqrt の最大相対誤差 4e-4 程度）
+	kHigh, // 高精度（sin/cos の最大絶対誤差 1e-7 程度、rsqrt の最大相対誤差 3e-7 程度）
+};
+
+// 既定の精度（KAMATA_FAST_MATH_LOW_PRECISION を定義してビルドすると低精度になる）
+#ifdef KAMATA_FAST_MATH_LOW_PRECISION
+inline constexpr FastMathPrecision kDefaultFastMathPrecision = FastMathPrecision::kLow;
+#else
+inline constexpr FastMathPrecision kDefaultFastMathPrecision = FastMathPrecision::kHigh;
+#endif
+
+namespace MathUtility {
+
+// libm を使わない sin / cos / 1/sqrt の近似。
+// sin / cos は π/2 単位で [-π/4, π/4] に範囲を縮めて多項式で計算する。|x| <= 8192 で上記の誤差に収まる。
+// バッチ版は SetSimdLevel で選択された SSE / AVX2 カーネルで処理し、sin / cos はどのレベルでもスカラー版と一致する。
+
+namespace FastMathDetail {
+
+// π/2 を3つに分けた値（積が丸め誤差なしで計算できる桁数にしてある）
+inline constexpr float kHalfPi1 = 1.5703125f;
+inline constexpr float kHalfPi2 = 4.837512969970703125e-4f;
+inline constexpr float kHalfPi3 = 7.54978995489188216e-8f;
+inline constexpr float kTwoOverPi = 0.636619772367581343f;
+
+// [-π/4, π/4] での多項式の係数（z = r^2）
+// sin(r) = r + r * z * (S1 + z * (S2 + z * S3))
+// cos(r) = 1 - z / 2 + z * z * (C1 + z * (C2 + z * C3))
+template<FastMathPrecision kPrecision> struct Coefficients;
+template<> struct Coefficients<FastMathPrecision::kHigh> {
+	static constexpr float kSin[3] = {-1.6666654611e-1f, 8.3321608736e-3f, -1.9515295891e-4f};
+	static constexpr float kCos[3] = {4.166664568298827e-2f, -1.388731625493765e-3f, 2.443315711809948e-5f};
+};
+template<> struct Coefficients<FastMathPrecision::kLow> {
+	static constexpr float kSin[2] = {-1.66628338e-1f, 8.15299165e-3f};
+	static constexpr float kCos[2] = {4.16612786e-2f, -1.36524494e-3f};
+};
+
+// 範囲縮小後の sin / cos と象限
+template<FastMathPrecision kPrecision> inline void SinCosReduced(float x, float& s, float& c, int& quadrant) {
+	// SIMD 版の整数変換と同じく最近接偶数丸め
+#if KAMATA_SIMD_X86
+	quadrant = _mm_cvtss_si32(_mm_set_ss(x * kTwoOverPi));
+#else
+	quadrant = static_cast<int>(std::lrint(x * kTwoOverPi));
+#endif
+	const float q = static_cast<float>(quadrant);
+	const float r = ((x - q * kHalfPi1) - q * kHalfPi2) - q * kHalfPi3;
+	const float z = r * r;
+	using C = Coefficients<kPrecision>;
+	float ps, pc;
+	if constexpr (kPrecision == FastMathPrecision::kHigh) {
+		ps = (C::kSin[2] * z + C::kSin[1]) * z + C::kSin[0];
+		pc = (C::kCos[2] * z + C::kCos[1]) * z + C::kCos[0];
+	} else {
+		ps = C::kSin[1] * z + C::kSin[0];
+		pc = C::kCos[1] * z + C::kCos[0];
+	}
+	s = ps * z * r + r;
+	c = (pc * z * z - 0.5f * z) + 1.0f;
+}
+
+} // namespace FastMathDetail
+
+// sin と cos を同時に求める
+template<FastMathPrecision kPrecision = kDefaultFastMathPrecision> inline void FastSinCos(float x, float& sine, float& cosine) {
+	float s, c;
+	int quadrant;
+	FastMathDetail::SinCosReduced<kPrecision>(x, s, c, quadrant);
+	// 象限に応じて入れ替えと符号反転を行う（象限は入力次第で偏らないので分岐させない）
+	const uint32_t sBits = std::bit_cast<uint32_t>(s);
+	const uint32_t cBits = std::bit_cast<uint32_t>(c);
+	const uint32_t swap = 0u - static_cast<uint32_t>(quadrant & 1);
+	const uint32_t sinSign = static_cast<uint32_t>(quadrant & 2) << 30;
+	const uint32_t cosSign = static_cast<uint32_t>((quadrant + 1) & 2) << 30;
+	sine = std::bit_cast<float>(((sBits & ~swap) | (cBits & swap)) ^ sinSign);
+	cosine = std::bit_cast<float>(((cBits & ~swap) | (sBits & swap)) ^ cosSign);
+}
+
+template<FastMathPrecision kPrecision = kDefaultFastMathPrecision> inline float FastSin(float x) {
+	float s, c;
+	FastSinCos<kPrecision>(x, s, c);
+	return s;
+}
+
+template<FastMathPrecision kPrecision = kDefaultFastMathPrecision> inline float FastCos(float x) {
+	float s, c;
+	FastSinCos<kPrecision>(x, s, c);
+	return c;
+}
+
+// 1 / sqrt(x) を求める（x > 0 であること）
+template<FastMathPrecision kPrecision = kDefaultFastMathPrecision> inline float FastRsqrt(float x) {
+#if KAMATA_SIMD_X86
+	const float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+	if constexpr (kPrecision == FastMathPrecision::kHigh) {
+		// ニュートン法で1回補正する
+		return y * (1.5f - 0.5f * x * y * y);
+	} else {
+		return y;
+	}
+#else
+	return 1.0f / std::sqrt(x);
+#endif
+}
+
+// ノルム(長さ)を求める
+template<FastMathPrecision kPrecision = kDefaultFastMathPrecision> inline float FastLength(const Vector3& v) {
+	const float lengthSq = v.x * v.x + v.y * v.y + v.z * v.z;
+	return lengthSq > 0.0f ? lengthSq * FastRsqrt<kPrecision>(lengthSq) : 0.0f;
+}
+
+// 正規化する（零ベクトルはそのまま）
+template<FastMathPrecision kPrecision = kDefaultFastMathPrecision> inline Vector3& FastNormalize(Vector3& v) {
+	const float lengthSq = v.x * v.x + v.y * v.y + v.z * v.z;
+	if (lengthSq > 0.0f) {
+		const float invLength = FastRsqrt<kPrecision>(lengthSq);
+		v.x *= invLength;
+		v.y *= invLength;
+		v.z *= invLength;
+	}
+	return v;
+}
+
+// 回転行列の作成（MakeRotateXMatrix などと同じ形で、sin / cos を近似する）
+template<FastMathPrecision kPrecision = kDefaultFastMathPrecision> inline Matrix4x4 FastMakeRotateXMatrix(float angle) {
+	float s, c;
+	FastSinCos<kPrecision>(angle, s, c);
+	return {
+	    {{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, c, s, 0.0f}, {0.0f, -s, c, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}}
+    };
+}
+
+template<FastMathPrecision kPrecision = kDefaultFastMathPrecision> inline Matrix4x4 FastMakeRotateYMatrix(float angle) {
+	float s, c;
+	FastSinCos<kPrecision>(angle, s, c);
+	return {
+	    {{c, 0.0f, -s, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {s, 0.0f, c, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}}
+    };
+}
+
+template<FastMathPrecision kPrecision = kDefaultFastMathPrecision> inline Matrix4x4 FastMakeRotateZMatrix(float angle) {
+	float s, c;
+	FastSinCos<kPrecision>(angle, s, c);
+	return {
+	    {{c, s, 0.0f, 0.0f}, {-s, c, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}}
+    };
+}
+
+// 複数の角度の sin と cos をまとめて求める
+// sines, cosines の要素数は angles 以上であること。
+void FastSinCos(std::span<const float> angles, std::span<float> sines, std::span<float> cosines, FastMathPrecision precision = kDefaultFastMathPrecision);
+// 複数の値の 1 / sqrt(x) をまとめて求める（dst の要素数は src 以上。src と dst は同じ配列でもよい）
+void FastRsqrt(std::span<const float> src, std::span<float> dst, FastMathPrecision precision = kDefaultFastMathPrecision);
+// 複数のベクトルをまとめて正規化する（dst の要素数は src 以上。src と dst は同じ配列でもよい）
+void FastNormalize(std::span<const Vector3> src, std::span<Vector3> dst, FastMathPrecision precision = kDefaultFastMathPrecision);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
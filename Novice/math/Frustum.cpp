@@ -0,0 +1,234 @@
+#include "math/Frustum.h"
+#include "math/SimdSupport.h"
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+Frustum MakeFrustum(const Matrix4x4& viewProjection) {
+	// 行ベクトル p * M のクリップ座標は p と M の各列の内積なので、列同士の和差から平面を作る
+	const Matrix4x4& m = viewProjection;
+	auto column = [&m](int c) { return Vector4{m.m[0][c], m.m[1][c], m.m[2][c], m.m[3][c]}; };
+	const Vector4 c0 = column(0);
+	const Vector4 c1 = column(1);
+	const Vector4 c2 = column(2);
+	const Vector4 c3 = column(3);
+
+	Frustum frustum;
+	frustum.planes[Frustum::kLeft] = {c3.x + c0.x, c3.y + c0.y, c3.z + c0.z, c3.w + c0.w};
+	frustum.planes[Frustum::kRight] = {c3.x - c0.x, c3.y - c0.y, c3.z - c0.z, c3.w - c0.w};
+	frustum.planes[Frustum::kBottom] = {c3.x + c1.x, c3.y + c1.y, c3.z + c1.z, c3.w + c1.w};
+	frustum.planes[Frustum::kTop] = {c3.x - c1.x, c3.y - c1.y, c3.z - c1.z, c3.w - c1.w};
+	// 深度は 0 <= z <= w
+	frustum.planes[Frustum::kNear] = c2;
+	frustum.planes[Frustum::kFar] = {c3.x - c2.x, c3.y - c2.y, c3.z - c2.z, c3.w - c2.w};
+
+	for (Vector4& plane : frustum.planes) {
+		const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+		if (length > 0.0f) {
+			plane = {plane.x / length, plane.y / length, plane.z / length, plane.w / length};
+		}
+	}
+	return frustum;
+}
+
+Frustum MakeFrustum(const Matrix4x4& viewProjection, DepthMode depthMode) {
+	Frustum frustum = MakeFrustum(viewProjection);
+	// 逆Z では z <= w がニア、0 <= z がファー
+	if (IsReverseZ(depthMode)) {
+		std::swap(frustum.planes[Frustum::kNear], frustum.planes[Frustum::kFar]);
+	}
+	return frustum;
+}
+
+bool IsVisible(const Frustum& frustum, const Vector3& center, float radius) {
+	for (const Vector4& p : frustum.planes) {
+		if (!(center.x * p.x + center.y * p.y + center.z * p.z + p.w >= -radius)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool IsVisible(const Frustum& frustum, const Vector3& center, const Vector3& extent) {
+	for (const Vector4& p : frustum.planes) {
+		const float distance = center.x * p.x + center.y * p.y + center.z * p.z + p.w;
+		const float radius = extent.x * std::fabs(p.x) + extent.y * std::fabs(p.y) + extent.z * std::fabs(p.z);
+		if (!(distance >= -radius)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool IsVisible(const Frustum& frustum, const Sphere& sphere) { return IsVisible(frustum, sphere.center, sphere.radius); }
+
+bool IsVisible(const Frustum& frustum, const AABB& aabb) {
+	const Vector3 center = {(aabb.min.x + aabb.max.x) * 0.5f, (aabb.min.y + aabb.max.y) * 0.5f, (aabb.min.z + aabb.max.z) * 0.5f};
+	const Vector3 extent = {(aabb.max.x - aabb.min.x) * 0.5f, (aabb.max.y - aabb.min.y) * 0.5f, (aabb.max.z - aabb.min.z) * 0.5f};
+	return IsVisible(frustum, center, extent);
+}
+
+namespace {
+
+#pragma region スカラー版
+
+size_t CullSpheresScalar(const Frustum& frustum, const SphereSoA& s, uint32_t* out, size_t begin, size_t count) {
+	for (size_t i = begin; i < s.size; ++i) {
+		if (IsVisible(frustum, {s.x[i], s.y[i], s.z[i]}, s.radius[i])) {
+			out[count++] = static_cast<uint32_t>(i);
+		}
+	}
+	return count;
+}
+
+size_t CullAABBsScalar(const Frustum& frustum, const AABBSoA& b, uint32_t* out, size_t begin, size_t count) {
+	for (size_t i = begin; i < b.size; ++i) {
+		if (IsVisible(frustum, {b.centerX[i], b.centerY[i], b.centerZ[i]}, {b.extentX[i], b.extentY[i], b.extentZ[i]})) {
+			out[count++] = static_cast<uint32_t>(i);
+		}
+	}
+	return count;
+}
+
+#pragma endregion
+
+#if KAMATA_SIMD_X86
+
+#pragma region SSE版
+
+size_t CullSpheresSSE(const Frustum& frustum, const SphereSoA& s, uint32_t* out) {
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	size_t count = 0;
+	size_t i = 0;
+	for (; i + 4 <= s.size; i += 4) {
+		const __m128 x = _mm_loadu_ps(s.x + i);
+		const __m128 y = _mm_loadu_ps(s.y + i);
+		const __m128 z = _mm_loadu_ps(s.z + i);
+		const __m128 negRadius = _mm_xor_ps(_mm_loadu_ps(s.radius + i), signMask);
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (const Vector4& p : frustum.planes) {
+			const __m128 distance = _mm_add_ps(
+			    _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(p.x)), _mm_mul_ps(y, _mm_set1_ps(p.y))), _mm_mul_ps(z, _mm_set1_ps(p.z))), _mm_set1_ps(p.w));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+		}
+		count = AppendMaskedIndices(static_cast<uint32_t>(_mm_movemask_ps(inside)), i, out, count);
+	}
+	return CullSpheresScalar(frustum, s, out, i, count);
+}
+
+size_t CullAABBsSSE(const Frustum& frustum, const AABBSoA& b, uint32_t* out) {
+	size_t count = 0;
+	size_t i = 0;
+	for (; i + 4 <= b.size; i += 4) {
+		const __m128 cx = _mm_loadu_ps(b.centerX + i);
+		const __m128 cy = _mm_loadu_ps(b.centerY + i);
+		const __m128 cz = _mm_loadu_ps(b.centerZ + i);
+		const __m128 ex = _mm_loadu_ps(b.extentX + i);
+		const __m128 ey = _mm_loadu_ps(b.extentY + i);
+		const __m128 ez = _mm_loadu_ps(b.extentZ + i);
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (const Vector4& p : frustum.planes) {
+			const __m128 distance = _mm_add_ps(
+			    _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(p.x)), _mm_mul_ps(cy, _mm_set1_ps(p.y))), _mm_mul_ps(cz, _mm_set1_ps(p.z))), _mm_set1_ps(p.w));
+			const __m128 radius = _mm_add_ps(
+			    _mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(std::fabs(p.x))), _mm_mul_ps(ey, _mm_set1_ps(std::fabs(p.y)))), _mm_mul_ps(ez, _mm_set1_ps(std::fabs(p.z))));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_sub_ps(_mm_setzero_ps(), radius)));
+		}
+		count = AppendMaskedIndices(static_cast<uint32_t>(_mm_movemask_ps(inside)), i, out, count);
+	}
+	return CullAABBsScalar(frustum, b, out, i, count);
+}
+
+#pragma endregion
+
+#pragma region AVX2版
+
+KAMATA_TARGET_AVX2 size_t CullSpheresAVX2(const Frustum& frustum, const SphereSoA& s, uint32_t* out) {
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	size_t count = 0;
+	size_t i = 0;
+	for (; i + 8 <= s.size; i += 8) {
+		const __m256 x = _mm256_loadu_ps(s.x + i);
+		const __m256 y = _mm256_loadu_ps(s.y + i);
+		const __m256 z = _mm256_loadu_ps(s.z + i);
+		const __m256 negRadius = _mm256_xor_ps(_mm256_loadu_ps(s.radius + i), signMask);
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (const Vector4& p : frustum.planes) {
+			const __m256 distance = _mm256_add_ps(
+			    _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(p.x)), _mm256_mul_ps(y, _mm256_set1_ps(p.y))), _mm256_mul_ps(z, _mm256_set1_ps(p.z))),
+			    _mm256_set1_ps(p.w));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+		}
+		count = AppendMaskedIndices(static_cast<uint32_t>(_mm256_movemask_ps(inside)), i, out, count);
+	}
+	_mm256_zeroupper();
+	return CullSpheresScalar(frustum, s, out, i, count);
+}
+
+KAMATA_TARGET_AVX2 size_t CullAABBsAVX2(const Frustum& frustum, const AABBSoA& b, uint32_t* out) {
+	size_t count = 0;
+	size_t i = 0;
+	for (; i + 8 <= b.size; i += 8) {
+		const __m256 cx = _mm256_loadu_ps(b.centerX + i);
+		const __m256 cy = _mm256_loadu_ps(b.centerY + i);
+		const __m256 cz = _mm256_loadu_ps(b.centerZ + i);
+		const __m256 ex = _mm256_loadu_ps(b.extentX + i);
+		const __m256 ey = _mm256_loadu_ps(b.extentY + i);
+		const __m256 ez = _mm256_loadu_ps(b.extentZ + i);
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (const Vector4& p : frustum.planes) {
+			const __m256 distance = _mm256_add_ps(
+			    _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(p.x)), _mm256_mul_ps(cy, _mm256_set1_ps(p.y))), _mm256_mul_ps(cz, _mm256_set1_ps(p.z))),
+			    _mm256_set1_ps(p.w));
+			const __m256 radius = _mm256_add_ps(
+			    _mm256_add_ps(_mm256_mul_ps(ex, _mm256_set1_ps(std::fabs(p.x))), _mm256_mul_ps(ey, _mm256_set1_ps(std::fabs(p.y)))),
+			    _mm256_mul_ps(ez, _mm256_set1_ps(std::fabs(p.z))));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_sub_ps(_mm256_setzero_ps(), radius), _CMP_GE_OQ));
+		}
+		count = AppendMaskedIndices(static_cast<uint32_t>(_mm256_movemask_ps(inside)), i, out, count);
+	}
+	_mm256_zeroupper();
+	return CullAABBsScalar(frustum, b, out, i, count);
+}
+
+#pragma endregion
+
+#endif // KAMATA_SIMD_X86
+
+} // namespace
+
+size_t CullSpheres(const Frustum& frustum, const SphereSoA& spheres, std::span<uint32_t> visibleIndices) {
+	assert(visibleIndices.size() >= spheres.size);
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		return CullSpheresAVX2(frustum, spheres, visibleIndices.data());
+	case SimdLevel::kSSE:
+		return CullSpheresSSE(frustum, spheres, visibleIndices.data());
+#endif
+	default:
+		return CullSpheresScalar(frustum, spheres, visibleIndices.data(), 0, 0);
+	}
+}
+
+size_t CullAABBs(const Frustum& frustum, const AABBSoA& boxes, std::span<uint32_t> visibleIndices) {
+	assert(visibleIndices.size() >= boxes.size);
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		return CullAABBsAVX2(frustum, boxes, visibleIndices.data());
+	case SimdLevel::kSSE:
+		return CullAABBsSSE(frustum, boxes, visibleIndices.data());
+#endif
+	default:
+		return CullAABBsScalar(frustum, boxes, visibleIndices.data(), 0, 0);
+	}
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
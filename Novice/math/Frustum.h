@@ -0,0 +1,56 @@
+#pragma once
+
+#include "math/BoundingVolume.h"
+#include "math/Matrix4x4.h"
+#include "math/Projection.h"
+#include "math/Vector3.h"
+#include "math/Vector4.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace KamataEngine {
+
+/// <summary>
+/// 視錐台
+/// </summary>
+struct Frustum final {
+	// 平面の番号
+	enum PlaneIndex {
+		kLeft,
+		kRight,
+		kBottom,
+		kTop,
+		kNear,
+		kFar,
+		kPlaneCount,
+	};
+
+	// 内向きの単位法線 (x, y, z) と距離 w。dot(n, p) + w >= 0 が内側
+	Vector4 planes[kPlaneCount];
+};
+
+namespace MathUtility {
+
+// ビュー行列 * 射影行列から視錐台を作成
+// 深度の割り当てが逆Z でも判定は変わらないが、kNear と kFar の平面が入れ替わる。
+// 無限遠の割り当てではファーの平面は常に内側と判定される（法線が 0 で距離が正）。
+Frustum MakeFrustum(const Matrix4x4& viewProjection);
+// 深度の割り当てに合わせて kNear と kFar の平面を並べる
+Frustum MakeFrustum(const Matrix4x4& viewProjection, DepthMode depthMode);
+
+// 境界球が視錐台と交差しているか
+bool IsVisible(const Frustum& frustum, const Vector3& center, float radius);
+bool IsVisible(const Frustum& frustum, const Sphere& sphere);
+// 軸平行境界ボックスが視錐台と交差しているか（中心と半径で表す）
+bool IsVisible(const Frustum& frustum, const Vector3& center, const Vector3& extent);
+bool IsVisible(const Frustum& frustum, const AABB& aabb);
+
+// 視錐台と交差する要素の番号を visibleIndices に昇順で詰めて書き込み、その数を返す
+// visibleIndices の要素数は入力の要素数以上であること。
+size_t CullSpheres(const Frustum& frustum, const SphereSoA& spheres, std::span<uint32_t> visibleIndices);
+size_t CullAABBs(const Frustum& frustum, const AABBSoA& boxes, std::span<uint32_t> visibleIndices);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
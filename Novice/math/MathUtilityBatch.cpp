@@ -0,0 +1,260 @@
+#include "math/MathUtilityBatch.h"
+#include "math/SimdSupport.h"
+#include <cassert>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+namespace {
+
+static_assert(sizeof(Vector3) == sizeof(float) * 3);
+
+// 変換の種類
+enum class TransformKind {
+	kPoint,  // w除算なし
+	kCoord,  // w除算あり
+	kNormal, // 平行移動なし
+};
+
+#pragma region スカラー版
+
+template<TransformKind kKind>
+inline void TransformScalar(float x, float y, float z, const Matrix4x4& m, float& outX, float& outY, float& outZ) {
+	float rx = x * m.m[0][0] + y * m.m[1][0] + z * m.m[2][0];
+	float ry = x * m.m[0][1] + y * m.m[1][1] + z * m.m[2][1];
+	float rz = x * m.m[0][2] + y * m.m[1][2] + z * m.m[2][2];
+	if constexpr (kKind != TransformKind::kNormal) {
+		rx = rx + m.m[3][0];
+		ry = ry + m.m[3][1];
+		rz = rz + m.m[3][2];
+	}
+	if constexpr (kKind == TransformKind::kCoord) {
+		const float w = x * m.m[0][3] + y * m.m[1][3] + z * m.m[2][3] + m.m[3][3];
+		rx = rx / w;
+		ry = ry / w;
+		rz = rz / w;
+	}
+	outX = rx;
+	outY = ry;
+	outZ = rz;
+}
+
+template<TransformKind kKind>
+void TransformAoSScalar(const Vector3* src, Vector3* dst, size_t begin, size_t end, const Matrix4x4& m) {
+	for (size_t i = begin; i < end; ++i) {
+		TransformScalar<kKind>(src[i].x, src[i].y, src[i].z, m, dst[i].x, dst[i].y, dst[i].z);
+	}
+}
+
+template<TransformKind kKind>
+void TransformSoAScalar(const ConstVector3SoA& src, const Vector3SoA& dst, size_t begin, size_t end, const Matrix4x4& m) {
+	for (size_t i = begin; i < end; ++i) {
+		TransformScalar<kKind>(src.x[i], src.y[i], src.z[i], m, dst.x[i], dst.y[i], dst.z[i]);
+	}
+}
+
+#pragma endregion
+
+#if KAMATA_SIMD_X86
+
+#pragma region SSE版
+
+// 行列の各要素を全レーンに展開したもの
+struct MatrixSSE {
+	__m128 m[4][4];
+
+	explicit MatrixSSE(const Matrix4x4& src) {
+		for (int r = 0; r < 4; ++r) {
+			for (int c = 0; c < 4; ++c) {
+				m[r][c] = _mm_set1_ps(src.m[r][c]);
+			}
+		}
+	}
+};
+
+template<TransformKind kKind>
+inline void TransformSSE(__m128 x, __m128 y, __m128 z, const MatrixSSE& m, __m128& outX, __m128& outY, __m128& outZ) {
+	__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.m[0][0]), _mm_mul_ps(y, m.m[1][0])), _mm_mul_ps(z, m.m[2][0]));
+	__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.m[0][1]), _mm_mul_ps(y, m.m[1][1])), _mm_mul_ps(z, m.m[2][1]));
+	__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.m[0][2]), _mm_mul_ps(y, m.m[1][2])), _mm_mul_ps(z, m.m[2][2]));
+	if constexpr (kKind != TransformKind::kNormal) {
+		rx = _mm_add_ps(rx, m.m[3][0]);
+		ry = _mm_add_ps(ry, m.m[3][1]);
+		rz = _mm_add_ps(rz, m.m[3][2]);
+	}
+	if constexpr (kKind == TransformKind::kCoord) {
+		const __m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.m[0][3]), _mm_mul_ps(y, m.m[1][3])), _mm_mul_ps(z, m.m[2][3])), m.m[3][3]);
+		rx = _mm_div_ps(rx, w);
+		ry = _mm_div_ps(ry, w);
+		rz = _mm_div_ps(rz, w);
+	}
+	outX = rx;
+	outY = ry;
+	outZ = rz;
+}
+
+template<TransformKind kKind>
+void TransformAoSSSE(const Vector3* src, Vector3* dst, size_t count, const Matrix4x4& m) {
+	const MatrixSSE ms(m);
+	const float* in = reinterpret_cast<const float*>(src);
+	float* out = reinterpret_cast<float*>(dst);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x, y, z;
+		Deinterleave4(in + i * 3, x, y, z);
+		TransformSSE<kKind>(x, y, z, ms, x, y, z);
+		Interleave4(out + i * 3, x, y, z);
+	}
+	TransformAoSScalar<kKind>(src, dst, i, count, m);
+}
+
+template<TransformKind kKind>
+void TransformSoASSE(const ConstVector3SoA& src, const Vector3SoA& dst, const Matrix4x4& m) {
+	const MatrixSSE ms(m);
+	size_t i = 0;
+	for (; i + 4 <= src.size; i += 4) {
+		__m128 x, y, z;
+		TransformSSE<kKind>(_mm_loadu_ps(src.x + i), _mm_loadu_ps(src.y + i), _mm_loadu_ps(src.z + i), ms, x, y, z);
+		_mm_storeu_ps(dst.x + i, x);
+		_mm_storeu_ps(dst.y + i, y);
+		_mm_storeu_ps(dst.z + i, z);
+	}
+	TransformSoAScalar<kKind>(src, dst, i, src.size, m);
+}
+
+#pragma endregion
+
+#pragma region AVX2版
+
+// 行列の各要素を全レーンに展開したもの
+struct MatrixAVX {
+	__m256 m[4][4];
+};
+
+KAMATA_TARGET_AVX2 inline void LoadMatrixAVX(const Matrix4x4& src, MatrixAVX& dst) {
+	for (int r = 0; r < 4; ++r) {
+		for (int c = 0; c < 4; ++c) {
+			dst.m[r][c] = _mm256_set1_ps(src.m[r][c]);
+		}
+	}
+}
+
+KAMATA_TARGET_AVX2 inline __m256 Combine(__m128 lo, __m128 hi) { return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1); }
+
+// FMA は使わず、スカラー版と同じ丸めになるよう乗算と加算を分けて行う
+template<TransformKind kKind>
+KAMATA_TARGET_AVX2 inline void TransformAVX(__m256 x, __m256 y, __m256 z, const MatrixAVX& m, __m256& outX, __m256& outY, __m256& outZ) {
+	__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m.m[0][0]), _mm256_mul_ps(y, m.m[1][0])), _mm256_mul_ps(z, m.m[2][0]));
+	__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m.m[0][1]), _mm256_mul_ps(y, m.m[1][1])), _mm256_mul_ps(z, m.m[2][1]));
+	__m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m.m[0][2]), _mm256_mul_ps(y, m.m[1][2])), _mm256_mul_ps(z, m.m[2][2]));
+	if constexpr (kKind != TransformKind::kNormal) {
+		rx = _mm256_add_ps(rx, m.m[3][0]);
+		ry = _mm256_add_ps(ry, m.m[3][1]);
+		rz = _mm256_add_ps(rz, m.m[3][2]);
+	}
+	if constexpr (kKind == TransformKind::kCoord) {
+		const __m256 w =
+		    _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m.m[0][3]), _mm256_mul_ps(y, m.m[1][3])), _mm256_mul_ps(z, m.m[2][3])), m.m[3][3]);
+		rx = _mm256_div_ps(rx, w);
+		ry = _mm256_div_ps(ry, w);
+		rz = _mm256_div_ps(rz, w);
+	}
+	outX = rx;
+	outY = ry;
+	outZ = rz;
+}
+
+template<TransformKind kKind>
+KAMATA_TARGET_AVX2 void TransformAoSAVX2(const Vector3* src, Vector3* dst, size_t count, const Matrix4x4& m) {
+	MatrixAVX ma;
+	LoadMatrixAVX(m, ma);
+	const float* in = reinterpret_cast<const float*>(src);
+	float* out = reinterpret_cast<float*>(dst);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m128 x0, y0, z0, x1, y1, z1;
+		Deinterleave4(in + i * 3, x0, y0, z0);
+		Deinterleave4(in + i * 3 + 12, x1, y1, z1);
+		__m256 x, y, z;
+		TransformAVX<kKind>(Combine(x0, x1), Combine(y0, y1), Combine(z0, z1), ma, x, y, z);
+		Interleave4(out + i * 3, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+		Interleave4(out + i * 3 + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+	}
+	_mm256_zeroupper();
+	TransformAoSScalar<kKind>(src, dst, i, count, m);
+}
+
+template<TransformKind kKind>
+KAMATA_TARGET_AVX2 void TransformSoAAVX2(const ConstVector3SoA& src, const Vector3SoA& dst, const Matrix4x4& m) {
+	MatrixAVX ma;
+	LoadMatrixAVX(m, ma);
+	size_t i = 0;
+	for (; i + 8 <= src.size; i += 8) {
+		__m256 x, y, z;
+		TransformAVX<kKind>(_mm256_loadu_ps(src.x + i), _mm256_loadu_ps(src.y + i), _mm256_loadu_ps(src.z + i), ma, x, y, z);
+		_mm256_storeu_ps(dst.x + i, x);
+		_mm256_storeu_ps(dst.y + i, y);
+		_mm256_storeu_ps(dst.z + i, z);
+	}
+	_mm256_zeroupper();
+	TransformSoAScalar<kKind>(src, dst, i, src.size, m);
+}
+
+#pragma endregion
+
+#endif // KAMATA_SIMD_X86
+
+template<TransformKind kKind>
+void DispatchAoS(std::span<const Vector3> src, const Matrix4x4& m, std::span<Vector3> dst) {
+	assert(dst.size() >= src.size());
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		TransformAoSAVX2<kKind>(src.data(), dst.data(), src.size(), m);
+		return;
+	case SimdLevel::kSSE:
+		TransformAoSSSE<kKind>(src.data(), dst.data(), src.size(), m);
+		return;
+#endif
+	default:
+		TransformAoSScalar<kKind>(src.data(), dst.data(), 0, src.size(), m);
+		return;
+	}
+}
+
+template<TransformKind kKind>
+void DispatchSoA(const ConstVector3SoA& src, const Matrix4x4& m, const Vector3SoA& dst) {
+	assert(dst.size >= src.size);
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		TransformSoAAVX2<kKind>(src, dst, m);
+		return;
+	case SimdLevel::kSSE:
+		TransformSoASSE<kKind>(src, dst, m);
+		return;
+#endif
+	default:
+		TransformSoAScalar<kKind>(src, dst, 0, src.size, m);
+		return;
+	}
+}
+
+} // namespace
+
+void Transform(std::span<const Vector3> src, const Matrix4x4& m, std::span<Vector3> dst) { DispatchAoS<TransformKind::kPoint>(src, m, dst); }
+
+void TransformCoord(std::span<const Vector3> src, const Matrix4x4& m, std::span<Vector3> dst) { DispatchAoS<TransformKind::kCoord>(src, m, dst); }
+
+void TransformNormal(std::span<const Vector3> src, const Matrix4x4& m, std::span<Vector3> dst) { DispatchAoS<TransformKind::kNormal>(src, m, dst); }
+
+void Transform(const ConstVector3SoA& src, const Matrix4x4& m, const Vector3SoA& dst) { DispatchSoA<TransformKind::kPoint>(src, m, dst); }
+
+void TransformCoord(const ConstVector3SoA& src, const Matrix4x4& m, const Vector3SoA& dst) { DispatchSoA<TransformKind::kCoord>(src, m, dst); }
+
+void TransformNormal(const ConstVector3SoA& src, const Matrix4x4& m, const Vector3SoA& dst) { DispatchSoA<TransformKind::kNormal>(src, m, dst); }
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
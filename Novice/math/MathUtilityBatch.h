@@ -0,0 +1,55 @@
+#pragma once
+
+#include "math/Matrix4x4.h"
+#include "math/Vector3.h"
+#include <cstddef>
+#include <span>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+// 複数の座標をまとめて変換する。
+// SetSimdLevel で選択された SSE / AVX2 カーネルで処理し、
+// どのレベルでも Transform / TransformCoord / TransformNormal と同じ演算順序で計算するため結果は一致する。
+// dst の要素数は src 以上であること。src と dst は完全に同じ配列（インプレース）か、重ならない配列であること。
+
+// 座標変換（w除算なし）
+void Transform(std::span<const Vector3> src, const Matrix4x4& m, std::span<Vector3> dst);
+// 座標変換（w除算あり）
+void TransformCoord(std::span<const Vector3> src, const Matrix4x4& m, std::span<Vector3> dst);
+// ベクトル変換
+void TransformNormal(std::span<const Vector3> src, const Matrix4x4& m, std::span<Vector3> dst);
+
+/// <summary>
+/// SoA 形式の座標配列（読み取り専用）
+/// </summary>
+struct ConstVector3SoA {
+	const float* x;
+	const float* y;
+	const float* z;
+	size_t size;
+};
+
+/// <summary>
+/// SoA 形式の座標配列
+/// </summary>
+struct Vector3SoA {
+	float* x;
+	float* y;
+	float* z;
+	size_t size;
+
+	operator ConstVector3SoA() const { return {x, y, z, size}; }
+};
+
+// 座標変換（w除算なし・SoA版）
+void Transform(const ConstVector3SoA& src, const Matrix4x4& m, const Vector3SoA& dst);
+// 座標変換（w除算あり・SoA版）
+void TransformCoord(const ConstVector3SoA& src, const Matrix4x4& m, const Vector3SoA& dst);
+// ベクトル変換（SoA版）
+void TransformNormal(const ConstVector3SoA& src, const Matrix4x4& m, const Vector3SoA& dst);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
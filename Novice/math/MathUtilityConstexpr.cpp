@@ -0,0 +1,77 @@
+#include "math/MathUtilityConstexpr.h"
+
+// コンパイル時テスト。
+// 入力は全て誤差なく表現できる値なので、期待値は MathUtility の実行時版が返す値と一致する。
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+namespace Constexpr {
+
+namespace {
+
+constexpr Vector3 kA = {1.0f, 2.0f, 3.0f};
+constexpr Vector3 kB = {4.0f, -5.0f, 6.0f};
+
+// ベクトル演算
+static_assert(Equal(+kA, kA));
+static_assert(Equal(-kA, {-1.0f, -2.0f, -3.0f}));
+static_assert(Equal(kA + kB, {5.0f, -3.0f, 9.0f}));
+static_assert(Equal(kA - kB, {-3.0f, 7.0f, -3.0f}));
+static_assert(Equal(kA * 2.0f, {2.0f, 4.0f, 6.0f}));
+static_assert(Equal(2.0f * kA, kA * 2.0f));
+static_assert(Equal(kB / 2.0f, {2.0f, -2.5f, 3.0f}));
+static_assert(Equal(Vector3Zero(), {0.0f, 0.0f, 0.0f}));
+static_assert([] {
+	Vector3 v = kA;
+	v += kB;
+	v -= kA;
+	v *= 4.0f;
+	v /= 2.0f;
+	return Equal(v, kB * 2.0f);
+}());
+
+// 内積・外積
+static_assert(Dot(kA, kB) == 12.0f);
+static_assert(Equal(Cross(kA, kB), {27.0f, 6.0f, -13.0f}));
+static_assert(Equal(Cross({1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}), {0.0f, 0.0f, 1.0f}));
+static_assert(Dot(Cross(kA, kB), kA) == 0.0f);
+
+// 線形補間
+static_assert(Lerp(2.0f, 6.0f, 0.0f) == 2.0f);
+static_assert(Lerp(2.0f, 6.0f, 0.25f) == 3.0f);
+static_assert(Lerp(2.0f, 6.0f, 1.0f) == 6.0f);
+static_assert(Equal(Lerp(kA, kB, 0.5f), {2.5f, -1.5f, 4.5f}));
+
+// 行列の生成
+constexpr Matrix4x4 kIdentity = MakeIdentityMatrix();
+constexpr Matrix4x4 kScale = MakeScaleMatrix({2.0f, 3.0f, 4.0f});
+constexpr Matrix4x4 kTranslate = MakeTranslateMatrix(Vector3{10.0f, 20.0f, 30.0f});
+
+static_assert(kIdentity.m[0][0] == 1.0f && kIdentity.m[1][1] == 1.0f && kIdentity.m[2][2] == 1.0f && kIdentity.m[3][3] == 1.0f);
+static_assert(kIdentity.m[0][1] == 0.0f && kIdentity.m[3][0] == 0.0f);
+static_assert(Equal(Transpose(kIdentity), kIdentity));
+static_assert(Equal(Transpose(Transpose(kTranslate)), kTranslate));
+static_assert(Transpose(kTranslate).m[0][3] == 10.0f);
+static_assert(Equal(MakeTranslateMatrix(Vector2{1.0f, 2.0f}), MakeTranslateMatrix(Vector3{1.0f, 2.0f, 0.0f})));
+
+// 行列の積と座標変換（行ベクトル × 行列）
+static_assert(Equal(kScale * kIdentity, kScale));
+static_assert(Equal(kIdentity * kTranslate, kTranslate));
+static_assert(Equal(Transform(kA, kScale * kTranslate), {12.0f, 26.0f, 42.0f}));
+static_assert(Equal(Transform(kA, kTranslate * kScale), {22.0f, 66.0f, 132.0f}));
+static_assert(Equal(TransformNormal(kA, kScale * kTranslate), {2.0f, 6.0f, 12.0f}));
+static_assert([] {
+	Matrix4x4 m = kScale;
+	m *= kTranslate;
+	return Equal(m, kScale * kTranslate);
+}());
+
+} // namespace
+
+} // namespace Constexpr
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "math/Matrix4x4.h"
+#include "math/Vector2.h"
+#include "math/Vector3.h"
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+// MathUtility の関数のうち、定数式で評価できるもののヘッダ定義版。
+// 引数が定数なら静的な変換行列やテーブルをコンパイル時に作れ、ループ内ではインライン展開される。
+// MathUtility と同名の演算子を含むため、両方の名前空間を同時に using しないこと。
+namespace Constexpr {
+
+// 単項演算子オーバーロード
+constexpr Vector3 operator+(const Vector3& v) { return v; }
+constexpr Vector3 operator-(const Vector3& v) { return {-v.x, -v.y, -v.z}; }
+
+// 代入演算子オーバーロード
+constexpr Vector3& operator+=(Vector3& lhv, const Vector3& rhv) {
+	lhv.x += rhv.x;
+	lhv.y += rhv.y;
+	lhv.z += rhv.z;
+	return lhv;
+}
+constexpr Vector3& operator-=(Vector3& lhv, const Vector3& rhv) {
+	lhv.x -= rhv.x;
+	lhv.y -= rhv.y;
+	lhv.z -= rhv.z;
+	return lhv;
+}
+constexpr Vector3& operator*=(Vector3& v, float s) {
+	v.x *= s;
+	v.y *= s;
+	v.z *= s;
+	return v;
+}
+constexpr Vector3& operator/=(Vector3& v, float s) {
+	v.x /= s;
+	v.y /= s;
+	v.z /= s;
+	return v;
+}
+
+// 2項演算子オーバーロード
+constexpr const Vector3 operator+(const Vector3& v1, const Vector3& v2) { return {v1.x + v2.x, v1.y + v2.y, v1.z + v2.z}; }
+constexpr const Vector3 operator-(const Vector3& v1, const Vector3& v2) { return {v1.x - v2.x, v1.y - v2.y, v1.z - v2.z}; }
+constexpr const Vector3 operator*(const Vector3& v, float s) { return {v.x * s, v.y * s, v.z * s}; }
+constexpr const Vector3 operator*(float s, const Vector3& v) { return {s * v.x, s * v.y, s * v.z}; }
+constexpr const Vector3 operator/(const Vector3& v, float s) { return {v.x / s, v.y / s, v.z / s}; }
+
+// 零ベクトルを返す
+constexpr const Vector3 Vector3Zero() { return {0.0f, 0.0f, 0.0f}; }
+
+// 2ベクトルが一致しているか調べる
+constexpr bool Equal(const Vector3& v1, const Vector3& v2) { return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z; }
+// 内積を求める
+constexpr float Dot(const Vector3& v1, const Vector3& v2) { return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
+// 外積を求める
+constexpr Vector3 Cross(const Vector3& v1, const Vector3& v2) { return {v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x}; }
+
+// 2行列が一致しているか調べる
+constexpr bool Equal(const Matrix4x4& m1, const Matrix4x4& m2) {
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			if (m1.m[i][j] != m2.m[i][j]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// 単位行列を求める
+constexpr Matrix4x4 MakeIdentityMatrix() {
+	return {{
+	    {1.0f, 0.0f, 0.0f, 0.0f},
+	    {0.0f, 1.0f, 0.0f, 0.0f},
+	    {0.0f, 0.0f, 1.0f, 0.0f},
+	    {0.0f, 0.0f, 0.0f, 1.0f},
+	}};
+}
+// 転置行列を求める
+constexpr Matrix4x4 Transpose(const Matrix4x4& m) {
+	Matrix4x4 result{};
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m.m[j][i];
+		}
+	}
+	return result;
+}
+
+// 拡大縮小行列の作成
+constexpr Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
+	return {{
+	    {scale.x, 0.0f, 0.0f, 0.0f},
+	    {0.0f, scale.y, 0.0f, 0.0f},
+	    {0.0f, 0.0f, scale.z, 0.0f},
+	    {0.0f, 0.0f, 0.0f, 1.0f},
+	}};
+}
+
+// 平行移動行列の作成
+constexpr Matrix4x4 MakeTranslateMatrix(const Vector2& translate) {
+	return {{
+	    {1.0f, 0.0f, 0.0f, 0.0f},
+	    {0.0f, 1.0f, 0.0f, 0.0f},
+	    {0.0f, 0.0f, 1.0f, 0.0f},
+	    {translate.x, translate.y, 0.0f, 1.0f},
+	}};
+}
+constexpr Matrix4x4 MakeTranslateMatrix(const Vector3& translate) {
+	return {{
+	    {1.0f, 0.0f, 0.0f, 0.0f},
+	    {0.0f, 1.0f, 0.0f, 0.0f},
+	    {0.0f, 0.0f, 1.0f, 0.0f},
+	    {translate.x, translate.y, translate.z, 1.0f},
+	}};
+}
+
+// 2項演算子オーバーロード
+constexpr Matrix4x4 operator*(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result{};
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] + m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
+		}
+	}
+	return result;
+}
+
+// 代入演算子オーバーロード
+constexpr Matrix4x4& operator*=(Matrix4x4& lhm, const Matrix4x4& rhm) {
+	lhm = lhm * rhm;
+	return lhm;
+}
+
+// 座標変換（w除算なし）
+constexpr Vector3 Transform(const Vector3& v, const Matrix4x4& m) {
+	return {
+	    v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + m.m[3][0],
+	    v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + m.m[3][1],
+	    v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + m.m[3][2],
+	};
+}
+// ベクトル変換
+constexpr Vector3 TransformNormal(const Vector3& v, const Matrix4x4& m) {
+	return {
+	    v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0],
+	    v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1],
+	    v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2],
+	};
+}
+
+// 線形補間
+constexpr float Lerp(float a, float b, float t) { return a + (b - a) * t; }
+constexpr Vector3 Lerp(const Vector3& a, const Vector3& b, float t) { return {Lerp(a.x, b.x, t), Lerp(a.y, b.y, t), Lerp(a.z, b.z, t)}; }
+
+} // namespace Constexpr
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
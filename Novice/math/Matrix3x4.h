@@ -0,0 +1,13 @@
+#pragma once
+
+namespace KamataEngine {
+
+/// <summary>
+/// 3x4行列（アフィン変換用）
+/// 4x4行列の左3列を転置して格納する。m[i] は変換後の i 成分を求める (x, y, z, 1) との係数。
+/// </summary>
+struct Matrix3x4 final {
+	float m[3][4];
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,315 @@
+#include "math/Matrix4x4A.h"
+#include "math/SimdSupport.h"
+#include <cassert>
+#include <cstring>
+
+namespace KamataEngine {
+
+Matrix4x4A::Matrix4x4A(const Matrix4x4& src) { std::memcpy(m, src.m, sizeof(m)); }
+
+Matrix4x4A::operator Matrix4x4() const {
+	Matrix4x4 result;
+	std::memcpy(result.m, m, sizeof(m));
+	return result;
+}
+
+namespace MathUtility {
+
+namespace {
+
+#pragma region スカラー版
+
+void MultiplyScalar(const Matrix4x4A& m1, const Matrix4x4A& m2, Matrix4x4A& result) {
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] + m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
+		}
+	}
+}
+
+Matrix4x4A TransposeScalar(const Matrix4x4A& m) {
+	Matrix4x4A result;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m.m[j][i];
+		}
+	}
+	return result;
+}
+
+// 2x2 の小行列式を使った余因子展開
+Matrix4x4A InverseScalar(const Matrix4x4A& m, float* det) {
+	const float s0 = m.m[0][0] * m.m[1][1] - m.m[1][0] * m.m[0][1];
+	const float s1 = m.m[0][0] * m.m[1][2] - m.m[1][0] * m.m[0][2];
+	const float s2 = m.m[0][0] * m.m[1][3] - m.m[1][0] * m.m[0][3];
+	const float s3 = m.m[0][1] * m.m[1][2] - m.m[1][1] * m.m[0][2];
+	const float s4 = m.m[0][1] * m.m[1][3] - m.m[1][1] * m.m[0][3];
+	const float s5 = m.m[0][2] * m.m[1][3] - m.m[1][2] * m.m[0][3];
+
+	const float c5 = m.m[2][2] * m.m[3][3] - m.m[3][2] * m.m[2][3];
+	const float c4 = m.m[2][1] * m.m[3][3] - m.m[3][1] * m.m[2][3];
+	const float c3 = m.m[2][1] * m.m[3][2] - m.m[3][1] * m.m[2][2];
+	const float c2 = m.m[2][0] * m.m[3][3] - m.m[3][0] * m.m[2][3];
+	const float c1 = m.m[2][0] * m.m[3][2] - m.m[3][0] * m.m[2][2];
+	const float c0 = m.m[2][0] * m.m[3][1] - m.m[3][0] * m.m[2][1];
+
+	const float determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	if (det) {
+		*det = determinant;
+	}
+	const float invDet = 1.0f / determinant;
+
+	Matrix4x4A result;
+	result.m[0][0] = (m.m[1][1] * c5 - m.m[1][2] * c4 + m.m[1][3] * c3) * invDet;
+	result.m[0][1] = (-m.m[0][1] * c5 + m.m[0][2] * c4 - m.m[0][3] * c3) * invDet;
+	result.m[0][2] = (m.m[3][1] * s5 - m.m[3][2] * s4 + m.m[3][3] * s3) * invDet;
+	result.m[0][3] = (-m.m[2][1] * s5 + m.m[2][2] * s4 - m.m[2][3] * s3) * invDet;
+
+	result.m[1][0] = (-m.m[1][0] * c5 + m.m[1][2] * c2 - m.m[1][3] * c1) * invDet;
+	result.m[1][1] = (m.m[0][0] * c5 - m.m[0][2] * c2 + m.m[0][3] * c1) * invDet;
+	result.m[1][2] = (-m.m[3][0] * s5 + m.m[3][2] * s2 - m.m[3][3] * s1) * invDet;
+	result.m[1][3] = (m.m[2][0] * s5 - m.m[2][2] * s2 + m.m[2][3] * s1) * invDet;
+
+	result.m[2][0] = (m.m[1][0] * c4 - m.m[1][1] * c2 + m.m[1][3] * c0) * invDet;
+	result.m[2][1] = (-m.m[0][0] * c4 + m.m[0][1] * c2 - m.m[0][3] * c0) * invDet;
+	result.m[2][2] = (m.m[3][0] * s4 - m.m[3][1] * s2 + m.m[3][3] * s0) * invDet;
+	result.m[2][3] = (-m.m[2][0] * s4 + m.m[2][1] * s2 - m.m[2][3] * s0) * invDet;
+
+	result.m[3][0] = (-m.m[1][0] * c3 + m.m[1][1] * c1 - m.m[1][2] * c0) * invDet;
+	result.m[3][1] = (m.m[0][0] * c3 - m.m[0][1] * c1 + m.m[0][2] * c0) * invDet;
+	result.m[3][2] = (-m.m[3][0] * s3 + m.m[3][1] * s1 - m.m[3][2] * s0) * invDet;
+	result.m[3][3] = (m.m[2][0] * s3 - m.m[2][1] * s1 + m.m[2][2] * s0) * invDet;
+	return result;
+}
+
+#pragma endregion
+
+#if KAMATA_SIMD_X86
+
+#pragma region SSE版
+
+#define KAMATA_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(w, z, y, x))
+#define KAMATA_SHUFFLE(v1, v2, x, y, z, w) _mm_shuffle_ps((v1), (v2), _MM_SHUFFLE(w, z, y, x))
+
+// 1行分: row * m
+inline __m128 MultiplyRowSSE(__m128 row, const __m128 (&m)[4]) {
+	__m128 result = _mm_mul_ps(KAMATA_SWIZZLE(row, 0, 0, 0, 0), m[0]);
+	result = _mm_add_ps(result, _mm_mul_ps(KAMATA_SWIZZLE(row, 1, 1, 1, 1), m[1]));
+	result = _mm_add_ps(result, _mm_mul_ps(KAMATA_SWIZZLE(row, 2, 2, 2, 2), m[2]));
+	result = _mm_add_ps(result, _mm_mul_ps(KAMATA_SWIZZLE(row, 3, 3, 3, 3), m[3]));
+	return result;
+}
+
+void MultiplySSE(const Matrix4x4A& m1, const Matrix4x4A& m2, Matrix4x4A& result) {
+	const __m128 rhs[4] = {_mm_load_ps(m2.m[0]), _mm_load_ps(m2.m[1]), _mm_load_ps(m2.m[2]), _mm_load_ps(m2.m[3])};
+	const __m128 r0 = MultiplyRowSSE(_mm_load_ps(m1.m[0]), rhs);
+	const __m128 r1 = MultiplyRowSSE(_mm_load_ps(m1.m[1]), rhs);
+	const __m128 r2 = MultiplyRowSSE(_mm_load_ps(m1.m[2]), rhs);
+	const __m128 r3 = MultiplyRowSSE(_mm_load_ps(m1.m[3]), rhs);
+	// result が m1, m2 と同じでも良いよう、全て計算してから書き込む
+	_mm_store_ps(result.m[0], r0);
+	_mm_store_ps(result.m[1], r1);
+	_mm_store_ps(result.m[2], r2);
+	_mm_store_ps(result.m[3], r3);
+}
+
+Matrix4x4A TransposeSSE(const Matrix4x4A& m) {
+	__m128 r0 = _mm_load_ps(m.m[0]);
+	__m128 r1 = _mm_load_ps(m.m[1]);
+	__m128 r2 = _mm_load_ps(m.m[2]);
+	__m128 r3 = _mm_load_ps(m.m[3]);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	Matrix4x4A result;
+	_mm_store_ps(result.m[0], r0);
+	_mm_store_ps(result.m[1], r1);
+	_mm_store_ps(result.m[2], r2);
+	_mm_store_ps(result.m[3], r3);
+	return result;
+}
+
+// 2x2 行列（xyzw = 00,01,10,11）の積 A * B
+inline __m128 Mat2Mul(__m128 a, __m128 b) {
+	return _mm_add_ps(_mm_mul_ps(a, KAMATA_SWIZZLE(b, 0, 3, 0, 3)), _mm_mul_ps(KAMATA_SWIZZLE(a, 1, 0, 3, 2), KAMATA_SWIZZLE(b, 2, 1, 2, 1)));
+}
+// 2x2 行列の余因子行列との積 adj(A) * B
+inline __m128 Mat2AdjMul(__m128 a, __m128 b) {
+	return _mm_sub_ps(_mm_mul_ps(KAMATA_SWIZZLE(a, 3, 3, 0, 0), b), _mm_mul_ps(KAMATA_SWIZZLE(a, 1, 1, 2, 2), KAMATA_SWIZZLE(b, 2, 3, 0, 1)));
+}
+// 2x2 行列と余因子行列の積 A * adj(B)
+inline __m128 Mat2MulAdj(__m128 a, __m128 b) {
+	return _mm_sub_ps(_mm_mul_ps(a, KAMATA_SWIZZLE(b, 3, 0, 3, 0)), _mm_mul_ps(KAMATA_SWIZZLE(a, 1, 0, 3, 2), KAMATA_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+// 2x2 ブロックに分割して余因子行列を求める
+Matrix4x4A InverseSSE(const Matrix4x4A& m, float* det) {
+	const __m128 r0 = _mm_load_ps(m.m[0]);
+	const __m128 r1 = _mm_load_ps(m.m[1]);
+	const __m128 r2 = _mm_load_ps(m.m[2]);
+	const __m128 r3 = _mm_load_ps(m.m[3]);
+
+	// M = | A B |
+	//     | C D |
+	const __m128 a = _mm_movelh_ps(r0, r1);
+	const __m128 b = _mm_movehl_ps(r1, r0);
+	const __m128 c = _mm_movelh_ps(r2, r3);
+	const __m128 d = _mm_movehl_ps(r3, r2);
+
+	// (|A|, |B|, |C|, |D|)
+	const __m128 detSub = _mm_sub_ps(
+	    _mm_mul_ps(KAMATA_SHUFFLE(r0, r2, 0, 2, 0, 2), KAMATA_SHUFFLE(r1, r3, 1, 3, 1, 3)), _mm_mul_ps(KAMATA_SHUFFLE(r0, r2, 1, 3, 1, 3), KAMATA_SHUFFLE(r1, r3, 0, 2, 0, 2)));
+	const __m128 detA = KAMATA_SWIZZLE(detSub, 0, 0, 0, 0);
+	const __m128 detB = KAMATA_SWIZZLE(detSub, 1, 1, 1, 1);
+	const __m128 detC = KAMATA_SWIZZLE(detSub, 2, 2, 2, 2);
+	const __m128 detD = KAMATA_SWIZZLE(detSub, 3, 3, 3, 3);
+
+	const __m128 dc = Mat2AdjMul(d, c);
+	const __m128 ab = Mat2AdjMul(a, b);
+	__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Mul(b, dc));
+	__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Mul(c, ab));
+	__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MulAdj(d, ab));
+	__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MulAdj(a, dc));
+
+	// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+	__m128 tr = _mm_mul_ps(ab, KAMATA_SWIZZLE(dc, 0, 2, 1, 3));
+	tr = _mm_add_ps(tr, KAMATA_SWIZZLE(tr, 2, 3, 0, 1));
+	tr = _mm_add_ps(tr, KAMATA_SWIZZLE(tr, 1, 0, 3, 2));
+	const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+	if (det) {
+		*det = _mm_cvtss_f32(detM);
+	}
+
+	const __m128 rcpDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+	x = _mm_mul_ps(x, rcpDetM);
+	y = _mm_mul_ps(y, rcpDetM);
+	z = _mm_mul_ps(z, rcpDetM);
+	w = _mm_mul_ps(w, rcpDetM);
+
+	Matrix4x4A result;
+	_mm_store_ps(result.m[0], KAMATA_SHUFFLE(x, y, 3, 1, 3, 1));
+	_mm_store_ps(result.m[1], KAMATA_SHUFFLE(x, y, 2, 0, 2, 0));
+	_mm_store_ps(result.m[2], KAMATA_SHUFFLE(z, w, 3, 1, 3, 1));
+	_mm_store_ps(result.m[3], KAMATA_SHUFFLE(z, w, 2, 0, 2, 0));
+	return result;
+}
+
+#undef KAMATA_SWIZZLE
+#undef KAMATA_SHUFFLE
+
+#pragma endregion
+
+#pragma region AVX2版
+
+// 2行ずつ 256bit レジスタで計算する
+KAMATA_TARGET_AVX2 inline void MultiplyAVX(const Matrix4x4A& m1, const __m256 (&rhs)[4], Matrix4x4A& result) {
+	const __m256 lhs01 = _mm256_loadu_ps(m1.m[0]);
+	const __m256 lhs23 = _mm256_loadu_ps(m1.m[2]);
+
+	__m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(lhs01, lhs01, 0x00), rhs[0]);
+	__m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(lhs23, lhs23, 0x00), rhs[0]);
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(lhs01, lhs01, 0x55), rhs[1]));
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(lhs23, lhs23, 0x55), rhs[1]));
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(lhs01, lhs01, 0xAA), rhs[2]));
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(lhs23, lhs23, 0xAA), rhs[2]));
+	r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(lhs01, lhs01, 0xFF), rhs[3]));
+	r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(lhs23, lhs23, 0xFF), rhs[3]));
+
+	_mm256_storeu_ps(result.m[0], r01);
+	_mm256_storeu_ps(result.m[2], r23);
+}
+
+// 右辺の各行を上下 128bit に複製して読み込む
+KAMATA_TARGET_AVX2 inline void LoadRhsAVX(const Matrix4x4A& m, __m256 (&rhs)[4]) {
+	for (int i = 0; i < 4; ++i) {
+		rhs[i] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.m[i]));
+	}
+}
+
+KAMATA_TARGET_AVX2 void MultiplyAVX2(const Matrix4x4A& m1, const Matrix4x4A& m2, Matrix4x4A& result) {
+	__m256 rhs[4];
+	LoadRhsAVX(m2, rhs);
+	MultiplyAVX(m1, rhs, result);
+	_mm256_zeroupper();
+}
+
+KAMATA_TARGET_AVX2 void MultiplyBatchAVX2(const Matrix4x4A* src, const Matrix4x4A& m, Matrix4x4A* dst, size_t count) {
+	__m256 rhs[4];
+	LoadRhsAVX(m, rhs);
+	for (size_t i = 0; i < count; ++i) {
+		MultiplyAVX(src[i], rhs, dst[i]);
+	}
+	_mm256_zeroupper();
+}
+
+#pragma endregion
+
+#endif // KAMATA_SIMD_X86
+
+} // namespace
+
+Matrix4x4A operator*(const Matrix4x4A& m1, const Matrix4x4A& m2) {
+	Matrix4x4A result;
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		MultiplyAVX2(m1, m2, result);
+		break;
+	case SimdLevel::kSSE:
+		MultiplySSE(m1, m2, result);
+		break;
+#endif
+	default:
+		MultiplyScalar(m1, m2, result);
+		break;
+	}
+	return result;
+}
+
+Matrix4x4A& operator*=(Matrix4x4A& lhm, const Matrix4x4A& rhm) {
+	lhm = lhm * rhm;
+	return lhm;
+}
+
+Matrix4x4A Transpose(const Matrix4x4A& m) {
+#if KAMATA_SIMD_X86
+	if (GetSimdLevel() != SimdLevel::kScalar) {
+		return TransposeSSE(m);
+	}
+#endif
+	return TransposeScalar(m);
+}
+
+Matrix4x4A Inverse(const Matrix4x4A& m, float* det) {
+#if KAMATA_SIMD_X86
+	if (GetSimdLevel() != SimdLevel::kScalar) {
+		return InverseSSE(m, det);
+	}
+#endif
+	return InverseScalar(m, det);
+}
+
+void Multiply(std::span<const Matrix4x4A> src, const Matrix4x4A& m, std::span<Matrix4x4A> dst) {
+	assert(dst.size() >= src.size());
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		MultiplyBatchAVX2(src.data(), m, dst.data(), src.size());
+		break;
+	case SimdLevel::kSSE:
+		for (size_t i = 0; i < src.size(); ++i) {
+			MultiplySSE(src[i], m, dst[i]);
+		}
+		break;
+#endif
+	default:
+		for (size_t i = 0; i < src.size(); ++i) {
+			Matrix4x4A result;
+			MultiplyScalar(src[i], m, result);
+			dst[i] = result;
+		}
+		break;
+	}
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
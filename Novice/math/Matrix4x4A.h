@@ -0,0 +1,45 @@
+#pragma once
+
+#include "math/Matrix4x4.h"
+#include <cstddef>
+#include <span>
+
+namespace KamataEngine {
+
+/// <summary>
+/// 4x4行列（16バイト境界にアラインされた SIMD 演算用）
+/// </summary>
+struct alignas(16) Matrix4x4A final {
+	float m[4][4];
+
+	Matrix4x4A() = default;
+	explicit Matrix4x4A(const Matrix4x4& src);
+
+	/// <summary>
+	/// Matrix4x4 への変換
+	/// </summary>
+	explicit operator Matrix4x4() const;
+};
+
+static_assert(sizeof(Matrix4x4A) == sizeof(Matrix4x4));
+
+namespace MathUtility {
+
+// 2項演算子オーバーロード
+Matrix4x4A operator*(const Matrix4x4A& m1, const Matrix4x4A& m2);
+
+// 代入演算子オーバーロード
+Matrix4x4A& operator*=(Matrix4x4A& lhm, const Matrix4x4A& rhm);
+
+// 転置行列を求める
+Matrix4x4A Transpose(const Matrix4x4A& m);
+// 逆行列を求める（det が 0 の場合の結果は不定なので、必要なら det を受け取って確認すること）
+Matrix4x4A Inverse(const Matrix4x4A& m, float* det = nullptr);
+
+// 複数の行列に同じ行列を右から掛ける（dst[i] = src[i] * m）
+// dst の要素数は src 以上であること。src と dst は同じ配列でもよい。
+void Multiply(std::span<const Matrix4x4A> src, const Matrix4x4A& m, std::span<Matrix4x4A> dst);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,65 @@
+#include "math/Projection.h"
+#include "math/MathUtility.h"
+#include "math/MathUtilityConstexpr.h"
+#include <cmath>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+namespace {
+
+// 行ベクトルの透視投影行列（深度は z * depthScale + depthOffset を w = z で割ったもの）
+Matrix4x4 MakePerspective(float fovY, float aspectRatio, float depthScale, float depthOffset) {
+	const float scaleY = 1.0f / std::tan(fovY * 0.5f);
+	return {{
+	    {scaleY / aspectRatio, 0.0f, 0.0f, 0.0f},
+	    {0.0f, scaleY, 0.0f, 0.0f},
+	    {0.0f, 0.0f, depthScale, 1.0f},
+	    {0.0f, 0.0f, depthOffset, 0.0f},
+	}};
+}
+
+} // namespace
+
+Matrix4x4 MakePerspectiveFovMatrixReverseZ(float fovY, float aspectRatio, float nearClip, float farClip) {
+	// z = near で 1、z = far で 0
+	return MakePerspective(fovY, aspectRatio, nearClip / (nearClip - farClip), farClip * nearClip / (farClip - nearClip));
+}
+
+Matrix4x4 MakePerspectiveFovMatrixInfinite(float fovY, float aspectRatio, float nearClip) {
+	// 標準の行列の far → ∞ の極限（深度は 1 - near / z）
+	return MakePerspective(fovY, aspectRatio, 1.0f, -nearClip);
+}
+
+Matrix4x4 MakePerspectiveFovMatrixInfiniteReverseZ(float fovY, float aspectRatio, float nearClip) {
+	// 深度は near / z
+	return MakePerspective(fovY, aspectRatio, 0.0f, nearClip);
+}
+
+Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip, DepthMode depthMode) {
+	switch (depthMode) {
+	case DepthMode::kReverseZ:
+		return MakePerspectiveFovMatrixReverseZ(fovY, aspectRatio, nearClip, farClip);
+	case DepthMode::kInfinite:
+		return MakePerspectiveFovMatrixInfinite(fovY, aspectRatio, nearClip);
+	case DepthMode::kInfiniteReverseZ:
+		return MakePerspectiveFovMatrixInfiniteReverseZ(fovY, aspectRatio, nearClip);
+	default:
+		return MakePerspectiveFovMatrix(fovY, aspectRatio, nearClip, farClip);
+	}
+}
+
+Ray UnprojectRay(float x, float y, const Matrix4x4& inverseViewProjection, DepthMode depthMode) {
+	const float nearDepth = GetNearDepth(depthMode);
+	const float middleDepth = (nearDepth + GetFarDepth(depthMode)) * 0.5f;
+	const Vector3 nearPoint = TransformCoord({x, y, nearDepth}, inverseViewProjection);
+	const Vector3 middlePoint = TransformCoord({x, y, middleDepth}, inverseViewProjection);
+
+	Vector3 direction = Constexpr::operator-(middlePoint, nearPoint);
+	return {nearPoint, Normalize(direction)};
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "math/Matrix4x4.h"
+#include "math/Ray.h"
+
+namespace KamataEngine {
+
+/// <summary>
+/// 透視投影の深度の割り当て
+/// 逆Z（ニア 1、ファー 0）は浮動小数点の深度バッファで遠くの精度が落ちにくく、遠距離の Z ファイティングを防げる。
+/// 逆Z のときは深度バッファを GetFarDepth の値（0）でクリアし、深度比較を D3D12_COMPARISON_FUNC_GREATER_EQUAL にすること。
+/// </summary>
+enum class DepthMode {
+	kStandard,         // ニア 0、ファー 1（MakePerspectiveFovMatrix と同じ）
+	kReverseZ,         // ニア 1、ファー 0
+	kInfinite,         // ニア 0、無限遠 1（farZ を使わない）
+	kInfiniteReverseZ, // ニア 1、無限遠 0（farZ を使わない）
+};
+
+namespace MathUtility {
+
+// 逆Z の透視投影行列
+Matrix4x4 MakePerspectiveFovMatrixReverseZ(float fovY, float aspectRatio, float nearClip, float farClip);
+// ファークリップ面が無限遠の透視投影行列
+Matrix4x4 MakePerspectiveFovMatrixInfinite(float fovY, float aspectRatio, float nearClip);
+// ファークリップ面が無限遠の逆Z の透視投影行列
+Matrix4x4 MakePerspectiveFovMatrixInfiniteReverseZ(float fovY, float aspectRatio, float nearClip);
+// 深度の割り当てを選んで透視投影行列を作成（無限遠の割り当てでは farClip を使わない）
+Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip, DepthMode depthMode);
+
+// ニアクリップ面・ファークリップ面（無限遠）の正規化デバイス座標の深度
+constexpr bool IsReverseZ(DepthMode depthMode) { return depthMode == DepthMode::kReverseZ || depthMode == DepthMode::kInfiniteReverseZ; }
+constexpr bool IsInfiniteFar(DepthMode depthMode) { return depthMode == DepthMode::kInfinite || depthMode == DepthMode::kInfiniteReverseZ; }
+constexpr float GetNearDepth(DepthMode depthMode) { return IsReverseZ(depthMode) ? 1.0f : 0.0f; }
+constexpr float GetFarDepth(DepthMode depthMode) { return IsReverseZ(depthMode) ? 0.0f : 1.0f; }
+
+// 正規化デバイス座標 (x, y) を通るワールド座標系の半直線をビュー射影行列の逆行列から作成
+// 始点はニアクリップ面上の点、方向は正規化済み。
+// 無限遠の割り当てではファーの深度の点を戻せない（w が 0 になる）ので、ニアとファーの中間の深度の点を使って方向を求める。
+Ray UnprojectRay(float x, float y, const Matrix4x4& inverseViewProjection, DepthMode depthMode);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,110 @@
+#include "math/Quantization.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+namespace {
+
+// 符号を保った値（0 は正とみなす）
+inline float SignNotZero(float value) { return value >= 0.0f ? 1.0f : -1.0f; }
+
+} // namespace
+
+uint16_t FloatToHalf(float value) {
+	const uint32_t bits = std::bit_cast<uint32_t>(value);
+	const uint32_t sign = (bits >> 16) & 0x8000u;
+	const uint32_t absBits = bits & 0x7FFFFFFFu;
+
+	// NaN / 無限大
+	if (absBits >= 0x7F800000u) {
+		return static_cast<uint16_t>(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x0200u : 0u));
+	}
+	// 半精度の最大値 65504 を丸めで超えるもの
+	if (absBits >= 0x477FF000u) {
+		return static_cast<uint16_t>(sign | 0x7C00u);
+	}
+	// 非正規化数になるもの（2^-14 未満）
+	if (absBits < 0x38800000u) {
+		// 2^-24 単位の整数に丸める（0.5f を足すと仮数部の下位が最近接偶数丸めで切り捨てられる）
+		const float scaled = std::bit_cast<float>(absBits) + 0.5f;
+		return static_cast<uint16_t>(sign | (std::bit_cast<uint32_t>(scaled) - 0x3F000000u));
+	}
+	// 正規化数（指数の付け替えと仮数部下位13bitの最近接偶数丸め）
+	const uint32_t mantissaOdd = (absBits >> 13) & 1u;
+	const uint32_t rounded = absBits + 0xC8000FFFu + mantissaOdd;
+	return static_cast<uint16_t>(sign | (rounded >> 13));
+}
+
+float HalfToFloat(uint16_t value) {
+	const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+	const uint32_t exponent = (value >> 10) & 0x1Fu;
+	const uint32_t mantissa = value & 0x03FFu;
+	if (exponent == 0) {
+		// 0 と非正規化数
+		return std::bit_cast<float>(sign | std::bit_cast<uint32_t>(static_cast<float>(mantissa) * 5.9604644775390625e-8f));
+	}
+	if (exponent == 0x1Fu) {
+		return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+	}
+	return std::bit_cast<float>(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+}
+
+uint16_t FloatToUnorm16(float value) { return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f)); }
+
+float Unorm16ToFloat(uint16_t value) { return static_cast<float>(value) * (1.0f / 65535.0f); }
+
+int16_t FloatToSnorm16(float value) { return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f)); }
+
+float Snorm16ToFloat(int16_t value) { return std::max(static_cast<float>(value) * (1.0f / 32767.0f), -1.0f); }
+
+int8_t FloatToSnorm8(float value) { return static_cast<int8_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 127.0f)); }
+
+float Snorm8ToFloat(int8_t value) { return std::max(static_cast<float>(value) * (1.0f / 127.0f), -1.0f); }
+
+Vector2 OctahedralEncode(const Vector3& normal) {
+	// 八面体に射影し、下半分は折り返して上半分の外側に重ねる
+	const float invL1 = 1.0f / (std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z));
+	const float x = normal.x * invL1;
+	const float y = normal.y * invL1;
+	if (normal.z >= 0.0f) {
+		return {x, y};
+	}
+	return {(1.0f - std::fabs(y)) * SignNotZero(x), (1.0f - std::fabs(x)) * SignNotZero(y)};
+}
+
+Vector3 OctahedralDecode(const Vector2& encoded) {
+	Vector3 v = {encoded.x, encoded.y, 1.0f - std::fabs(encoded.x) - std::fabs(encoded.y)};
+	if (v.z < 0.0f) {
+		const float x = v.x;
+		v.x = (1.0f - std::fabs(v.y)) * SignNotZero(x);
+		v.y = (1.0f - std::fabs(x)) * SignNotZero(v.y);
+	}
+	const float invLength = 1.0f / std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+	return {v.x * invLength, v.y * invLength, v.z * invLength};
+}
+
+uint32_t EncodeNormalOct16(const Vector3& normal) {
+	const Vector2 e = OctahedralEncode(normal);
+	return static_cast<uint16_t>(FloatToSnorm16(e.x)) | (static_cast<uint32_t>(static_cast<uint16_t>(FloatToSnorm16(e.y))) << 16);
+}
+
+Vector3 DecodeNormalOct16(uint32_t encoded) {
+	return OctahedralDecode({Snorm16ToFloat(static_cast<int16_t>(encoded & 0xFFFFu)), Snorm16ToFloat(static_cast<int16_t>(encoded >> 16))});
+}
+
+uint16_t EncodeNormalOct8(const Vector3& normal) {
+	const Vector2 e = OctahedralEncode(normal);
+	return static_cast<uint16_t>(static_cast<uint8_t>(FloatToSnorm8(e.x)) | (static_cast<uint8_t>(FloatToSnorm8(e.y)) << 8));
+}
+
+Vector3 DecodeNormalOct8(uint16_t encoded) {
+	return OctahedralDecode({Snorm8ToFloat(static_cast<int8_t>(encoded & 0xFFu)), Snorm8ToFloat(static_cast<int8_t>(encoded >> 8))});
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "math/Vector2.h"
+#include "math/Vector3.h"
+#include <cstdint>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+// 半精度浮動小数点数への変換（最近接偶数丸め。範囲外は無限大になる）
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t value);
+
+// 正規化整数への変換（範囲外の値は丸め込む）
+// unorm は [0, 1]、snorm は [-1, 1] を整数の全範囲に対応させる。
+uint16_t FloatToUnorm16(float value);
+float Unorm16ToFloat(uint16_t value);
+int16_t FloatToSnorm16(float value);
+float Snorm16ToFloat(int16_t value);
+int8_t FloatToSnorm8(float value);
+float Snorm8ToFloat(int8_t value);
+
+// 単位ベクトルを八面体写像で [-1, 1] の2次元座標にする（normal は正規化済みであること）
+Vector2 OctahedralEncode(const Vector3& normal);
+// 八面体写像の2次元座標から単位ベクトルに戻す
+Vector3 OctahedralDecode(const Vector2& encoded);
+
+// 法線を八面体写像で圧縮する（16bit x 2 / 8bit x 2）
+uint32_t EncodeNormalOct16(const Vector3& normal);
+Vector3 DecodeNormalOct16(uint32_t encoded);
+uint16_t EncodeNormalOct8(const Vector3& normal);
+Vector3 DecodeNormalOct8(uint16_t encoded);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,15 @@
+#pragma once
+
+namespace KamataEngine {
+
+/// <summary>
+/// クォータニオン
+/// </summary>
+struct Quaternion final {
+	float x;
+	float y;
+	float z;
+	float w;
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,380 @@
+#include "math/QuaternionUtility.h"
+#include "math/SimdSupport.h"
+#include <cassert>
+#include <cmath>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+Quaternion IdentityQuaternion() { return {0.0f, 0.0f, 0.0f, 1.0f}; }
+
+Quaternion operator*(const Quaternion& q1, const Quaternion& q2) {
+	return {
+	    q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y,
+	    q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x,
+	    q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w,
+	    q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z,
+	};
+}
+
+Quaternion& operator*=(Quaternion& lhq, const Quaternion& rhq) {
+	lhq = lhq * rhq;
+	return lhq;
+}
+
+Quaternion Conjugate(const Quaternion& q) { return {-q.x, -q.y, -q.z, q.w}; }
+
+float Length(const Quaternion& q) { return std::sqrt(Dot(q, q)); }
+
+Quaternion Normalize(const Quaternion& q) {
+	const float length = Length(q);
+	if (length == 0.0f) {
+		return q;
+	}
+	return {q.x / length, q.y / length, q.z / length, q.w / length};
+}
+
+Quaternion Inverse(const Quaternion& q) {
+	const float normSq = Dot(q, q);
+	const Quaternion conjugate = Conjugate(q);
+	return {conjugate.x / normSq, conjugate.y / normSq, conjugate.z / normSq, conjugate.w / normSq};
+}
+
+float Dot(const Quaternion& q1, const Quaternion& q2) { return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w; }
+
+Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float angle) {
+	const float s = std::sin(angle * 0.5f);
+	return {axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f)};
+}
+
+Quaternion MakeRotateQuaternion(const Vector3& rotate) {
+	// X → Y → Z の順に回転するので qz * qy * qx を展開したもの
+	const float sx = std::sin(rotate.x * 0.5f);
+	const float cx = std::cos(rotate.x * 0.5f);
+	const float sy = std::sin(rotate.y * 0.5f);
+	const float cy = std::cos(rotate.y * 0.5f);
+	const float sz = std::sin(rotate.z * 0.5f);
+	const float cz = std::cos(rotate.z * 0.5f);
+	return {
+	    sx * cy * cz - cx * sy * sz,
+	    cx * sy * cz + sx * cy * sz,
+	    cx * cy * sz - sx * sy * cz,
+	    cx * cy * cz + sx * sy * sz,
+	};
+}
+
+Vector3 MakeEulerAngles(const Quaternion& q) {
+	// 回転行列 Rx * Ry * Rz の要素から求める
+	const float m02 = 2.0f * (q.x * q.z - q.w * q.y);
+	const float sinY = -m02 > 1.0f ? 1.0f : (-m02 < -1.0f ? -1.0f : -m02);
+	const float y = std::asin(sinY);
+	if (std::fabs(sinY) > 0.9999f) {
+		const float m11 = 1.0f - 2.0f * (q.x * q.x + q.z * q.z);
+		const float m21 = 2.0f * (q.y * q.z - q.w * q.x);
+		return {std::atan2(-m21, m11), y, 0.0f};
+	}
+	const float m00 = 1.0f - 2.0f * (q.y * q.y + q.z * q.z);
+	const float m01 = 2.0f * (q.x * q.y + q.w * q.z);
+	const float m12 = 2.0f * (q.y * q.z + q.w * q.x);
+	const float m22 = 1.0f - 2.0f * (q.x * q.x + q.y * q.y);
+	return {std::atan2(m12, m22), y, std::atan2(m01, m00)};
+}
+
+Vector3 RotateVector(const Vector3& v, const Quaternion& q) {
+	// v' = v + 2w(u × v) + 2u × (u × v)
+	const Vector3 u = {q.x, q.y, q.z};
+	const Vector3 t = {2.0f * (u.y * v.z - u.z * v.y), 2.0f * (u.z * v.x - u.x * v.z), 2.0f * (u.x * v.y - u.y * v.x)};
+	return {
+	    v.x + q.w * t.x + (u.y * t.z - u.z * t.y),
+	    v.y + q.w * t.y + (u.z * t.x - u.x * t.z),
+	    v.z + q.w * t.z + (u.x * t.y - u.y * t.x),
+	};
+}
+
+Matrix4x4 MakeRotateMatrix(const Quaternion& q) { return MakeAffineMatrix({1.0f, 1.0f, 1.0f}, q, {0.0f, 0.0f, 0.0f}); }
+
+Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) {
+	const float xx = rotate.x * rotate.x;
+	const float yy = rotate.y * rotate.y;
+	const float zz = rotate.z * rotate.z;
+	const float xy = rotate.x * rotate.y;
+	const float xz = rotate.x * rotate.z;
+	const float yz = rotate.y * rotate.z;
+	const float wx = rotate.w * rotate.x;
+	const float wy = rotate.w * rotate.y;
+	const float wz = rotate.w * rotate.z;
+	return {{
+	    {scale.x * (1.0f - 2.0f * (yy + zz)), scale.x * (2.0f * (xy + wz)), scale.x * (2.0f * (xz - wy)), 0.0f},
+	    {scale.y * (2.0f * (xy - wz)), scale.y * (1.0f - 2.0f * (xx + zz)), scale.y * (2.0f * (yz + wx)), 0.0f},
+	    {scale.z * (2.0f * (xz + wy)), scale.z * (2.0f * (yz - wx)), scale.z * (1.0f - 2.0f * (xx + yy)), 0.0f},
+	    {translate.x, translate.y, translate.z, 1.0f},
+	}};
+}
+
+Quaternion NLerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	const float t1 = Dot(q0, q1) < 0.0f ? -t : t;
+	const float t0 = 1.0f - t;
+	return Normalize({t0 * q0.x + t1 * q1.x, t0 * q0.y + t1 * q1.y, t0 * q0.z + t1 * q1.z, t0 * q0.w + t1 * q1.w});
+}
+
+Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	float dot = Dot(q0, q1);
+	float sign = 1.0f;
+	if (dot < 0.0f) {
+		dot = -dot;
+		sign = -1.0f;
+	}
+	// ほぼ同じ向きなら sinθ が 0 に近くなるので線形補間で代用する
+	if (dot >= 0.9995f) {
+		return NLerp(q0, q1, t);
+	}
+	const float theta = std::acos(dot);
+	const float sinTheta = std::sin(theta);
+	const float s0 = std::sin((1.0f - t) * theta) / sinTheta;
+	const float s1 = sign * std::sin(t * theta) / sinTheta;
+	return {s0 * q0.x + s1 * q1.x, s0 * q0.y + s1 * q1.y, s0 * q0.z + s1 * q1.z, s0 * q0.w + s1 * q1.w};
+}
+
+namespace {
+
+// 補間の種類
+enum class BlendKind {
+	kNLerp,
+	kSlerp,
+};
+
+// Eberly の SLERP 近似の項数
+constexpr int kSlerpTerms = 8;
+
+// 補間係数 t ごとに前計算する値
+struct BlendCoefficients {
+	float t0;                 // 1 - t
+	float t1;                 // t
+	float coefT0[kSlerpTerms]; // u[i] * (1 - t)^2 - v[i]
+	float coefT1[kSlerpTerms]; // u[i] * t^2 - v[i]
+};
+
+BlendCoefficients MakeBlendCoefficients(float t) {
+	// u[i] = 1 / (i(2i+1)), v[i] = i / (2i+1)（最後の項は誤差補正係数を掛ける）
+	constexpr float kMu = 1.85298109240830f;
+	BlendCoefficients c;
+	c.t0 = 1.0f - t;
+	c.t1 = t;
+	for (int i = 0; i < kSlerpTerms; ++i) {
+		const float n = static_cast<float>(i + 1);
+		float u = 1.0f / (n * (2.0f * n + 1.0f));
+		float v = n / (2.0f * n + 1.0f);
+		if (i == kSlerpTerms - 1) {
+			u *= kMu;
+			v *= kMu;
+		}
+		c.coefT0[i] = u * c.t0 * c.t0 - v;
+		c.coefT1[i] = u * c.t1 * c.t1 - v;
+	}
+	return c;
+}
+
+#pragma region スカラー版
+
+template<BlendKind kKind>
+void BlendScalar(const Quaternion* q0, const Quaternion* q1, Quaternion* dst, size_t begin, size_t end, const BlendCoefficients& c) {
+	for (size_t i = begin; i < end; ++i) {
+		const Quaternion a = q0[i];
+		const Quaternion b = q1[i];
+		const float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+		float w0 = c.t0;
+		float w1 = c.t1;
+		if constexpr (kKind == BlendKind::kSlerp) {
+			const float xm1 = std::fabs(dot) - 1.0f;
+			float f0 = 1.0f;
+			float f1 = 1.0f;
+			for (int k = kSlerpTerms - 1; k >= 0; --k) {
+				f0 = 1.0f + c.coefT0[k] * xm1 * f0;
+				f1 = 1.0f + c.coefT1[k] * xm1 * f1;
+			}
+			w0 = w0 * f0;
+			w1 = w1 * f1;
+		}
+		if (dot < 0.0f) {
+			w1 = -w1;
+		}
+		Quaternion r = {w0 * a.x + w1 * b.x, w0 * a.y + w1 * b.y, w0 * a.z + w1 * b.z, w0 * a.w + w1 * b.w};
+		if constexpr (kKind == BlendKind::kNLerp) {
+			const float length = std::sqrt(r.x * r.x + r.y * r.y + r.z * r.z + r.w * r.w);
+			r = {r.x / length, r.y / length, r.z / length, r.w / length};
+		}
+		dst[i] = r;
+	}
+}
+
+#pragma endregion
+
+#if KAMATA_SIMD_X86
+
+#pragma region SSE版
+
+// 4つのクォータニオンを SoA で計算する
+template<BlendKind kKind>
+inline void BlendSSE(__m128& x, __m128& y, __m128& z, __m128& w, __m128 bx, __m128 by, __m128 bz, __m128 bw, const BlendCoefficients& c) {
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, bx), _mm_mul_ps(y, by)), _mm_mul_ps(z, bz)), _mm_mul_ps(w, bw));
+	__m128 w0 = _mm_set1_ps(c.t0);
+	__m128 w1 = _mm_set1_ps(c.t1);
+	if constexpr (kKind == BlendKind::kSlerp) {
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 xm1 = _mm_sub_ps(_mm_andnot_ps(signMask, dot), one);
+		__m128 f0 = one;
+		__m128 f1 = one;
+		for (int k = kSlerpTerms - 1; k >= 0; --k) {
+			f0 = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(c.coefT0[k]), xm1), f0));
+			f1 = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(c.coefT1[k]), xm1), f1));
+		}
+		w0 = _mm_mul_ps(w0, f0);
+		w1 = _mm_mul_ps(w1, f1);
+	}
+	// 内積が負なら q1 を反転して最短経路を通る
+	w1 = _mm_xor_ps(w1, _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), signMask));
+	x = _mm_add_ps(_mm_mul_ps(w0, x), _mm_mul_ps(w1, bx));
+	y = _mm_add_ps(_mm_mul_ps(w0, y), _mm_mul_ps(w1, by));
+	z = _mm_add_ps(_mm_mul_ps(w0, z), _mm_mul_ps(w1, bz));
+	w = _mm_add_ps(_mm_mul_ps(w0, w), _mm_mul_ps(w1, bw));
+	if constexpr (kKind == BlendKind::kNLerp) {
+		const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)), _mm_mul_ps(w, w)));
+		x = _mm_div_ps(x, length);
+		y = _mm_div_ps(y, length);
+		z = _mm_div_ps(z, length);
+		w = _mm_div_ps(w, length);
+	}
+}
+
+template<BlendKind kKind>
+void BlendBatchSSE(const Quaternion* q0, const Quaternion* q1, Quaternion* dst, size_t count, const BlendCoefficients& c) {
+	const float* a = reinterpret_cast<const float*>(q0);
+	const float* b = reinterpret_cast<const float*>(q1);
+	float* out = reinterpret_cast<float*>(dst);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 x = _mm_loadu_ps(a + i * 4), y = _mm_loadu_ps(a + i * 4 + 4), z = _mm_loadu_ps(a + i * 4 + 8), w = _mm_loadu_ps(a + i * 4 + 12);
+		__m128 bx = _mm_loadu_ps(b + i * 4), by = _mm_loadu_ps(b + i * 4 + 4), bz = _mm_loadu_ps(b + i * 4 + 8), bw = _mm_loadu_ps(b + i * 4 + 12);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_MM_TRANSPOSE4_PS(bx, by, bz, bw);
+		BlendSSE<kKind>(x, y, z, w, bx, by, bz, bw, c);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(out + i * 4, x);
+		_mm_storeu_ps(out + i * 4 + 4, y);
+		_mm_storeu_ps(out + i * 4 + 8, z);
+		_mm_storeu_ps(out + i * 4 + 12, w);
+	}
+	BlendScalar<kKind>(q0, q1, dst, i, count, c);
+}
+
+#pragma endregion
+
+#pragma region AVX2版
+
+// 128bit レーンごとに 4x4 転置する
+KAMATA_TARGET_AVX2 inline void TransposeInLanes(__m256& r0, __m256& r1, __m256& r2, __m256& r3) {
+	const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+	const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+	const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+	const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+	r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+	r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+	r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+	r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+// p[j] と p[j + 4] を上下のレーンに読み込む
+KAMATA_TARGET_AVX2 inline __m256 LoadPair(const float* p, size_t j) { return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + j * 4)), _mm_loadu_ps(p + (j + 4) * 4), 1); }
+
+KAMATA_TARGET_AVX2 inline void StorePair(float* p, size_t j, __m256 v) {
+	_mm_storeu_ps(p + j * 4, _mm256_castps256_ps128(v));
+	_mm_storeu_ps(p + (j + 4) * 4, _mm256_extractf128_ps(v, 1));
+}
+
+template<BlendKind kKind>
+KAMATA_TARGET_AVX2 void BlendBatchAVX2(const Quaternion* q0, const Quaternion* q1, Quaternion* dst, size_t count, const BlendCoefficients& c) {
+	const float* a = reinterpret_cast<const float*>(q0);
+	const float* b = reinterpret_cast<const float*>(q1);
+	float* out = reinterpret_cast<float*>(dst);
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 one = _mm256_set1_ps(1.0f);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 x = LoadPair(a, i), y = LoadPair(a, i + 1), z = LoadPair(a, i + 2), w = LoadPair(a, i + 3);
+		__m256 bx = LoadPair(b, i), by = LoadPair(b, i + 1), bz = LoadPair(b, i + 2), bw = LoadPair(b, i + 3);
+		TransposeInLanes(x, y, z, w);
+		TransposeInLanes(bx, by, bz, bw);
+
+		const __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, bx), _mm256_mul_ps(y, by)), _mm256_mul_ps(z, bz)), _mm256_mul_ps(w, bw));
+		__m256 w0 = _mm256_set1_ps(c.t0);
+		__m256 w1 = _mm256_set1_ps(c.t1);
+		if constexpr (kKind == BlendKind::kSlerp) {
+			const __m256 xm1 = _mm256_sub_ps(_mm256_andnot_ps(signMask, dot), one);
+			__m256 f0 = one;
+			__m256 f1 = one;
+			for (int k = kSlerpTerms - 1; k >= 0; --k) {
+				f0 = _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(c.coefT0[k]), xm1), f0));
+				f1 = _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(c.coefT1[k]), xm1), f1));
+			}
+			w0 = _mm256_mul_ps(w0, f0);
+			w1 = _mm256_mul_ps(w1, f1);
+		}
+		w1 = _mm256_xor_ps(w1, _mm256_and_ps(_mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_LT_OQ), signMask));
+		x = _mm256_add_ps(_mm256_mul_ps(w0, x), _mm256_mul_ps(w1, bx));
+		y = _mm256_add_ps(_mm256_mul_ps(w0, y), _mm256_mul_ps(w1, by));
+		z = _mm256_add_ps(_mm256_mul_ps(w0, z), _mm256_mul_ps(w1, bz));
+		w = _mm256_add_ps(_mm256_mul_ps(w0, w), _mm256_mul_ps(w1, bw));
+		if constexpr (kKind == BlendKind::kNLerp) {
+			const __m256 length =
+			    _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)), _mm256_mul_ps(w, w)));
+			x = _mm256_div_ps(x, length);
+			y = _mm256_div_ps(y, length);
+			z = _mm256_div_ps(z, length);
+			w = _mm256_div_ps(w, length);
+		}
+
+		TransposeInLanes(x, y, z, w);
+		StorePair(out, i, x);
+		StorePair(out, i + 1, y);
+		StorePair(out, i + 2, z);
+		StorePair(out, i + 3, w);
+	}
+	_mm256_zeroupper();
+	BlendScalar<kKind>(q0, q1, dst, i, count, c);
+}
+
+#pragma endregion
+
+#endif // KAMATA_SIMD_X86
+
+template<BlendKind kKind>
+void DispatchBlend(std::span<const Quaternion> q0, std::span<const Quaternion> q1, float t, std::span<Quaternion> dst) {
+	assert(q1.size() >= q0.size());
+	assert(dst.size() >= q0.size());
+	const BlendCoefficients c = MakeBlendCoefficients(t);
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		BlendBatchAVX2<kKind>(q0.data(), q1.data(), dst.data(), q0.size(), c);
+		return;
+	case SimdLevel::kSSE:
+		BlendBatchSSE<kKind>(q0.data(), q1.data(), dst.data(), q0.size(), c);
+		return;
+#endif
+	default:
+		BlendScalar<kKind>(q0.data(), q1.data(), dst.data(), 0, q0.size(), c);
+		return;
+	}
+}
+
+} // namespace
+
+void NLerp(std::span<const Quaternion> q0, std::span<const Quaternion> q1, float t, std::span<Quaternion> dst) { DispatchBlend<BlendKind::kNLerp>(q0, q1, t, dst); }
+
+void Slerp(std::span<const Quaternion> q0, std::span<const Quaternion> q1, float t, std::span<Quaternion> dst) { DispatchBlend<BlendKind::kSlerp>(q0, q1, t, dst); }
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
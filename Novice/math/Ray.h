@@ -0,0 +1,15 @@
+#pragma once
+
+#include "math/Vector3.h"
+
+namespace KamataEngine {
+
+/// <summary>
+/// 半直線（origin + direction * t, t >= 0）
+/// </summary>
+struct Ray final {
+	Vector3 origin;    // 始点
+	Vector3 direction; // 方向（正規化されていなくてもよい。t は direction の長さを単位とする）
+};
+
+} // namespace KamataEngine
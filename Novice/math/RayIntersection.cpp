@@ -0,0 +1,231 @@
+#include "math/RayIntersection.h"
+#include "math/MathUtilityConstexpr.h"
+#include "math/SimdSupport.h"
+#include <cmath>
+#include <limits>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+namespace {
+
+// 行列式がこれ以下なら半直線と三角形が平行とみなす
+constexpr float kParallelEpsilon = 1e-12f;
+// 交差なしを表す三角形番号
+constexpr uint32_t kNoHit = std::numeric_limits<uint32_t>::max();
+
+// Möller–Trumbore 法。SIMD 版もこの関数と同じ演算順序で計算する
+inline bool IntersectEdges(
+    const Ray& ray, float v0x, float v0y, float v0z, float e1x, float e1y, float e1z, float e2x, float e2y, float e2z, float maxDistance, float& t, float& u, float& v) {
+	const Vector3& d = ray.direction;
+	const float px = d.y * e2z - d.z * e2y;
+	const float py = d.z * e2x - d.x * e2z;
+	const float pz = d.x * e2y - d.y * e2x;
+	const float det = e1x * px + e1y * py + e1z * pz;
+	const float invDet = 1.0f / det;
+	const float sx = ray.origin.x - v0x;
+	const float sy = ray.origin.y - v0y;
+	const float sz = ray.origin.z - v0z;
+	u = (sx * px + sy * py + sz * pz) * invDet;
+	const float qx = sy * e1z - sz * e1y;
+	const float qy = sz * e1x - sx * e1z;
+	const float qz = sx * e1y - sy * e1x;
+	v = (d.x * qx + d.y * qy + d.z * qz) * invDet;
+	t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+	return std::fabs(det) > kParallelEpsilon && u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < maxDistance;
+}
+
+#pragma region スカラー版
+
+// begin 番目以降で bestT より近い交点を探し、見つかれば bestT と bestIndex を更新する
+void IntersectScalar(const Ray& ray, const TriangleSoA& s, size_t begin, float& bestT, uint32_t& bestIndex) {
+	for (size_t i = begin; i < s.size; ++i) {
+		float t, u, v;
+		if (IntersectEdges(ray, s.v0x[i], s.v0y[i], s.v0z[i], s.edge1x[i], s.edge1y[i], s.edge1z[i], s.edge2x[i], s.edge2y[i], s.edge2z[i], bestT, t, u, v)) {
+			bestT = t;
+			bestIndex = static_cast<uint32_t>(i);
+		}
+	}
+}
+
+#pragma endregion
+
+#if KAMATA_SIMD_X86
+
+// 各要素の最近交点から全体の最近交点を選ぶ（同じ距離なら番号の小さい方）
+void ReduceLanes(const float* laneT, const uint32_t* laneIndex, size_t laneCount, float& bestT, uint32_t& bestIndex) {
+	for (size_t lane = 0; lane < laneCount; ++lane) {
+		if (laneIndex[lane] == kNoHit) {
+			continue;
+		}
+		if (laneT[lane] < bestT || (laneT[lane] == bestT && laneIndex[lane] < bestIndex)) {
+			bestT = laneT[lane];
+			bestIndex = laneIndex[lane];
+		}
+	}
+}
+
+#pragma region SSE版
+
+void IntersectSSE(const Ray& ray, const TriangleSoA& s, float& bestT, uint32_t& bestIndex) {
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 epsilon = _mm_set1_ps(kParallelEpsilon);
+	const __m128 dx = _mm_set1_ps(ray.direction.x), dy = _mm_set1_ps(ray.direction.y), dz = _mm_set1_ps(ray.direction.z);
+	const __m128 ox = _mm_set1_ps(ray.origin.x), oy = _mm_set1_ps(ray.origin.y), oz = _mm_set1_ps(ray.origin.z);
+	const __m128i laneOffset = _mm_setr_epi32(0, 1, 2, 3);
+
+	__m128 laneT = _mm_set1_ps(bestT);
+	__m128 laneIndex = _mm_castsi128_ps(_mm_set1_epi32(-1));
+	size_t i = 0;
+	for (; i + 4 <= s.size; i += 4) {
+		const __m128 e1x = _mm_loadu_ps(s.edge1x + i), e1y = _mm_loadu_ps(s.edge1y + i), e1z = _mm_loadu_ps(s.edge1z + i);
+		const __m128 e2x = _mm_loadu_ps(s.edge2x + i), e2y = _mm_loadu_ps(s.edge2y + i), e2z = _mm_loadu_ps(s.edge2z + i);
+		const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+		const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+		const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+		const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+		const __m128 invDet = _mm_div_ps(one, det);
+		const __m128 sx = _mm_sub_ps(ox, _mm_loadu_ps(s.v0x + i));
+		const __m128 sy = _mm_sub_ps(oy, _mm_loadu_ps(s.v0y + i));
+		const __m128 sz = _mm_sub_ps(oz, _mm_loadu_ps(s.v0z + i));
+		const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+		const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+		const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+		const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+		const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+		const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+		__m128 hit = _mm_cmpgt_ps(_mm_andnot_ps(signMask, det), epsilon);
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(u, zero));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(v, zero));
+		hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(t, zero));
+		hit = _mm_and_ps(hit, _mm_cmplt_ps(t, laneT));
+		if (_mm_movemask_ps(hit) == 0) {
+			continue;
+		}
+		const __m128 index = _mm_castsi128_ps(_mm_add_epi32(_mm_set1_epi32(static_cast<int>(i)), laneOffset));
+		laneT = _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, laneT));
+		laneIndex = _mm_or_ps(_mm_and_ps(hit, index), _mm_andnot_ps(hit, laneIndex));
+	}
+
+	alignas(16) float lanesT[4];
+	alignas(16) uint32_t lanesIndex[4];
+	_mm_store_ps(lanesT, laneT);
+	_mm_store_ps(reinterpret_cast<float*>(lanesIndex), laneIndex);
+	ReduceLanes(lanesT, lanesIndex, 4, bestT, bestIndex);
+	IntersectScalar(ray, s, i, bestT, bestIndex);
+}
+
+#pragma endregion
+
+#pragma region AVX2版
+
+KAMATA_TARGET_AVX2 void IntersectAVX2(const Ray& ray, const TriangleSoA& s, float& bestT, uint32_t& bestIndex) {
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 epsilon = _mm256_set1_ps(kParallelEpsilon);
+	const __m256 dx = _mm256_set1_ps(ray.direction.x), dy = _mm256_set1_ps(ray.direction.y), dz = _mm256_set1_ps(ray.direction.z);
+	const __m256 ox = _mm256_set1_ps(ray.origin.x), oy = _mm256_set1_ps(ray.origin.y), oz = _mm256_set1_ps(ray.origin.z);
+	const __m256i laneOffset = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+	__m256 laneT = _mm256_set1_ps(bestT);
+	__m256 laneIndex = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+	size_t i = 0;
+	for (; i + 8 <= s.size; i += 8) {
+		const __m256 e1x = _mm256_loadu_ps(s.edge1x + i), e1y = _mm256_loadu_ps(s.edge1y + i), e1z = _mm256_loadu_ps(s.edge1z + i);
+		const __m256 e2x = _mm256_loadu_ps(s.edge2x + i), e2y = _mm256_loadu_ps(s.edge2y + i), e2z = _mm256_loadu_ps(s.edge2z + i);
+		const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+		const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+		const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+		const __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+		const __m256 invDet = _mm256_div_ps(one, det);
+		const __m256 sx = _mm256_sub_ps(ox, _mm256_loadu_ps(s.v0x + i));
+		const __m256 sy = _mm256_sub_ps(oy, _mm256_loadu_ps(s.v0y + i));
+		const __m256 sz = _mm256_sub_ps(oz, _mm256_loadu_ps(s.v0z + i));
+		const __m256 u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)), _mm256_mul_ps(sz, pz)), invDet);
+		const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+		const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+		const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+		const __m256 v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)), invDet);
+		const __m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)), invDet);
+
+		__m256 hit = _mm256_cmp_ps(_mm256_andnot_ps(signMask, det), epsilon, _CMP_GT_OQ);
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, laneT, _CMP_LT_OQ));
+		if (_mm256_movemask_ps(hit) == 0) {
+			continue;
+		}
+		const __m256 index = _mm256_castsi256_ps(_mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)), laneOffset));
+		laneT = _mm256_blendv_ps(laneT, t, hit);
+		laneIndex = _mm256_blendv_ps(laneIndex, index, hit);
+	}
+
+	alignas(32) float lanesT[8];
+	alignas(32) uint32_t lanesIndex[8];
+	_mm256_store_ps(lanesT, laneT);
+	_mm256_store_ps(reinterpret_cast<float*>(lanesIndex), laneIndex);
+	_mm256_zeroupper();
+	ReduceLanes(lanesT, lanesIndex, 8, bestT, bestIndex);
+	IntersectScalar(ray, s, i, bestT, bestIndex);
+}
+
+#pragma endregion
+
+#endif // KAMATA_SIMD_X86
+
+} // namespace
+
+Ray Transform(const Ray& ray, const Matrix4x4& m) { return {Constexpr::Transform(ray.origin, m), Constexpr::TransformNormal(ray.direction, m)}; }
+
+bool Intersect(const Ray& ray, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, RayHit* hit) {
+	float t, u, v;
+	if (!IntersectEdges(ray, v0.x, v0.y, v0.z, v1.x - v0.x, v1.y - v0.y, v1.z - v0.z, v2.x - v0.x, v2.y - v0.y, v2.z - v0.z, maxDistance, t, u, v)) {
+		return false;
+	}
+	if (hit) {
+		*hit = {t, u, v, 0};
+	}
+	return true;
+}
+
+bool Intersect(const Ray& ray, const TriangleSoA& triangles, float maxDistance, RayHit* hit) {
+	float bestT = maxDistance;
+	uint32_t bestIndex = kNoHit;
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		IntersectAVX2(ray, triangles, bestT, bestIndex);
+		break;
+	case SimdLevel::kSSE:
+		IntersectSSE(ray, triangles, bestT, bestIndex);
+		break;
+#endif
+	default:
+		IntersectScalar(ray, triangles, 0, bestT, bestIndex);
+		break;
+	}
+	if (bestIndex == kNoHit) {
+		return false;
+	}
+	if (hit) {
+		// 重心座標は最も近い三角形についてだけ計算し直す（同じ演算なので SIMD 版の値と一致する）
+		const TriangleSoA& s = triangles;
+		const size_t i = bestIndex;
+		float t, u, v;
+		IntersectEdges(ray, s.v0x[i], s.v0y[i], s.v0z[i], s.edge1x[i], s.edge1y[i], s.edge1z[i], s.edge2x[i], s.edge2y[i], s.edge2z[i], maxDistance, t, u, v);
+		*hit = {t, u, v, bestIndex};
+	}
+	return true;
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "math/Matrix4x4.h"
+#include "math/Ray.h"
+#include "math/Vector3.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace KamataEngine {
+
+/// <summary>
+/// 半直線と三角形の交差結果
+/// </summary>
+struct RayHit final {
+	float t;                // 交点までの距離（Ray::direction の長さ単位）
+	float u;                // 交点の重心座標（v1 の重み）
+	float v;                // 交点の重心座標（v2 の重み）
+	uint32_t triangleIndex; // 三角形の番号
+};
+
+/// <summary>
+/// SoA 形式の三角形配列（頂点0と、頂点0から頂点1・頂点2への辺で表す）
+/// </summary>
+struct TriangleSoA {
+	const float* v0x;
+	const float* v0y;
+	const float* v0z;
+	const float* edge1x;
+	const float* edge1y;
+	const float* edge1z;
+	const float* edge2x;
+	const float* edge2y;
+	const float* edge2z;
+	size_t size;
+};
+
+namespace MathUtility {
+
+// 半直線を変換する（方向は正規化しないため、変換後の t は変換前と同じ点を指す）
+Ray Transform(const Ray& ray, const Matrix4x4& m);
+
+// 半直線と三角形の交差判定（Möller–Trumbore 法、両面）
+// 交差していて t < maxDistance なら hit に結果を書き込み true を返す。hit の triangleIndex は 0 になる。
+bool Intersect(const Ray& ray, const Vector3& v0, const Vector3& v1, const Vector3& v2, float maxDistance, RayHit* hit = nullptr);
+
+// 三角形配列の中で最も近い交点を求める
+// SetSimdLevel で選択された SSE / AVX2 カーネルで 4 / 8 個ずつ判定し、どのレベルでも結果は一致する。
+// 同じ距離の交点が複数ある場合は番号の小さい三角形を返す。
+bool Intersect(const Ray& ray, const TriangleSoA& triangles, float maxDistance, RayHit* hit = nullptr);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
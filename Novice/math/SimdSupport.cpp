@@ -0,0 +1,67 @@
+#include "math/SimdSupport.h"
+#include <atomic>
+
+#if KAMATA_SIMD_X86 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+namespace {
+
+SimdLevel DetectSimdLevel() {
+#if KAMATA_SIMD_X86 && defined(_MSC_VER) && !defined(__clang__)
+	int info[4] = {};
+	__cpuid(info, 0);
+	const int maxLeaf = info[0];
+
+	__cpuid(info, 1);
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx = (info[2] & (1 << 28)) != 0;
+	// OS が YMM レジスタの退避に対応しているか
+	const bool ymmEnabled = osxsave && (_xgetbv(0) & 0x6) == 0x6;
+
+	bool avx2 = false;
+	if (maxLeaf >= 7) {
+		__cpuidex(info, 7, 0);
+		avx2 = (info[1] & (1 << 5)) != 0;
+	}
+	if (avx && avx2 && ymmEnabled) {
+		return SimdLevel::kAVX2;
+	}
+	return SimdLevel::kSSE;
+#elif KAMATA_SIMD_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return SimdLevel::kAVX2;
+	}
+	return __builtin_cpu_supports("sse2") ? SimdLevel::kSSE : SimdLevel::kScalar;
+#else
+	return SimdLevel::kScalar;
+#endif
+}
+
+std::atomic<SimdLevel>& ActiveLevel() {
+	static std::atomic<SimdLevel> level{GetSupportedSimdLevel()};
+	return level;
+}
+
+} // namespace
+
+SimdLevel GetSupportedSimdLevel() {
+	static const SimdLevel supported = DetectSimdLevel();
+	return supported;
+}
+
+SimdLevel GetSimdLevel() { return ActiveLevel().load(std::memory_order_relaxed); }
+
+void SetSimdLevel(SimdLevel level) {
+	const SimdLevel supported = GetSupportedSimdLevel();
+	ActiveLevel().store(level < supported ? level : supported, std::memory_order_relaxed);
+}
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
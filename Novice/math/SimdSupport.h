@@ -0,0 +1,96 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define KAMATA_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define KAMATA_SIMD_X86 0
+#endif
+
+// AVX2 命令を使う関数に付ける属性（MSVC は属性なしで組み込み関数を使える）
+#if KAMATA_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define KAMATA_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define KAMATA_TARGET_AVX2
+#endif
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+/// <summary>
+/// SIMD 命令セットのレベル
+/// </summary>
+enum class SimdLevel {
+	kScalar, // SIMD なし
+	kSSE,    // SSE2 (4 要素)
+	kAVX2,   // AVX2 (8 要素)
+};
+
+/// <summary>
+/// CPU が対応している最上位の SIMD レベルを取得（初回呼び出し時に判定）
+/// </summary>
+SimdLevel GetSupportedSimdLevel();
+
+/// <summary>
+/// バッチ演算で使用中の SIMD レベルを取得
+/// </summary>
+SimdLevel GetSimdLevel();
+
+/// <summary>
+/// バッチ演算で使用する SIMD レベルを設定（CPU の対応レベルを上限に丸める）
+/// </summary>
+/// <param name="level">SIMD レベル</param>
+void SetSimdLevel(SimdLevel level);
+
+/// <summary>
+/// 比較結果のビットマスクで立っているビットの番号を書き込む（SIMD 判定結果の詰め込み用）
+/// </summary>
+/// <param name="mask">比較結果のビットマスク</param>
+/// <param name="base">ビット 0 に対応する要素番号</param>
+/// <param name="out">書き込み先</param>
+/// <param name="count">書き込み済みの数</param>
+/// <returns>書き込み後の数</returns>
+inline size_t AppendMaskedIndices(uint32_t mask, size_t base, uint32_t* out, size_t count) {
+	while (mask) {
+		out[count++] = static_cast<uint32_t>(base + std::countr_zero(mask));
+		mask &= mask - 1;
+	}
+	return count;
+}
+
+#if KAMATA_SIMD_X86
+
+// xyz が並んだ 4 要素分 (12 float) を x, y, z のレジスタに分解
+inline void Deinterleave4(const float* p, __m128& x, __m128& y, __m128& z) {
+	const __m128 a = _mm_loadu_ps(p);     // x0 y0 z0 x1
+	const __m128 b = _mm_loadu_ps(p + 4); // y1 z1 x2 y2
+	const __m128 c = _mm_loadu_ps(p + 8); // z2 x3 y3 z3
+	const __m128 t0 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+	const __m128 t1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+	const __m128 t2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+	const __m128 t3 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+	x = _mm_shuffle_ps(a, t0, _MM_SHUFFLE(2, 0, 3, 0));
+	y = _mm_shuffle_ps(t1, t2, _MM_SHUFFLE(2, 0, 2, 0));
+	z = _mm_shuffle_ps(t3, c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+// x, y, z のレジスタを xyz が並んだ 4 要素分 (12 float) に戻す
+inline void Interleave4(float* p, __m128 x, __m128 y, __m128 z) {
+	const __m128 a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+	const __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+	const __m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	_mm_storeu_ps(p, a);
+	_mm_storeu_ps(p + 4, b);
+	_mm_storeu_ps(p + 8, c);
+}
+
+#endif // KAMATA_SIMD_X86
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
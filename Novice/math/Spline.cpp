@@ -0,0 +1,175 @@
+#include "math/Spline.h"
+#include "math/MathUtilityConstexpr.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace KamataEngine {
+
+namespace {
+
+using MathUtility::Constexpr::operator+;
+using MathUtility::Constexpr::operator-;
+using MathUtility::Constexpr::operator*;
+using MathUtility::Constexpr::Cross;
+using MathUtility::Constexpr::Dot;
+
+inline Vector3 NormalizeOrZero(const Vector3& v) {
+	const float length = std::sqrt(Dot(v, v));
+	return length > 0.0f ? v * (1.0f / length) : Vector3{0.0f, 0.0f, 0.0f};
+}
+
+} // namespace
+
+namespace MathUtility {
+
+Vector3 CatmullRom(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t) {
+	const float t2 = t * t;
+	const float t3 = t2 * t;
+	return (p1 * 2.0f + (p2 - p0) * t + (p0 * 2.0f - p1 * 5.0f + p2 * 4.0f - p3) * t2 + (p1 * 3.0f - p0 - p2 * 3.0f + p3) * t3) * 0.5f;
+}
+
+Vector3 Bezier(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t) {
+	const float u = 1.0f - t;
+	return p0 * (u * u * u) + p1 * (3.0f * u * u * t) + p2 * (3.0f * u * t * t) + p3 * (t * t * t);
+}
+
+Vector3 MakeLookRotation(const Vector3& direction) {
+	// (0, 0, 1) を X 軸回り → Y 軸回りの順に回転させて direction に向ける
+	return {std::atan2(-direction.y, std::sqrt(direction.x * direction.x + direction.z * direction.z)), std::atan2(direction.x, direction.z), 0.0f};
+}
+
+} // namespace MathUtility
+
+void Spline::SetCatmullRom(std::span<const Vector3> points, bool loop) {
+	assert(points.size() >= 2);
+	segments_.clear();
+	parameters_.clear();
+	distances_.clear();
+
+	const size_t count = points.size();
+	const size_t segmentCount = loop ? count : count - 1;
+	// 範囲外の制御点は、閉じていれば反対側を、開いていれば端点を使う
+	auto point = [&](ptrdiff_t i) -> const Vector3& {
+		if (loop) {
+			return points[static_cast<size_t>((i % static_cast<ptrdiff_t>(count) + static_cast<ptrdiff_t>(count)) % static_cast<ptrdiff_t>(count))];
+		}
+		return points[static_cast<size_t>(std::clamp<ptrdiff_t>(i, 0, static_cast<ptrdiff_t>(count) - 1))];
+	};
+	for (size_t i = 0; i < segmentCount; ++i) {
+		const ptrdiff_t k = static_cast<ptrdiff_t>(i);
+		const Vector3& p0 = point(k - 1);
+		const Vector3& p1 = point(k);
+		const Vector3& p2 = point(k + 1);
+		const Vector3& p3 = point(k + 2);
+		segments_.push_back({
+		    (p1 * 3.0f - p0 - p2 * 3.0f + p3) * 0.5f,
+		    (p0 * 2.0f - p1 * 5.0f + p2 * 4.0f - p3) * 0.5f,
+		    (p2 - p0) * 0.5f,
+		    p1,
+		});
+	}
+}
+
+void Spline::SetBezier(std::span<const Vector3> points) {
+	assert(points.size() >= 4 && (points.size() - 1) % 3 == 0);
+	segments_.clear();
+	parameters_.clear();
+	distances_.clear();
+
+	for (size_t i = 0; i + 3 < points.size(); i += 3) {
+		const Vector3& p0 = points[i];
+		const Vector3& p1 = points[i + 1];
+		const Vector3& p2 = points[i + 2];
+		const Vector3& p3 = points[i + 3];
+		segments_.push_back({
+		    p1 * 3.0f - p0 - p2 * 3.0f + p3,
+		    (p0 - p1 * 2.0f + p2) * 3.0f,
+		    (p1 - p0) * 3.0f,
+		    p0,
+		});
+	}
+}
+
+void Spline::BuildArcLengthTable(size_t samplesPerSegment) {
+	assert(samplesPerSegment > 0);
+	const size_t sampleCount = segments_.size() * samplesPerSegment;
+	parameters_.resize(sampleCount + 1);
+	distances_.resize(sampleCount + 1);
+
+	// 折れ線の長さで近似する
+	Vector3 previous = Evaluate(0.0f);
+	parameters_[0] = 0.0f;
+	distances_[0] = 0.0f;
+	for (size_t i = 1; i <= sampleCount; ++i) {
+		const float t = static_cast<float>(i) / static_cast<float>(sampleCount);
+		const Vector3 current = Evaluate(t);
+		const Vector3 d = current - previous;
+		parameters_[i] = t;
+		distances_[i] = distances_[i - 1] + std::sqrt(Dot(d, d));
+		previous = current;
+	}
+}
+
+const Spline::Segment& Spline::Locate(float t, float& s) const {
+	assert(!segments_.empty());
+	const float scaled = std::clamp(t, 0.0f, 1.0f) * static_cast<float>(segments_.size());
+	const size_t index = std::min(static_cast<size_t>(scaled), segments_.size() - 1);
+	s = scaled - static_cast<float>(index);
+	return segments_[index];
+}
+
+Vector3 Spline::Evaluate(float t) const {
+	float s;
+	const Segment& g = Locate(t, s);
+	return ((g.a * s + g.b) * s + g.c) * s + g.d;
+}
+
+Vector3 Spline::EvaluateDerivative(float t) const {
+	float s;
+	const Segment& g = Locate(t, s);
+	// 区間内の微分に区間数を掛けて、曲線全体のパラメータでの微分にする
+	return ((g.a * (3.0f * s) + g.b * 2.0f) * s + g.c) * static_cast<float>(segments_.size());
+}
+
+SplineFrame Spline::EvaluateFrame(float t, const Vector3& up) const {
+	SplineFrame frame;
+	frame.position = Evaluate(t);
+	frame.tangent = NormalizeOrZero(EvaluateDerivative(t));
+	// Matrix4LookAtLH と同じく x = up × z, y = z × x
+	frame.right = NormalizeOrZero(Cross(up, frame.tangent));
+	frame.up = Cross(frame.tangent, frame.right);
+	return frame;
+}
+
+void Spline::Evaluate(std::span<const float> t, std::span<Vector3> dst) const {
+	assert(dst.size() >= t.size());
+	for (size_t i = 0; i < t.size(); ++i) {
+		dst[i] = Evaluate(t[i]);
+	}
+}
+
+float Spline::ParameterAtDistance(float distance) const {
+	assert(!distances_.empty());
+	if (distance <= 0.0f) {
+		return 0.0f;
+	}
+	if (distance >= distances_.back()) {
+		return 1.0f;
+	}
+	// distance を超える最初の標本と、その1つ前の標本の間で線形補間する
+	const size_t upper = static_cast<size_t>(std::upper_bound(distances_.begin(), distances_.end(), distance) - distances_.begin());
+	const size_t lower = upper - 1;
+	const float span = distances_[upper] - distances_[lower];
+	const float ratio = span > 0.0f ? (distance - distances_[lower]) / span : 0.0f;
+	return parameters_[lower] + (parameters_[upper] - parameters_[lower]) * ratio;
+}
+
+void Spline::EvaluateAtDistance(std::span<const float> distances, std::span<Vector3> dst) const {
+	assert(dst.size() >= distances.size());
+	for (size_t i = 0; i < distances.size(); ++i) {
+		dst[i] = Evaluate(ParameterAtDistance(distances[i]));
+	}
+}
+
+} // namespace KamataEngine
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "math/Vector3.h"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace KamataEngine {
+
+namespace MathUtility {
+
+// Catmull-Rom 曲線上の点を求める（p1 から p2 までを t = 0 ～ 1 で補間する）
+Vector3 CatmullRom(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t);
+// 3次ベジェ曲線上の点を求める
+Vector3 Bezier(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t);
+
+// 進行方向を向くオイラー角を求める（Camera::rotation_ や WorldTransform::rotation_ に使える。Z 軸回りは 0）
+Vector3 MakeLookRotation(const Vector3& direction);
+
+} // namespace MathUtility
+
+/// <summary>
+/// スプライン上の点での座標系
+/// </summary>
+struct SplineFrame final {
+	Vector3 position; // 座標
+	Vector3 tangent;  // 進行方向（正規化済み）
+	Vector3 right;    // 右方向（正規化済み）
+	Vector3 up;       // 上方向（正規化済み）
+};
+
+/// <summary>
+/// 3次スプライン曲線（区間ごとの多項式を保持し、弧長での等速移動に対応する）
+/// パラメータ t は曲線全体で 0 ～ 1 とし、各区間に均等に割り当てる。
+/// </summary>
+class Spline final {
+public:
+	/// <summary>
+	/// Catmull-Rom 曲線として設定（制御点をすべて通る）
+	/// </summary>
+	/// <param name="points">制御点（2つ以上）</param>
+	/// <param name="loop">終点と始点をつないで閉じた曲線にするか</param>
+	void SetCatmullRom(std::span<const Vector3> points, bool loop = false);
+
+	/// <summary>
+	/// 3次ベジェ曲線をつないだものとして設定
+	/// </summary>
+	/// <param name="points">制御点（始点, 制御点, 制御点, 終点(次の始点), ... の 3n + 1 個）</param>
+	void SetBezier(std::span<const Vector3> points);
+
+	/// <summary>
+	/// 弧長テーブルを作成（SetCatmullRom / SetBezier の後、弧長を使う前に一度呼ぶ）
+	/// </summary>
+	/// <param name="samplesPerSegment">区間あたりの分割数（多いほど等速移動が正確になる）</param>
+	void BuildArcLengthTable(size_t samplesPerSegment = 32);
+
+	/// <summary>
+	/// 曲線上の点を求める
+	/// </summary>
+	/// <param name="t">パラメータ（0 ～ 1）</param>
+	Vector3 Evaluate(float t) const;
+
+	/// <summary>
+	/// 接線（パラメータでの微分。正規化しない）を求める
+	/// </summary>
+	/// <param name="t">パラメータ（0 ～ 1）</param>
+	Vector3 EvaluateDerivative(float t) const;
+
+	/// <summary>
+	/// 曲線上の座標系を求める
+	/// </summary>
+	/// <param name="t">パラメータ（0 ～ 1）</param>
+	/// <param name="up">上方向の基準（進行方向と平行でないこと）</param>
+	SplineFrame EvaluateFrame(float t, const Vector3& up = {0.0f, 1.0f, 0.0f}) const;
+
+	/// <summary>
+	/// 複数のパラメータでの点をまとめて求める（dst の要素数は t 以上であること）
+	/// </summary>
+	void Evaluate(std::span<const float> t, std::span<Vector3> dst) const;
+
+	/// <summary>
+	/// 全長を取得（BuildArcLengthTable 済みであること）
+	/// </summary>
+	float GetLength() const { return distances_.empty() ? 0.0f : distances_.back(); }
+
+	/// <summary>
+	/// 始点からの距離に対応するパラメータを求める（二分探索）
+	/// </summary>
+	/// <param name="distance">始点からの距離（0 ～ GetLength()）</param>
+	float ParameterAtDistance(float distance) const;
+
+	/// <summary>
+	/// 始点からの距離の点を求める
+	/// </summary>
+	Vector3 EvaluateAtDistance(float distance) const { return Evaluate(ParameterAtDistance(distance)); }
+
+	/// <summary>
+	/// 始点からの距離の座標系を求める
+	/// </summary>
+	SplineFrame EvaluateFrameAtDistance(float distance, const Vector3& up = {0.0f, 1.0f, 0.0f}) const { return EvaluateFrame(ParameterAtDistance(distance), up); }
+
+	/// <summary>
+	/// 複数の距離での点をまとめて求める（dst の要素数は distances 以上であること）
+	/// </summary>
+	void EvaluateAtDistance(std::span<const float> distances, std::span<Vector3> dst) const;
+
+	/// <summary>
+	/// 区間数を取得
+	/// </summary>
+	size_t GetSegmentCount() const { return segments_.size(); }
+
+private:
+	// 区間の多項式 p(s) = ((a * s + b) * s + c) * s + d（s は区間内の 0 ～ 1）
+	struct Segment {
+		Vector3 a;
+		Vector3 b;
+		Vector3 c;
+		Vector3 d;
+	};
+
+	// パラメータを区間の番号と区間内のパラメータに分ける
+	const Segment& Locate(float t, float& s) const;
+
+	std::vector<Segment> segments_;
+	// 弧長テーブル（パラメータと、そこまでの距離）
+	std::vector<float> parameters_;
+	std::vector<float> distances_;
+};
+
+} // namespace KamataEngine
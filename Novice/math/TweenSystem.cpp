@@ -0,0 +1,423 @@
+#include "math/TweenSystem.h"
+#include "math/SimdSupport.h"
+#include <cassert>
+#include <type_traits>
+
+namespace KamataEngine {
+
+namespace {
+
+using MathUtility::GetSimdLevel;
+using MathUtility::SimdLevel;
+
+// 値の型ごとの成分数
+constexpr size_t kComponentCounts[] = {1, 3, 4};
+
+// 1つのプールの配列
+struct PoolArrays {
+	float* elapsed;
+	const float* invDuration;
+	const float* from[4];
+	const float* to[4];
+	float* values[4];
+	size_t componentCount;
+};
+
+#pragma region スカラー版
+
+template<EaseType kEase> void AdvanceScalar(const PoolArrays& p, float deltaTime, size_t begin, size_t end) {
+	for (size_t i = begin; i < end; ++i) {
+		const float elapsed = p.elapsed[i] + deltaTime;
+		p.elapsed[i] = elapsed;
+		const float ratio = elapsed * p.invDuration[i];
+		const float w = MathUtility::Ease<kEase>(ratio < 1.0f ? ratio : 1.0f);
+		const float invW = 1.0f - w;
+		for (size_t c = 0; c < p.componentCount; ++c) {
+			p.values[c][i] = p.from[c][i] * invW + p.to[c][i] * w;
+		}
+	}
+}
+
+#pragma endregion
+
+#if KAMATA_SIMD_X86
+
+#pragma region SSE版
+
+// MathUtility::Ease と同じ演算順で 4 要素ずつ計算する
+template<EaseType kEase> inline __m128 EaseSSE(__m128 t) {
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 u = _mm_sub_ps(one, t);
+	if constexpr (kEase == EaseType::kInQuad) {
+		return _mm_mul_ps(t, t);
+	} else if constexpr (kEase == EaseType::kOutQuad) {
+		return _mm_sub_ps(one, _mm_mul_ps(u, u));
+	} else if constexpr (kEase == EaseType::kInOutQuad) {
+		const __m128 in = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.0f), t), t);
+		const __m128 out = _mm_sub_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.0f), u), u));
+		const __m128 first = _mm_cmplt_ps(t, _mm_set1_ps(0.5f));
+		return _mm_or_ps(_mm_and_ps(first, in), _mm_andnot_ps(first, out));
+	} else if constexpr (kEase == EaseType::kInCubic) {
+		return _mm_mul_ps(_mm_mul_ps(t, t), t);
+	} else if constexpr (kEase == EaseType::kOutCubic) {
+		return _mm_sub_ps(one, _mm_mul_ps(_mm_mul_ps(u, u), u));
+	} else if constexpr (kEase == EaseType::kInOutCubic) {
+		const __m128 in = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(4.0f), t), t), t);
+		const __m128 out = _mm_sub_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(4.0f), u), u), u));
+		const __m128 first = _mm_cmplt_ps(t, _mm_set1_ps(0.5f));
+		return _mm_or_ps(_mm_and_ps(first, in), _mm_andnot_ps(first, out));
+	} else if constexpr (kEase == EaseType::kInBack) {
+		return _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(MathUtility::kEaseBack3), t), _mm_set1_ps(MathUtility::kEaseBack1)));
+	} else if constexpr (kEase == EaseType::kOutBack) {
+		return _mm_sub_ps(one, _mm_mul_ps(_mm_mul_ps(u, u), _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(MathUtility::kEaseBack3), u), _mm_set1_ps(MathUtility::kEaseBack1))));
+	} else if constexpr (kEase == EaseType::kSmoothStep) {
+		return _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_set1_ps(2.0f), t)));
+	} else {
+		return t;
+	}
+}
+
+template<EaseType kEase> void AdvanceSSE(const PoolArrays& p, float deltaTime, size_t count) {
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	const __m128 one = _mm_set1_ps(1.0f);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128 elapsed = _mm_add_ps(_mm_loadu_ps(p.elapsed + i), dt);
+		_mm_storeu_ps(p.elapsed + i, elapsed);
+		const __m128 w = EaseSSE<kEase>(_mm_min_ps(_mm_mul_ps(elapsed, _mm_loadu_ps(p.invDuration + i)), one));
+		const __m128 invW = _mm_sub_ps(one, w);
+		for (size_t c = 0; c < p.componentCount; ++c) {
+			_mm_storeu_ps(p.values[c] + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(p.from[c] + i), invW), _mm_mul_ps(_mm_loadu_ps(p.to[c] + i), w)));
+		}
+	}
+	AdvanceScalar<kEase>(p, deltaTime, i, count);
+}
+
+#pragma endregion
+
+#pragma region AVX2版
+
+template<EaseType kEase> KAMATA_TARGET_AVX2 inline __m256 EaseAVX(__m256 t) {
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 u = _mm256_sub_ps(one, t);
+	if constexpr (kEase == EaseType::kInQuad) {
+		return _mm256_mul_ps(t, t);
+	} else if constexpr (kEase == EaseType::kOutQuad) {
+		return _mm256_sub_ps(one, _mm256_mul_ps(u, u));
+	} else if constexpr (kEase == EaseType::kInOutQuad) {
+		const __m256 in = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), t), t);
+		const __m256 out = _mm256_sub_ps(one, _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), u), u));
+		return _mm256_blendv_ps(out, in, _mm256_cmp_ps(t, _mm256_set1_ps(0.5f), _CMP_LT_OQ));
+	} else if constexpr (kEase == EaseType::kInCubic) {
+		return _mm256_mul_ps(_mm256_mul_ps(t, t), t);
+	} else if constexpr (kEase == EaseType::kOutCubic) {
+		return _mm256_sub_ps(one, _mm256_mul_ps(_mm256_mul_ps(u, u), u));
+	} else if constexpr (kEase == EaseType::kInOutCubic) {
+		const __m256 in = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(4.0f), t), t), t);
+		const __m256 out = _mm256_sub_ps(one, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(4.0f), u), u), u));
+		return _mm256_blendv_ps(out, in, _mm256_cmp_ps(t, _mm256_set1_ps(0.5f), _CMP_LT_OQ));
+	} else if constexpr (kEase == EaseType::kInBack) {
+		return _mm256_mul_ps(_mm256_mul_ps(t, t), _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(MathUtility::kEaseBack3), t), _mm256_set1_ps(MathUtility::kEaseBack1)));
+	} else if constexpr (kEase == EaseType::kOutBack) {
+		return _mm256_sub_ps(
+		    one, _mm256_mul_ps(_mm256_mul_ps(u, u), _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(MathUtility::kEaseBack3), u), _mm256_set1_ps(MathUtility::kEaseBack1))));
+	} else if constexpr (kEase == EaseType::kSmoothStep) {
+		return _mm256_mul_ps(_mm256_mul_ps(t, t), _mm256_sub_ps(_mm256_set1_ps(3.0f), _mm256_mul_ps(_mm256_set1_ps(2.0f), t)));
+	} else {
+		return t;
+	}
+}
+
+template<EaseType kEase> KAMATA_TARGET_AVX2 void AdvanceAVX2(const PoolArrays& p, float deltaTime, size_t count) {
+	const __m256 dt = _mm256_set1_ps(deltaTime);
+	const __m256 one = _mm256_set1_ps(1.0f);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256 elapsed = _mm256_add_ps(_mm256_loadu_ps(p.elapsed + i), dt);
+		_mm256_storeu_ps(p.elapsed + i, elapsed);
+		const __m256 w = EaseAVX<kEase>(_mm256_min_ps(_mm256_mul_ps(elapsed, _mm256_loadu_ps(p.invDuration + i)), one));
+		const __m256 invW = _mm256_sub_ps(one, w);
+		for (size_t c = 0; c < p.componentCount; ++c) {
+			_mm256_storeu_ps(p.values[c] + i, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(p.from[c] + i), invW), _mm256_mul_ps(_mm256_loadu_ps(p.to[c] + i), w)));
+		}
+	}
+	_mm256_zeroupper();
+	AdvanceScalar<kEase>(p, deltaTime, i, count);
+}
+
+#pragma endregion
+
+#endif // KAMATA_SIMD_X86
+
+template<EaseType kEase> void Advance(const PoolArrays& p, float deltaTime, size_t count) {
+	switch (GetSimdLevel()) {
+#if KAMATA_SIMD_X86
+	case SimdLevel::kAVX2:
+		AdvanceAVX2<kEase>(p, deltaTime, count);
+		break;
+	case SimdLevel::kSSE:
+		AdvanceSSE<kEase>(p, deltaTime, count);
+		break;
+#endif
+	default:
+		AdvanceScalar<kEase>(p, deltaTime, 0, count);
+		break;
+	}
+}
+
+void Advance(EaseType ease, const PoolArrays& p, float deltaTime, size_t count) {
+	switch (ease) {
+	case EaseType::kInQuad:
+		Advance<EaseType::kInQuad>(p, deltaTime, count);
+		break;
+	case EaseType::kOutQuad:
+		Advance<EaseType::kOutQuad>(p, deltaTime, count);
+		break;
+	case EaseType::kInOutQuad:
+		Advance<EaseType::kInOutQuad>(p, deltaTime, count);
+		break;
+	case EaseType::kInCubic:
+		Advance<EaseType::kInCubic>(p, deltaTime, count);
+		break;
+	case EaseType::kOutCubic:
+		Advance<EaseType::kOutCubic>(p, deltaTime, count);
+		break;
+	case EaseType::kInOutCubic:
+		Advance<EaseType::kInOutCubic>(p, deltaTime, count);
+		break;
+	case EaseType::kInBack:
+		Advance<EaseType::kInBack>(p, deltaTime, count);
+		break;
+	case EaseType::kOutBack:
+		Advance<EaseType::kOutBack>(p, deltaTime, count);
+		break;
+	case EaseType::kSmoothStep:
+		Advance<EaseType::kSmoothStep>(p, deltaTime, count);
+		break;
+	default:
+		Advance<EaseType::kLinear>(p, deltaTime, count);
+		break;
+	}
+}
+
+} // namespace
+
+void TweenSystem::Reserve(size_t capacity) {
+	slots_.reserve(capacity);
+	freeSlots_.reserve(capacity);
+}
+
+TweenHandle TweenSystem::Play(float* target, float from, float to, float duration, EaseType ease) {
+	return Add(kFloat, ease, &from, &to, duration, {target, nullptr});
+}
+
+TweenHandle TweenSystem::Play(Vector3* target, const Vector3& from, const Vector3& to, float duration, EaseType ease) {
+	return Add(kVector3, ease, &from.x, &to.x, duration, {target, nullptr});
+}
+
+TweenHandle TweenSystem::Play(Vector4* target, const Vector4& from, const Vector4& to, float duration, EaseType ease) {
+	return Add(kVector4, ease, &from.x, &to.x, duration, {target, nullptr});
+}
+
+TweenHandle TweenSystem::Play(TweenSetter<float> setter, void* context, float from, float to, float duration, EaseType ease) {
+	assert(setter);
+	return Add(kFloat, ease, &from, &to, duration, {context, reinterpret_cast<void (*)()>(setter)});
+}
+
+TweenHandle TweenSystem::Play(TweenSetter<Vector3> setter, void* context, const Vector3& from, const Vector3& to, float duration, EaseType ease) {
+	assert(setter);
+	return Add(kVector3, ease, &from.x, &to.x, duration, {context, reinterpret_cast<void (*)()>(setter)});
+}
+
+TweenHandle TweenSystem::Play(TweenSetter<Vector4> setter, void* context, const Vector4& from, const Vector4& to, float duration, EaseType ease) {
+	assert(setter);
+	return Add(kVector4, ease, &from.x, &to.x, duration, {context, reinterpret_cast<void (*)()>(setter)});
+}
+
+void TweenSystem::Stop(TweenHandle handle) {
+	if (const Slot* slot = Find(handle)) {
+		Remove(slot->pool, slot->index);
+	}
+}
+
+void TweenSystem::Clear() {
+	for (uint32_t poolIndex = 0; poolIndex < pools_.size(); ++poolIndex) {
+		while (!pools_[poolIndex].slots.empty()) {
+			Remove(poolIndex, static_cast<uint32_t>(pools_[poolIndex].slots.size() - 1));
+		}
+	}
+}
+
+void TweenSystem::Update(float deltaTime) {
+	for (uint32_t poolIndex = 0; poolIndex < pools_.size(); ++poolIndex) {
+		Pool& pool = pools_[poolIndex];
+		const size_t count = pool.slots.size();
+		if (count == 0) {
+			continue;
+		}
+		const EaseType ease = static_cast<EaseType>(poolIndex / kValueTypeCount);
+		const ValueType valueType = static_cast<ValueType>(poolIndex % kValueTypeCount);
+
+		PoolArrays arrays{pool.elapsed.data(), pool.invDuration.data(), {}, {}, {}, kComponentCounts[valueType]};
+		for (size_t c = 0; c < arrays.componentCount; ++c) {
+			arrays.from[c] = pool.from[c].data();
+			arrays.to[c] = pool.to[c].data();
+			arrays.values[c] = pool.values[c].data();
+		}
+		Advance(ease, arrays, deltaTime, count);
+
+		switch (valueType) {
+		case kFloat:
+			WriteAll<float>(pool, count);
+			break;
+		case kVector3:
+			WriteAll<Vector3>(pool, count);
+			break;
+		default:
+			WriteAll<Vector4>(pool, count);
+			break;
+		}
+
+		// 終了したものを末尾と入れ替えて取り除く（後ろから見るので入れ替わるのは確認済みの要素）
+		for (size_t i = count; i-- > 0;) {
+			if (pool.elapsed[i] * pool.invDuration[i] >= 1.0f) {
+				Remove(poolIndex, static_cast<uint32_t>(i));
+			}
+		}
+	}
+}
+
+bool TweenSystem::IsActive(TweenHandle handle) const { return Find(handle) != nullptr; }
+
+float TweenSystem::GetFloat(TweenHandle handle) const {
+	const Slot* slot = Find(handle);
+	assert(slot && slot->pool % kValueTypeCount == kFloat);
+	return GetValue<float>(pools_[slot->pool], slot->index);
+}
+
+Vector3 TweenSystem::GetVector3(TweenHandle handle) const {
+	const Slot* slot = Find(handle);
+	assert(slot && slot->pool % kValueTypeCount == kVector3);
+	return GetValue<Vector3>(pools_[slot->pool], slot->index);
+}
+
+Vector4 TweenSystem::GetVector4(TweenHandle handle) const {
+	const Slot* slot = Find(handle);
+	assert(slot && slot->pool % kValueTypeCount == kVector4);
+	return GetValue<Vector4>(pools_[slot->pool], slot->index);
+}
+
+TweenHandle TweenSystem::Add(ValueType valueType, EaseType ease, const float* from, const float* to, float duration, const Target& target) {
+	assert(duration > 0.0f);
+	assert(ease < EaseType::kCount);
+	const uint32_t poolIndex = static_cast<uint32_t>(ease) * kValueTypeCount + valueType;
+	Pool& pool = pools_[poolIndex];
+	const uint32_t index = static_cast<uint32_t>(pool.slots.size());
+
+	uint32_t slotIndex;
+	if (freeSlots_.empty()) {
+		slotIndex = static_cast<uint32_t>(slots_.size());
+		slots_.push_back({poolIndex, index, 0});
+	} else {
+		slotIndex = freeSlots_.back();
+		freeSlots_.pop_back();
+		slots_[slotIndex].pool = poolIndex;
+		slots_[slotIndex].index = index;
+	}
+
+	pool.elapsed.push_back(0.0f);
+	pool.invDuration.push_back(1.0f / duration);
+	for (size_t c = 0; c < kComponentCounts[valueType]; ++c) {
+		pool.from[c].push_back(from[c]);
+		pool.to[c].push_back(to[c]);
+		pool.values[c].push_back(from[c]);
+	}
+	pool.targets.push_back(target);
+	pool.slots.push_back(slotIndex);
+	++activeCount_;
+
+	// 開始値を書き込んでおく
+	switch (valueType) {
+	case kFloat:
+		Write<float>(pool, index);
+		break;
+	case kVector3:
+		Write<Vector3>(pool, index);
+		break;
+	default:
+		Write<Vector4>(pool, index);
+		break;
+	}
+	return {slotIndex, slots_[slotIndex].generation};
+}
+
+void TweenSystem::Remove(uint32_t poolIndex, uint32_t index) {
+	Pool& pool = pools_[poolIndex];
+	const size_t componentCount = kComponentCounts[poolIndex % kValueTypeCount];
+	const uint32_t last = static_cast<uint32_t>(pool.slots.size() - 1);
+	const uint32_t removedSlot = pool.slots[index];
+	if (index != last) {
+		pool.elapsed[index] = pool.elapsed[last];
+		pool.invDuration[index] = pool.invDuration[last];
+		for (size_t c = 0; c < componentCount; ++c) {
+			pool.from[c][index] = pool.from[c][last];
+			pool.to[c][index] = pool.to[c][last];
+			pool.values[c][index] = pool.values[c][last];
+		}
+		pool.targets[index] = pool.targets[last];
+		pool.slots[index] = pool.slots[last];
+		slots_[pool.slots[index]].index = index;
+	}
+	pool.elapsed.pop_back();
+	pool.invDuration.pop_back();
+	for (size_t c = 0; c < componentCount; ++c) {
+		pool.from[c].pop_back();
+		pool.to[c].pop_back();
+		pool.values[c].pop_back();
+	}
+	pool.targets.pop_back();
+	pool.slots.pop_back();
+
+	// 世代を進めて古いハンドルを無効にする
+	++slots_[removedSlot].generation;
+	freeSlots_.push_back(removedSlot);
+	--activeCount_;
+}
+
+const TweenSystem::Slot* TweenSystem::Find(TweenHandle handle) const {
+	if (handle.index >= slots_.size()) {
+		return nullptr;
+	}
+	const Slot& slot = slots_[handle.index];
+	if (slot.generation != handle.generation) {
+		return nullptr;
+	}
+	return &slot;
+}
+
+template<typename T> T TweenSystem::GetValue(const Pool& pool, uint32_t index) {
+	if constexpr (std::is_same_v<T, float>) {
+		return pool.values[0][index];
+	} else if constexpr (std::is_same_v<T, Vector3>) {
+		return {pool.values[0][index], pool.values[1][index], pool.values[2][index]};
+	} else {
+		return {pool.values[0][index], pool.values[1][index], pool.values[2][index], pool.values[3][index]};
+	}
+}
+
+template<typename T> void TweenSystem::Write(const Pool& pool, uint32_t index) {
+	const Target& target = pool.targets[index];
+	if (target.setter) {
+		reinterpret_cast<TweenSetter<T>>(target.setter)(target.object, GetValue<T>(pool, index));
+	} else if (target.object) {
+		*static_cast<T*>(target.object) = GetValue<T>(pool, index);
+	}
+}
+
+template<typename T> void TweenSystem::WriteAll(const Pool& pool, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		Write<T>(pool, static_cast<uint32_t>(i));
+	}
+}
+
+} // namespace KamataEngine
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "math/Easing.h"
+#include "math/Vector3.h"
+#include "math/Vector4.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace KamataEngine {
+
+/// <summary>
+/// トゥイーンのハンドル（終了・停止したトゥイーンのハンドルは無効になり、番号が再利用されても区別できる）
+/// </summary>
+struct TweenHandle final {
+	uint32_t index = UINT32_MAX;
+	uint32_t generation = 0;
+};
+
+// 値をメンバ変数に直接書き込めない対象（Sprite::SetColor など）に値を渡す関数
+template<typename T> using TweenSetter = void (*)(void* context, const T& value);
+
+/// <summary>
+/// トゥイーンの一括更新
+/// 実行中のトゥイーンをイージングの種類と値の型ごとに SoA で保持し、Update で SIMD でまとめて計算してから書き込み先へ書き戻す。
+/// 一度確保した領域は解放しないので、同時実行数が最大に達した後は Play / Update でメモリを確保しない。
+/// </summary>
+class TweenSystem final {
+public:
+	/// <summary>
+	/// ハンドル管理用の領域をあらかじめ確保
+	/// </summary>
+	/// <param name="capacity">同時に実行するトゥイーン数の見込み</param>
+	void Reserve(size_t capacity);
+
+	/// <summary>
+	/// トゥイーンを開始（target には毎フレーム値が書き込まれる。終了まで有効であること）
+	/// </summary>
+	/// <param name="target">書き込み先（nullptr なら書き込まず、GetFloat などで値を取得する）</param>
+	/// <param name="from">開始値</param>
+	/// <param name="to">終了値</param>
+	/// <param name="duration">時間（秒。0 より大きいこと）</param>
+	/// <param name="ease">イージングの種類</param>
+	/// <returns>ハンドル</returns>
+	TweenHandle Play(float* target, float from, float to, float duration, EaseType ease = EaseType::kLinear);
+	TweenHandle Play(Vector3* target, const Vector3& from, const Vector3& to, float duration, EaseType ease = EaseType::kLinear);
+	TweenHandle Play(Vector4* target, const Vector4& from, const Vector4& to, float duration, EaseType ease = EaseType::kLinear);
+
+	/// <summary>
+	/// トゥイーンを開始（毎フレーム setter(context, 値) が呼ばれる。setter の中でこの TweenSystem を操作しないこと）
+	/// </summary>
+	TweenHandle Play(TweenSetter<float> setter, void* context, float from, float to, float duration, EaseType ease = EaseType::kLinear);
+	TweenHandle Play(TweenSetter<Vector3> setter, void* context, const Vector3& from, const Vector3& to, float duration, EaseType ease = EaseType::kLinear);
+	TweenHandle Play(TweenSetter<Vector4> setter, void* context, const Vector4& from, const Vector4& to, float duration, EaseType ease = EaseType::kLinear);
+
+	/// <summary>
+	/// トゥイーンを停止（書き込み先は現在の値のまま）
+	/// </summary>
+	/// <param name="handle">ハンドル（無効なハンドルなら何もしない）</param>
+	void Stop(TweenHandle handle);
+
+	/// <summary>
+	/// すべてのトゥイーンを停止
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// すべてのトゥイーンを進めて書き込み先を更新し、終了したものを取り除く
+	/// </summary>
+	/// <param name="deltaTime">経過時間（秒）</param>
+	void Update(float deltaTime);
+
+	/// <summary>
+	/// トゥイーンが実行中か
+	/// </summary>
+	bool IsActive(TweenHandle handle) const;
+
+	/// <summary>
+	/// 実行中のトゥイーンの現在の値を取得（Play で指定した型と一致すること）
+	/// </summary>
+	float GetFloat(TweenHandle handle) const;
+	Vector3 GetVector3(TweenHandle handle) const;
+	Vector4 GetVector4(TweenHandle handle) const;
+
+	/// <summary>
+	/// 実行中のトゥイーン数を取得
+	/// </summary>
+	size_t GetActiveCount() const { return activeCount_; }
+
+private:
+	// 値の型（成分数）ごとのプール番号
+	enum ValueType {
+		kFloat,
+		kVector3,
+		kVector4,
+		kValueTypeCount,
+	};
+
+	// 書き込み先
+	struct Target {
+		void* object;     // 書き込み先の値、または setter に渡す context
+		void (*setter)(); // 値を渡す関数（nullptr なら object に直接書き込む）
+	};
+
+	/// <summary>
+	/// イージングの種類と値の型が同じトゥイーンの SoA
+	/// </summary>
+	struct Pool {
+		std::vector<float> elapsed;
+		std::vector<float> invDuration;
+		std::array<std::vector<float>, 4> from;
+		std::array<std::vector<float>, 4> to;
+		std::array<std::vector<float>, 4> values;
+		std::vector<Target> targets;
+		std::vector<uint32_t> slots; // 要素ごとのハンドル番号
+	};
+
+	// ハンドル番号ごとの所在
+	struct Slot {
+		uint32_t pool;
+		uint32_t index;
+		uint32_t generation;
+	};
+
+	TweenHandle Add(ValueType valueType, EaseType ease, const float* from, const float* to, float duration, const Target& target);
+	void Remove(uint32_t poolIndex, uint32_t index);
+	const Slot* Find(TweenHandle handle) const;
+
+	template<typename T> static T GetValue(const Pool& pool, uint32_t index);
+	template<typename T> static void Write(const Pool& pool, uint32_t index);
+	template<typename T> static void WriteAll(const Pool& pool, size_t count);
+
+	// pools_[イージングの種類 * kValueTypeCount + 値の型]
+	std::array<Pool, static_cast<size_t>(EaseType::kCount) * kValueTypeCount> pools_;
+	std::vector<Slot> slots_;
+	std::vector<uint32_t> freeSlots_;
+	size_t activeCount_ = 0;
+};
+
+} // namespace KamataEngine